@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/benchmark/multithread.cpp" "benchmark/CMakeFiles/umf-bench-multithreaded.dir/multithread.cpp.o" "gcc" "benchmark/CMakeFiles/umf-bench-multithreaded.dir/multithread.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/src/pool/CMakeFiles/disjoint_pool.dir/DependInfo.cmake"
+  "/root/repo/_bench_build/src/CMakeFiles/umf.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
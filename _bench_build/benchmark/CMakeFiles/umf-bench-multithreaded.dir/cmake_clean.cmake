@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf-bench-multithreaded.dir/multithread.cpp.o"
+  "CMakeFiles/umf-bench-multithreaded.dir/multithread.cpp.o.d"
+  "umf-bench-multithreaded"
+  "umf-bench-multithreaded.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf-bench-multithreaded.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf-bench-ubench.dir/ubench.c.o"
+  "CMakeFiles/umf-bench-ubench.dir/ubench.c.o.d"
+  "umf-bench-ubench"
+  "umf-bench-ubench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/umf-bench-ubench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/benchmark
+# Build directory: /root/repo/_bench_build/benchmark
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(umf-bench-ubench "/root/repo/_bench_build/benchmark/umf-bench-ubench")
+set_tests_properties(umf-bench-ubench PROPERTIES  LABELS "benchmark" PASS_REGULAR_EXPRESSION "PASSED" WORKING_DIRECTORY "/root/repo/_bench_build/benchmark" _BACKTRACE_TRIPLES "/root/repo/benchmark/CMakeLists.txt;54;add_test;/root/repo/benchmark/CMakeLists.txt;125;add_umf_benchmark;/root/repo/benchmark/CMakeLists.txt;0;")
+add_test(umf-bench-multithreaded "/root/repo/_bench_build/benchmark/umf-bench-multithreaded")
+set_tests_properties(umf-bench-multithreaded PROPERTIES  LABELS "benchmark" PASS_REGULAR_EXPRESSION "PASSED" WORKING_DIRECTORY "/root/repo/_bench_build/benchmark" _BACKTRACE_TRIPLES "/root/repo/benchmark/CMakeLists.txt;54;add_test;/root/repo/benchmark/CMakeLists.txt;132;add_umf_benchmark;/root/repo/benchmark/CMakeLists.txt;0;")
@@ -0,0 +1,16 @@
+# From: https://cmake.org/Wiki/CMake_FAQ
+
+if(NOT EXISTS "/root/repo/_bench_build/install_manifest.txt")
+	message(FATAL_ERROR "Cannot find install manifest: /root/repo/_bench_build/install_manifest.txt")
+endif(NOT EXISTS "/root/repo/_bench_build/install_manifest.txt")
+
+file(READ "/root/repo/_bench_build/install_manifest.txt" files)
+string(REGEX REPLACE "\n" ";" files "${files}")
+foreach(file ${files})
+	message(STATUS "Uninstalling $ENV{DESTDIR}${file}")
+	if(IS_SYMLINK "$ENV{DESTDIR}${file}" OR EXISTS "$ENV{DESTDIR}${file}")
+		FILE(REMOVE $ENV{DESTDIR}${file})
+	else(IS_SYMLINK "$ENV{DESTDIR}${file}" OR EXISTS "$ENV{DESTDIR}${file}")
+		message(STATUS "File $ENV{DESTDIR}${file} does not exist.")
+	endif(IS_SYMLINK "$ENV{DESTDIR}${file}" OR EXISTS "$ENV{DESTDIR}${file}")
+endforeach(file)
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libdisjoint_pool.a"
+  "../../lib/libdisjoint_pool.pdb"
+  "CMakeFiles/disjoint_pool.dir/pool_disjoint.cpp.o"
+  "CMakeFiles/disjoint_pool.dir/pool_disjoint.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/disjoint_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,172 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/cmake_uninstall.cmake.in"
+  "/root/repo/cmake/helpers.cmake"
+  "/root/repo/cmake/umf-config.cmake.in"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/src/pool/CMakeLists.txt"
+  "/root/repo/src/utils/CMakeLists.txt"
+  "/root/repo/test/CMakeLists.txt"
+  "/root/repo/test/common/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/BasicConfigVersion-SameMajorVersion.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePackageConfigHelpers.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CTest.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestTargets.cmake"
+  "/usr/share/cmake-3.25/Modules/CTestUseLaunchers.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/DartConfiguration.tcl.in"
+  "/usr/share/cmake-3.25/Modules/FetchContent.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPython/Support.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/WriteBasicConfigVersionFile.cmake"
+  "/usr/src/googletest/CMakeLists.txt"
+  "/usr/src/googletest/googlemock/CMakeLists.txt"
+  "/usr/src/googletest/googletest/CMakeLists.txt"
+  "/usr/src/googletest/googletest/cmake/internal_utils.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "DartConfiguration.tcl"
+  "cmake/umf-config-version.cmake"
+  "cmake/umf-config.cmake"
+  "cmake_uninstall.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/utils/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/pool/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "_deps/googletest-build/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "_deps/googletest-build/googlemock/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "_deps/googletest-build/googletest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "test/common/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/Experimental.dir/DependInfo.cmake"
+  "CMakeFiles/Nightly.dir/DependInfo.cmake"
+  "CMakeFiles/Continuous.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyMemoryCheck.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyStart.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyBuild.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyTest.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/NightlyMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/NightlySubmit.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalStart.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalBuild.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalTest.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/ExperimentalSubmit.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousStart.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousUpdate.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousConfigure.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousBuild.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousTest.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousCoverage.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousMemCheck.dir/DependInfo.cmake"
+  "CMakeFiles/ContinuousSubmit.dir/DependInfo.cmake"
+  "CMakeFiles/uninstall.dir/DependInfo.cmake"
+  "src/CMakeFiles/umf.dir/DependInfo.cmake"
+  "src/pool/CMakeFiles/disjoint_pool.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-base.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memoryPool.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memoryProvider.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-logger.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-utils_common.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-utils_linux_common.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-provider_coarse.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-disjointPool.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-c_api_disjoint_pool.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-disjointCoarseMallocPool.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-scalable_pool.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-provider_os_memory.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-provider_os_memory_multiple_numa_nodes.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memspace_numa.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-provider_os_memory_config.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memspace_host_all.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memspace_highest_capacity.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memspace_highest_bandwidth.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memspace_lowest_latency.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-mempolicy.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memspace.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-memtarget.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-provider_devdax_memory.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-provider_devdax_memory_ipc.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-provider_file_memory.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-provider_file_memory_ipc.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-scalable_coarse_file.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-scalable_coarse_devdax.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-base_alloc.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-base_alloc_linear.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-base_alloc_global.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-critnib.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-ipc.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-ipc_negative.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-ipc_os_prov_consumer.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-ipc_os_prov_producer.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-ipc_devdax_prov_producer.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-ipc_file_prov_consumer.dir/DependInfo.cmake"
+  "test/CMakeFiles/umf_test-ipc_file_prov_producer.dir/DependInfo.cmake"
+  "_deps/googletest-build/googlemock/CMakeFiles/gmock.dir/DependInfo.cmake"
+  "_deps/googletest-build/googlemock/CMakeFiles/gmock_main.dir/DependInfo.cmake"
+  "_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "test/common/CMakeFiles/umf_test_common.dir/DependInfo.cmake"
+  )
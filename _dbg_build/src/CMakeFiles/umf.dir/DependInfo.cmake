@@ -0,0 +1,57 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/base_alloc/base_alloc.c" "src/CMakeFiles/umf.dir/base_alloc/base_alloc.c.o" "gcc" "src/CMakeFiles/umf.dir/base_alloc/base_alloc.c.o.d"
+  "/root/repo/src/base_alloc/base_alloc_global.c" "src/CMakeFiles/umf.dir/base_alloc/base_alloc_global.c.o" "gcc" "src/CMakeFiles/umf.dir/base_alloc/base_alloc_global.c.o.d"
+  "/root/repo/src/base_alloc/base_alloc_linear.c" "src/CMakeFiles/umf.dir/base_alloc/base_alloc_linear.c.o" "gcc" "src/CMakeFiles/umf.dir/base_alloc/base_alloc_linear.c.o.d"
+  "/root/repo/src/base_alloc/base_alloc_linux.c" "src/CMakeFiles/umf.dir/base_alloc/base_alloc_linux.c.o" "gcc" "src/CMakeFiles/umf.dir/base_alloc/base_alloc_linux.c.o.d"
+  "/root/repo/src/critnib/critnib.c" "src/CMakeFiles/umf.dir/critnib/critnib.c.o" "gcc" "src/CMakeFiles/umf.dir/critnib/critnib.c.o.d"
+  "/root/repo/src/decay_clock.c" "src/CMakeFiles/umf.dir/decay_clock.c.o" "gcc" "src/CMakeFiles/umf.dir/decay_clock.c.o.d"
+  "/root/repo/src/ipc.c" "src/CMakeFiles/umf.dir/ipc.c.o" "gcc" "src/CMakeFiles/umf.dir/ipc.c.o.d"
+  "/root/repo/src/libumf.c" "src/CMakeFiles/umf.dir/libumf.c.o" "gcc" "src/CMakeFiles/umf.dir/libumf.c.o.d"
+  "/root/repo/src/libumf_linux.c" "src/CMakeFiles/umf.dir/libumf_linux.c.o" "gcc" "src/CMakeFiles/umf.dir/libumf_linux.c.o.d"
+  "/root/repo/src/memory_pool.c" "src/CMakeFiles/umf.dir/memory_pool.c.o" "gcc" "src/CMakeFiles/umf.dir/memory_pool.c.o.d"
+  "/root/repo/src/memory_provider.c" "src/CMakeFiles/umf.dir/memory_provider.c.o" "gcc" "src/CMakeFiles/umf.dir/memory_provider.c.o.d"
+  "/root/repo/src/memory_provider_get_last_failed.c" "src/CMakeFiles/umf.dir/memory_provider_get_last_failed.c.o" "gcc" "src/CMakeFiles/umf.dir/memory_provider_get_last_failed.c.o.d"
+  "/root/repo/src/mempolicy.c" "src/CMakeFiles/umf.dir/mempolicy.c.o" "gcc" "src/CMakeFiles/umf.dir/mempolicy.c.o.d"
+  "/root/repo/src/memspace.c" "src/CMakeFiles/umf.dir/memspace.c.o" "gcc" "src/CMakeFiles/umf.dir/memspace.c.o.d"
+  "/root/repo/src/memspaces/memspace_highest_bandwidth.c" "src/CMakeFiles/umf.dir/memspaces/memspace_highest_bandwidth.c.o" "gcc" "src/CMakeFiles/umf.dir/memspaces/memspace_highest_bandwidth.c.o.d"
+  "/root/repo/src/memspaces/memspace_highest_capacity.c" "src/CMakeFiles/umf.dir/memspaces/memspace_highest_capacity.c.o" "gcc" "src/CMakeFiles/umf.dir/memspaces/memspace_highest_capacity.c.o.d"
+  "/root/repo/src/memspaces/memspace_host_all.c" "src/CMakeFiles/umf.dir/memspaces/memspace_host_all.c.o" "gcc" "src/CMakeFiles/umf.dir/memspaces/memspace_host_all.c.o.d"
+  "/root/repo/src/memspaces/memspace_lowest_latency.c" "src/CMakeFiles/umf.dir/memspaces/memspace_lowest_latency.c.o" "gcc" "src/CMakeFiles/umf.dir/memspaces/memspace_lowest_latency.c.o.d"
+  "/root/repo/src/memspaces/memspace_numa.c" "src/CMakeFiles/umf.dir/memspaces/memspace_numa.c.o" "gcc" "src/CMakeFiles/umf.dir/memspaces/memspace_numa.c.o.d"
+  "/root/repo/src/memtarget.c" "src/CMakeFiles/umf.dir/memtarget.c.o" "gcc" "src/CMakeFiles/umf.dir/memtarget.c.o.d"
+  "/root/repo/src/memtargets/memtarget_numa.c" "src/CMakeFiles/umf.dir/memtargets/memtarget_numa.c.o" "gcc" "src/CMakeFiles/umf.dir/memtargets/memtarget_numa.c.o.d"
+  "/root/repo/src/pool/pool_proxy.c" "src/CMakeFiles/umf.dir/pool/pool_proxy.c.o" "gcc" "src/CMakeFiles/umf.dir/pool/pool_proxy.c.o.d"
+  "/root/repo/src/pool/pool_scalable.c" "src/CMakeFiles/umf.dir/pool/pool_scalable.c.o" "gcc" "src/CMakeFiles/umf.dir/pool/pool_scalable.c.o.d"
+  "/root/repo/src/provider/provider_coarse.c" "src/CMakeFiles/umf.dir/provider/provider_coarse.c.o" "gcc" "src/CMakeFiles/umf.dir/provider/provider_coarse.c.o.d"
+  "/root/repo/src/provider/provider_cuda.c" "src/CMakeFiles/umf.dir/provider/provider_cuda.c.o" "gcc" "src/CMakeFiles/umf.dir/provider/provider_cuda.c.o.d"
+  "/root/repo/src/provider/provider_devdax_memory.c" "src/CMakeFiles/umf.dir/provider/provider_devdax_memory.c.o" "gcc" "src/CMakeFiles/umf.dir/provider/provider_devdax_memory.c.o.d"
+  "/root/repo/src/provider/provider_file_memory.c" "src/CMakeFiles/umf.dir/provider/provider_file_memory.c.o" "gcc" "src/CMakeFiles/umf.dir/provider/provider_file_memory.c.o.d"
+  "/root/repo/src/provider/provider_level_zero.c" "src/CMakeFiles/umf.dir/provider/provider_level_zero.c.o" "gcc" "src/CMakeFiles/umf.dir/provider/provider_level_zero.c.o.d"
+  "/root/repo/src/provider/provider_os_memory.c" "src/CMakeFiles/umf.dir/provider/provider_os_memory.c.o" "gcc" "src/CMakeFiles/umf.dir/provider/provider_os_memory.c.o.d"
+  "/root/repo/src/provider/provider_tracking.c" "src/CMakeFiles/umf.dir/provider/provider_tracking.c.o" "gcc" "src/CMakeFiles/umf.dir/provider/provider_tracking.c.o.d"
+  "/root/repo/src/ravl/ravl.c" "src/CMakeFiles/umf.dir/ravl/ravl.c.o" "gcc" "src/CMakeFiles/umf.dir/ravl/ravl.c.o.d"
+  "/root/repo/src/topology.c" "src/CMakeFiles/umf.dir/topology.c.o" "gcc" "src/CMakeFiles/umf.dir/topology.c.o.d"
+  "/root/repo/src/utils/utils_common.c" "src/CMakeFiles/umf.dir/utils/utils_common.c.o" "gcc" "src/CMakeFiles/umf.dir/utils/utils_common.c.o.d"
+  "/root/repo/src/utils/utils_linux_common.c" "src/CMakeFiles/umf.dir/utils/utils_linux_common.c.o" "gcc" "src/CMakeFiles/umf.dir/utils/utils_linux_common.c.o.d"
+  "/root/repo/src/utils/utils_load_library.c" "src/CMakeFiles/umf.dir/utils/utils_load_library.c.o" "gcc" "src/CMakeFiles/umf.dir/utils/utils_load_library.c.o.d"
+  "/root/repo/src/utils/utils_log.c" "src/CMakeFiles/umf.dir/utils/utils_log.c.o" "gcc" "src/CMakeFiles/umf.dir/utils/utils_log.c.o.d"
+  "/root/repo/src/utils/utils_posix_common.c" "src/CMakeFiles/umf.dir/utils/utils_posix_common.c.o" "gcc" "src/CMakeFiles/umf.dir/utils/utils_posix_common.c.o.d"
+  "/root/repo/src/utils/utils_posix_concurrency.c" "src/CMakeFiles/umf.dir/utils/utils_posix_concurrency.c.o" "gcc" "src/CMakeFiles/umf.dir/utils/utils_posix_concurrency.c.o.d"
+  "/root/repo/src/utils/utils_posix_math.c" "src/CMakeFiles/umf.dir/utils/utils_posix_math.c.o" "gcc" "src/CMakeFiles/umf.dir/utils/utils_posix_math.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
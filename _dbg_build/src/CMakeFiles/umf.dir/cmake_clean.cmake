@@ -0,0 +1,87 @@
+file(REMOVE_RECURSE
+  "../lib/libumf.a"
+  "../lib/libumf.pdb"
+  "CMakeFiles/umf.dir/base_alloc/base_alloc.c.o"
+  "CMakeFiles/umf.dir/base_alloc/base_alloc.c.o.d"
+  "CMakeFiles/umf.dir/base_alloc/base_alloc_global.c.o"
+  "CMakeFiles/umf.dir/base_alloc/base_alloc_global.c.o.d"
+  "CMakeFiles/umf.dir/base_alloc/base_alloc_linear.c.o"
+  "CMakeFiles/umf.dir/base_alloc/base_alloc_linear.c.o.d"
+  "CMakeFiles/umf.dir/base_alloc/base_alloc_linux.c.o"
+  "CMakeFiles/umf.dir/base_alloc/base_alloc_linux.c.o.d"
+  "CMakeFiles/umf.dir/critnib/critnib.c.o"
+  "CMakeFiles/umf.dir/critnib/critnib.c.o.d"
+  "CMakeFiles/umf.dir/decay_clock.c.o"
+  "CMakeFiles/umf.dir/decay_clock.c.o.d"
+  "CMakeFiles/umf.dir/ipc.c.o"
+  "CMakeFiles/umf.dir/ipc.c.o.d"
+  "CMakeFiles/umf.dir/libumf.c.o"
+  "CMakeFiles/umf.dir/libumf.c.o.d"
+  "CMakeFiles/umf.dir/libumf_linux.c.o"
+  "CMakeFiles/umf.dir/libumf_linux.c.o.d"
+  "CMakeFiles/umf.dir/memory_pool.c.o"
+  "CMakeFiles/umf.dir/memory_pool.c.o.d"
+  "CMakeFiles/umf.dir/memory_provider.c.o"
+  "CMakeFiles/umf.dir/memory_provider.c.o.d"
+  "CMakeFiles/umf.dir/memory_provider_get_last_failed.c.o"
+  "CMakeFiles/umf.dir/memory_provider_get_last_failed.c.o.d"
+  "CMakeFiles/umf.dir/mempolicy.c.o"
+  "CMakeFiles/umf.dir/mempolicy.c.o.d"
+  "CMakeFiles/umf.dir/memspace.c.o"
+  "CMakeFiles/umf.dir/memspace.c.o.d"
+  "CMakeFiles/umf.dir/memspaces/memspace_highest_bandwidth.c.o"
+  "CMakeFiles/umf.dir/memspaces/memspace_highest_bandwidth.c.o.d"
+  "CMakeFiles/umf.dir/memspaces/memspace_highest_capacity.c.o"
+  "CMakeFiles/umf.dir/memspaces/memspace_highest_capacity.c.o.d"
+  "CMakeFiles/umf.dir/memspaces/memspace_host_all.c.o"
+  "CMakeFiles/umf.dir/memspaces/memspace_host_all.c.o.d"
+  "CMakeFiles/umf.dir/memspaces/memspace_lowest_latency.c.o"
+  "CMakeFiles/umf.dir/memspaces/memspace_lowest_latency.c.o.d"
+  "CMakeFiles/umf.dir/memspaces/memspace_numa.c.o"
+  "CMakeFiles/umf.dir/memspaces/memspace_numa.c.o.d"
+  "CMakeFiles/umf.dir/memtarget.c.o"
+  "CMakeFiles/umf.dir/memtarget.c.o.d"
+  "CMakeFiles/umf.dir/memtargets/memtarget_numa.c.o"
+  "CMakeFiles/umf.dir/memtargets/memtarget_numa.c.o.d"
+  "CMakeFiles/umf.dir/pool/pool_proxy.c.o"
+  "CMakeFiles/umf.dir/pool/pool_proxy.c.o.d"
+  "CMakeFiles/umf.dir/pool/pool_scalable.c.o"
+  "CMakeFiles/umf.dir/pool/pool_scalable.c.o.d"
+  "CMakeFiles/umf.dir/provider/provider_coarse.c.o"
+  "CMakeFiles/umf.dir/provider/provider_coarse.c.o.d"
+  "CMakeFiles/umf.dir/provider/provider_cuda.c.o"
+  "CMakeFiles/umf.dir/provider/provider_cuda.c.o.d"
+  "CMakeFiles/umf.dir/provider/provider_devdax_memory.c.o"
+  "CMakeFiles/umf.dir/provider/provider_devdax_memory.c.o.d"
+  "CMakeFiles/umf.dir/provider/provider_file_memory.c.o"
+  "CMakeFiles/umf.dir/provider/provider_file_memory.c.o.d"
+  "CMakeFiles/umf.dir/provider/provider_level_zero.c.o"
+  "CMakeFiles/umf.dir/provider/provider_level_zero.c.o.d"
+  "CMakeFiles/umf.dir/provider/provider_os_memory.c.o"
+  "CMakeFiles/umf.dir/provider/provider_os_memory.c.o.d"
+  "CMakeFiles/umf.dir/provider/provider_tracking.c.o"
+  "CMakeFiles/umf.dir/provider/provider_tracking.c.o.d"
+  "CMakeFiles/umf.dir/ravl/ravl.c.o"
+  "CMakeFiles/umf.dir/ravl/ravl.c.o.d"
+  "CMakeFiles/umf.dir/topology.c.o"
+  "CMakeFiles/umf.dir/topology.c.o.d"
+  "CMakeFiles/umf.dir/utils/utils_common.c.o"
+  "CMakeFiles/umf.dir/utils/utils_common.c.o.d"
+  "CMakeFiles/umf.dir/utils/utils_linux_common.c.o"
+  "CMakeFiles/umf.dir/utils/utils_linux_common.c.o.d"
+  "CMakeFiles/umf.dir/utils/utils_load_library.c.o"
+  "CMakeFiles/umf.dir/utils/utils_load_library.c.o.d"
+  "CMakeFiles/umf.dir/utils/utils_log.c.o"
+  "CMakeFiles/umf.dir/utils/utils_log.c.o.d"
+  "CMakeFiles/umf.dir/utils/utils_posix_common.c.o"
+  "CMakeFiles/umf.dir/utils/utils_posix_common.c.o.d"
+  "CMakeFiles/umf.dir/utils/utils_posix_concurrency.c.o"
+  "CMakeFiles/umf.dir/utils/utils_posix_concurrency.c.o.d"
+  "CMakeFiles/umf.dir/utils/utils_posix_math.c.o"
+  "CMakeFiles/umf.dir/utils/utils_posix_math.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/umf.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
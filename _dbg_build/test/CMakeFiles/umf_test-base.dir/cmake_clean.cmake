@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-base.dir/base.cpp.o"
+  "CMakeFiles/umf_test-base.dir/base.cpp.o.d"
+  "umf_test-base"
+  "umf_test-base.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-base.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/test_base_alloc.cpp" "test/CMakeFiles/umf_test-base_alloc.dir/test_base_alloc.cpp.o" "gcc" "test/CMakeFiles/umf_test-base_alloc.dir/test_base_alloc.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_dbg_build/test/common/CMakeFiles/umf_test_common.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/src/CMakeFiles/umf.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-base_alloc.dir/test_base_alloc.cpp.o"
+  "CMakeFiles/umf_test-base_alloc.dir/test_base_alloc.cpp.o.d"
+  "umf_test-base_alloc"
+  "umf_test-base_alloc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-base_alloc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
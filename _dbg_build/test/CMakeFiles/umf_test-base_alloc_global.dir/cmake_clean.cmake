@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-base_alloc_global.dir/malloc_compliance_tests.cpp.o"
+  "CMakeFiles/umf_test-base_alloc_global.dir/malloc_compliance_tests.cpp.o.d"
+  "CMakeFiles/umf_test-base_alloc_global.dir/pools/pool_base_alloc.cpp.o"
+  "CMakeFiles/umf_test-base_alloc_global.dir/pools/pool_base_alloc.cpp.o.d"
+  "umf_test-base_alloc_global"
+  "umf_test-base_alloc_global.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-base_alloc_global.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
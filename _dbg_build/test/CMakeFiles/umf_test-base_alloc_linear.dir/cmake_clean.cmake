@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-base_alloc_linear.dir/test_base_alloc_linear.cpp.o"
+  "CMakeFiles/umf_test-base_alloc_linear.dir/test_base_alloc_linear.cpp.o.d"
+  "umf_test-base_alloc_linear"
+  "umf_test-base_alloc_linear.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-base_alloc_linear.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
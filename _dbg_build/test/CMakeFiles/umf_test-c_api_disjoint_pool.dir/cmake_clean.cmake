@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-c_api_disjoint_pool.dir/c_api/disjoint_pool.c.o"
+  "CMakeFiles/umf_test-c_api_disjoint_pool.dir/c_api/disjoint_pool.c.o.d"
+  "umf_test-c_api_disjoint_pool"
+  "umf_test-c_api_disjoint_pool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/umf_test-c_api_disjoint_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-critnib.dir/test_critnib.cpp.o"
+  "CMakeFiles/umf_test-critnib.dir/test_critnib.cpp.o.d"
+  "umf_test-critnib"
+  "umf_test-critnib.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-critnib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
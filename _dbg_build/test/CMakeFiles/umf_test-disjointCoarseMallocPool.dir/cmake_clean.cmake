@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-disjointCoarseMallocPool.dir/disjointCoarseMallocPool.cpp.o"
+  "CMakeFiles/umf_test-disjointCoarseMallocPool.dir/disjointCoarseMallocPool.cpp.o.d"
+  "umf_test-disjointCoarseMallocPool"
+  "umf_test-disjointCoarseMallocPool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-disjointCoarseMallocPool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/malloc_compliance_tests.cpp" "test/CMakeFiles/umf_test-disjointPool.dir/malloc_compliance_tests.cpp.o" "gcc" "test/CMakeFiles/umf_test-disjointPool.dir/malloc_compliance_tests.cpp.o.d"
+  "/root/repo/test/pools/disjoint_pool.cpp" "test/CMakeFiles/umf_test-disjointPool.dir/pools/disjoint_pool.cpp.o" "gcc" "test/CMakeFiles/umf_test-disjointPool.dir/pools/disjoint_pool.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_dbg_build/test/common/CMakeFiles/umf_test_common.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/src/pool/CMakeFiles/disjoint_pool.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/src/CMakeFiles/umf.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
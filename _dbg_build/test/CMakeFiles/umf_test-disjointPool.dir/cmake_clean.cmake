@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-disjointPool.dir/malloc_compliance_tests.cpp.o"
+  "CMakeFiles/umf_test-disjointPool.dir/malloc_compliance_tests.cpp.o.d"
+  "CMakeFiles/umf_test-disjointPool.dir/pools/disjoint_pool.cpp.o"
+  "CMakeFiles/umf_test-disjointPool.dir/pools/disjoint_pool.cpp.o.d"
+  "umf_test-disjointPool"
+  "umf_test-disjointPool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-disjointPool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-ipc.dir/ipcAPI.cpp.o"
+  "CMakeFiles/umf_test-ipc.dir/ipcAPI.cpp.o.d"
+  "umf_test-ipc"
+  "umf_test-ipc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-ipc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
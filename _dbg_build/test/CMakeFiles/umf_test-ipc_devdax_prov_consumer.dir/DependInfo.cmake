@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/common/ipc_common.c" "test/CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/common/ipc_common.c.o" "gcc" "test/CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/common/ipc_common.c.o.d"
+  "/root/repo/test/common/ipc_os_prov_common.c" "test/CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/common/ipc_os_prov_common.c.o" "gcc" "test/CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/common/ipc_os_prov_common.c.o.d"
+  "/root/repo/test/ipc_devdax_prov_consumer.c" "test/CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/ipc_devdax_prov_consumer.c.o" "gcc" "test/CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/ipc_devdax_prov_consumer.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_dbg_build/test/common/CMakeFiles/umf_test_common.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/_deps/googletest-build/googletest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/src/CMakeFiles/umf.dir/DependInfo.cmake"
+  "/root/repo/_dbg_build/_deps/googletest-build/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
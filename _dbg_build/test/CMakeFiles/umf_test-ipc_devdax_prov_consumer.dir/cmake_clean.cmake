@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/common/ipc_common.c.o"
+  "CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/common/ipc_common.c.o.d"
+  "CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/common/ipc_os_prov_common.c.o"
+  "CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/common/ipc_os_prov_common.c.o.d"
+  "CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/ipc_devdax_prov_consumer.c.o"
+  "CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/ipc_devdax_prov_consumer.c.o.d"
+  "umf_test-ipc_devdax_prov_consumer"
+  "umf_test-ipc_devdax_prov_consumer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/umf_test-ipc_devdax_prov_consumer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
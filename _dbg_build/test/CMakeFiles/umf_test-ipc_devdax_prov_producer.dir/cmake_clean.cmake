@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-ipc_devdax_prov_producer.dir/common/ipc_common.c.o"
+  "CMakeFiles/umf_test-ipc_devdax_prov_producer.dir/common/ipc_common.c.o.d"
+  "CMakeFiles/umf_test-ipc_devdax_prov_producer.dir/common/ipc_os_prov_common.c.o"
+  "CMakeFiles/umf_test-ipc_devdax_prov_producer.dir/common/ipc_os_prov_common.c.o.d"
+  "CMakeFiles/umf_test-ipc_devdax_prov_producer.dir/ipc_devdax_prov_producer.c.o"
+  "CMakeFiles/umf_test-ipc_devdax_prov_producer.dir/ipc_devdax_prov_producer.c.o.d"
+  "umf_test-ipc_devdax_prov_producer"
+  "umf_test-ipc_devdax_prov_producer.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/umf_test-ipc_devdax_prov_producer.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
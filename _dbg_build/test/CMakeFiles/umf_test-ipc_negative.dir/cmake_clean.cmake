@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-ipc_negative.dir/ipc_negative.cpp.o"
+  "CMakeFiles/umf_test-ipc_negative.dir/ipc_negative.cpp.o.d"
+  "umf_test-ipc_negative"
+  "umf_test-ipc_negative.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-ipc_negative.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
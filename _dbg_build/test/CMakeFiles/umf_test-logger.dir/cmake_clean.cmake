@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-logger.dir/utils/utils_log.cpp.o"
+  "CMakeFiles/umf_test-logger.dir/utils/utils_log.cpp.o.d"
+  "umf_test-logger"
+  "umf_test-logger.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-logger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
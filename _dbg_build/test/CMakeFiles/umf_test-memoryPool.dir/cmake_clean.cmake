@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memoryPool.dir/malloc_compliance_tests.cpp.o"
+  "CMakeFiles/umf_test-memoryPool.dir/malloc_compliance_tests.cpp.o.d"
+  "CMakeFiles/umf_test-memoryPool.dir/memoryPoolAPI.cpp.o"
+  "CMakeFiles/umf_test-memoryPool.dir/memoryPoolAPI.cpp.o.d"
+  "umf_test-memoryPool"
+  "umf_test-memoryPool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memoryPool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
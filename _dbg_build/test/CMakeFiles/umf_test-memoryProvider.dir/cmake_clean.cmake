@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memoryProvider.dir/memoryProviderAPI.cpp.o"
+  "CMakeFiles/umf_test-memoryProvider.dir/memoryProviderAPI.cpp.o.d"
+  "umf_test-memoryProvider"
+  "umf_test-memoryProvider.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memoryProvider.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
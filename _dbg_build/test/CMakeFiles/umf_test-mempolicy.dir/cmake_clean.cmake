@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-mempolicy.dir/memspaces/mempolicy.cpp.o"
+  "CMakeFiles/umf_test-mempolicy.dir/memspaces/mempolicy.cpp.o.d"
+  "umf_test-mempolicy"
+  "umf_test-mempolicy.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-mempolicy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memspace.dir/memspaces/memspace.cpp.o"
+  "CMakeFiles/umf_test-memspace.dir/memspaces/memspace.cpp.o.d"
+  "umf_test-memspace"
+  "umf_test-memspace.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memspace.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
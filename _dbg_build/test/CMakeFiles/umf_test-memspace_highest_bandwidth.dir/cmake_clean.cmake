@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memspace_highest_bandwidth.dir/memspaces/memspace_highest_bandwidth.cpp.o"
+  "CMakeFiles/umf_test-memspace_highest_bandwidth.dir/memspaces/memspace_highest_bandwidth.cpp.o.d"
+  "umf_test-memspace_highest_bandwidth"
+  "umf_test-memspace_highest_bandwidth.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memspace_highest_bandwidth.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
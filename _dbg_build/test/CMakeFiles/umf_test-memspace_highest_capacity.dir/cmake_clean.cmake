@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memspace_highest_capacity.dir/memspaces/memspace_highest_capacity.cpp.o"
+  "CMakeFiles/umf_test-memspace_highest_capacity.dir/memspaces/memspace_highest_capacity.cpp.o.d"
+  "umf_test-memspace_highest_capacity"
+  "umf_test-memspace_highest_capacity.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memspace_highest_capacity.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memspace_host_all.dir/memspaces/memspace_host_all.cpp.o"
+  "CMakeFiles/umf_test-memspace_host_all.dir/memspaces/memspace_host_all.cpp.o.d"
+  "umf_test-memspace_host_all"
+  "umf_test-memspace_host_all.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memspace_host_all.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memspace_lowest_latency.dir/memspaces/memspace_lowest_latency.cpp.o"
+  "CMakeFiles/umf_test-memspace_lowest_latency.dir/memspaces/memspace_lowest_latency.cpp.o.d"
+  "umf_test-memspace_lowest_latency"
+  "umf_test-memspace_lowest_latency.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memspace_lowest_latency.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
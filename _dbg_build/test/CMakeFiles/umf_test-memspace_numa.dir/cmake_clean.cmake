@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memspace_numa.dir/memspaces/memspace_numa.cpp.o"
+  "CMakeFiles/umf_test-memspace_numa.dir/memspaces/memspace_numa.cpp.o.d"
+  "umf_test-memspace_numa"
+  "umf_test-memspace_numa.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memspace_numa.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-memtarget.dir/memspaces/memtarget.cpp.o"
+  "CMakeFiles/umf_test-memtarget.dir/memspaces/memtarget.cpp.o.d"
+  "umf_test-memtarget"
+  "umf_test-memtarget.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-memtarget.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
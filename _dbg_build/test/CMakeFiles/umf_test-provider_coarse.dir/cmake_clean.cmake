@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-provider_coarse.dir/provider_coarse.cpp.o"
+  "CMakeFiles/umf_test-provider_coarse.dir/provider_coarse.cpp.o.d"
+  "umf_test-provider_coarse"
+  "umf_test-provider_coarse.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-provider_coarse.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-provider_devdax_memory.dir/provider_devdax_memory.cpp.o"
+  "CMakeFiles/umf_test-provider_devdax_memory.dir/provider_devdax_memory.cpp.o.d"
+  "umf_test-provider_devdax_memory"
+  "umf_test-provider_devdax_memory.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-provider_devdax_memory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
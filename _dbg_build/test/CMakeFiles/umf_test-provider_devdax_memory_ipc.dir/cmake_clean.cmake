@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-provider_devdax_memory_ipc.dir/provider_devdax_memory_ipc.cpp.o"
+  "CMakeFiles/umf_test-provider_devdax_memory_ipc.dir/provider_devdax_memory_ipc.cpp.o.d"
+  "umf_test-provider_devdax_memory_ipc"
+  "umf_test-provider_devdax_memory_ipc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-provider_devdax_memory_ipc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-provider_os_memory.dir/provider_os_memory.cpp.o"
+  "CMakeFiles/umf_test-provider_os_memory.dir/provider_os_memory.cpp.o.d"
+  "umf_test-provider_os_memory"
+  "umf_test-provider_os_memory.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-provider_os_memory.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-provider_os_memory_config.dir/provider_os_memory_config.cpp.o"
+  "CMakeFiles/umf_test-provider_os_memory_config.dir/provider_os_memory_config.cpp.o.d"
+  "umf_test-provider_os_memory_config"
+  "umf_test-provider_os_memory_config.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-provider_os_memory_config.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-provider_os_memory_multiple_numa_nodes.dir/provider_os_memory_multiple_numa_nodes.cpp.o"
+  "CMakeFiles/umf_test-provider_os_memory_multiple_numa_nodes.dir/provider_os_memory_multiple_numa_nodes.cpp.o.d"
+  "umf_test-provider_os_memory_multiple_numa_nodes"
+  "umf_test-provider_os_memory_multiple_numa_nodes.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-provider_os_memory_multiple_numa_nodes.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-scalable_coarse_devdax.dir/malloc_compliance_tests.cpp.o"
+  "CMakeFiles/umf_test-scalable_coarse_devdax.dir/malloc_compliance_tests.cpp.o.d"
+  "CMakeFiles/umf_test-scalable_coarse_devdax.dir/pools/scalable_coarse_devdax.cpp.o"
+  "CMakeFiles/umf_test-scalable_coarse_devdax.dir/pools/scalable_coarse_devdax.cpp.o.d"
+  "umf_test-scalable_coarse_devdax"
+  "umf_test-scalable_coarse_devdax.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-scalable_coarse_devdax.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-scalable_coarse_file.dir/malloc_compliance_tests.cpp.o"
+  "CMakeFiles/umf_test-scalable_coarse_file.dir/malloc_compliance_tests.cpp.o.d"
+  "CMakeFiles/umf_test-scalable_coarse_file.dir/pools/scalable_coarse_file.cpp.o"
+  "CMakeFiles/umf_test-scalable_coarse_file.dir/pools/scalable_coarse_file.cpp.o.d"
+  "umf_test-scalable_coarse_file"
+  "umf_test-scalable_coarse_file.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-scalable_coarse_file.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-scalable_pool.dir/malloc_compliance_tests.cpp.o"
+  "CMakeFiles/umf_test-scalable_pool.dir/malloc_compliance_tests.cpp.o.d"
+  "CMakeFiles/umf_test-scalable_pool.dir/pools/scalable_pool.cpp.o"
+  "CMakeFiles/umf_test-scalable_pool.dir/pools/scalable_pool.cpp.o.d"
+  "umf_test-scalable_pool"
+  "umf_test-scalable_pool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-scalable_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/umf_test-utils_linux_common.dir/utils/utils_linux.cpp.o"
+  "CMakeFiles/umf_test-utils_linux_common.dir/utils/utils_linux.cpp.o.d"
+  "umf_test-utils_linux_common"
+  "umf_test-utils_linux_common.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/umf_test-utils_linux_common.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,86 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/test
+# Build directory: /root/repo/_dbg_build/test
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(umf-base "/root/repo/_dbg_build/test/umf_test-base")
+set_tests_properties(umf-base PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;162;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memoryPool "/root/repo/_dbg_build/test/umf_test-memoryPool")
+set_tests_properties(umf-memoryPool PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;163;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memoryProvider "/root/repo/_dbg_build/test/umf_test-memoryProvider")
+set_tests_properties(umf-memoryProvider PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;167;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-logger "/root/repo/_dbg_build/test/umf_test-logger")
+set_tests_properties(umf-logger PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;171;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-utils_common "/root/repo/_dbg_build/test/umf_test-utils_common")
+set_tests_properties(umf-utils_common PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;176;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-utils_linux_common "/root/repo/_dbg_build/test/umf_test-utils_linux_common")
+set_tests_properties(umf-utils_linux_common PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;182;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-provider_coarse "/root/repo/_dbg_build/test/umf_test-provider_coarse")
+set_tests_properties(umf-provider_coarse PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;188;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-disjointPool "/root/repo/_dbg_build/test/umf_test-disjointPool")
+set_tests_properties(umf-disjointPool PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;194;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-c_api_disjoint_pool "/root/repo/_dbg_build/test/umf_test-c_api_disjoint_pool")
+set_tests_properties(umf-c_api_disjoint_pool PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;198;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-disjointCoarseMallocPool "/root/repo/_dbg_build/test/umf_test-disjointCoarseMallocPool")
+set_tests_properties(umf-disjointCoarseMallocPool PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;202;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-scalable_pool "/root/repo/_dbg_build/test/umf_test-scalable_pool")
+set_tests_properties(umf-scalable_pool PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;226;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-provider_os_memory "/root/repo/_dbg_build/test/umf_test-provider_os_memory")
+set_tests_properties(umf-provider_os_memory PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;242;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-provider_os_memory_multiple_numa_nodes "/root/repo/_dbg_build/test/umf_test-provider_os_memory_multiple_numa_nodes")
+set_tests_properties(umf-provider_os_memory_multiple_numa_nodes PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;252;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memspace_numa "/root/repo/_dbg_build/test/umf_test-memspace_numa")
+set_tests_properties(umf-memspace_numa PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;256;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-provider_os_memory_config "/root/repo/_dbg_build/test/umf_test-provider_os_memory_config")
+set_tests_properties(umf-provider_os_memory_config PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;260;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memspace_host_all "/root/repo/_dbg_build/test/umf_test-memspace_host_all")
+set_tests_properties(umf-memspace_host_all PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;264;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memspace_highest_capacity "/root/repo/_dbg_build/test/umf_test-memspace_highest_capacity")
+set_tests_properties(umf-memspace_highest_capacity PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;268;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memspace_highest_bandwidth "/root/repo/_dbg_build/test/umf_test-memspace_highest_bandwidth")
+set_tests_properties(umf-memspace_highest_bandwidth PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;272;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memspace_lowest_latency "/root/repo/_dbg_build/test/umf_test-memspace_lowest_latency")
+set_tests_properties(umf-memspace_lowest_latency PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;276;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-mempolicy "/root/repo/_dbg_build/test/umf_test-mempolicy")
+set_tests_properties(umf-mempolicy PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;280;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memspace "/root/repo/_dbg_build/test/umf_test-memspace")
+set_tests_properties(umf-memspace PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;284;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-memtarget "/root/repo/_dbg_build/test/umf_test-memtarget")
+set_tests_properties(umf-memtarget PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;288;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-provider_devdax_memory "/root/repo/_dbg_build/test/umf_test-provider_devdax_memory")
+set_tests_properties(umf-provider_devdax_memory PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;292;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-provider_devdax_memory_ipc "/root/repo/_dbg_build/test/umf_test-provider_devdax_memory_ipc")
+set_tests_properties(umf-provider_devdax_memory_ipc PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;296;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-provider_file_memory "/root/repo/_dbg_build/test/umf_test-provider_file_memory")
+set_tests_properties(umf-provider_file_memory PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;300;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-provider_file_memory_ipc "/root/repo/_dbg_build/test/umf_test-provider_file_memory_ipc")
+set_tests_properties(umf-provider_file_memory_ipc PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;304;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-scalable_coarse_file "/root/repo/_dbg_build/test/umf_test-scalable_coarse_file")
+set_tests_properties(umf-scalable_coarse_file PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;323;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-scalable_coarse_devdax "/root/repo/_dbg_build/test/umf_test-scalable_coarse_devdax")
+set_tests_properties(umf-scalable_coarse_devdax PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;328;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-base_alloc "/root/repo/_dbg_build/test/umf_test-base_alloc")
+set_tests_properties(umf-base_alloc PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;395;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-base_alloc_linear "/root/repo/_dbg_build/test/umf_test-base_alloc_linear")
+set_tests_properties(umf-base_alloc_linear PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;399;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-base_alloc_global "/root/repo/_dbg_build/test/umf_test-base_alloc_global")
+set_tests_properties(umf-base_alloc_global PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;404;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-critnib "/root/repo/_dbg_build/test/umf_test-critnib")
+set_tests_properties(umf-critnib PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;415;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-ipc "/root/repo/_dbg_build/test/umf_test-ipc")
+set_tests_properties(umf-ipc PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;437;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-ipc_negative "/root/repo/_dbg_build/test/umf_test-ipc_negative")
+set_tests_properties(umf-ipc_negative PROPERTIES  LABELS "umf" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;115;add_test;/root/repo/test/CMakeLists.txt;442;add_umf_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-ipc_os_prov_anon_fd "ipc_os_prov_anon_fd.sh")
+set_tests_properties(umf-ipc_os_prov_anon_fd PROPERTIES  LABELS "umf" SKIP_RETURN_CODE "125" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;465;add_test;/root/repo/test/CMakeLists.txt;493;add_umf_ipc_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-ipc_os_prov_shm "ipc_os_prov_shm.sh")
+set_tests_properties(umf-ipc_os_prov_shm PROPERTIES  LABELS "umf" SKIP_RETURN_CODE "125" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;465;add_test;/root/repo/test/CMakeLists.txt;494;add_umf_ipc_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-ipc_devdax_prov "ipc_devdax_prov.sh")
+set_tests_properties(umf-ipc_devdax_prov PROPERTIES  LABELS "umf" SKIP_RETURN_CODE "125" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;465;add_test;/root/repo/test/CMakeLists.txt;522;add_umf_ipc_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-ipc_file_prov "ipc_file_prov.sh")
+set_tests_properties(umf-ipc_file_prov PROPERTIES  LABELS "umf" SKIP_RETURN_CODE "125" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;465;add_test;/root/repo/test/CMakeLists.txt;538;add_umf_ipc_test;/root/repo/test/CMakeLists.txt;0;")
+add_test(umf-ipc_file_prov_fsdax "ipc_file_prov_fsdax.sh")
+set_tests_properties(umf-ipc_file_prov_fsdax PROPERTIES  LABELS "umf" SKIP_RETURN_CODE "125" TIMEOUT "60" WORKING_DIRECTORY "/root/repo/_dbg_build/test" _BACKTRACE_TRIPLES "/root/repo/test/CMakeLists.txt;465;add_test;/root/repo/test/CMakeLists.txt;539;add_umf_ipc_test;/root/repo/test/CMakeLists.txt;0;")
+subdirs("../_deps/googletest-build")
+subdirs("common")
@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/common/pool_null.c" "test/common/CMakeFiles/umf_test_common.dir/pool_null.c.o" "gcc" "test/common/CMakeFiles/umf_test_common.dir/pool_null.c.o.d"
+  "/root/repo/test/common/pool_trace.c" "test/common/CMakeFiles/umf_test_common.dir/pool_trace.c.o" "gcc" "test/common/CMakeFiles/umf_test_common.dir/pool_trace.c.o.d"
+  "/root/repo/test/common/provider_null.c" "test/common/CMakeFiles/umf_test_common.dir/provider_null.c.o" "gcc" "test/common/CMakeFiles/umf_test_common.dir/provider_null.c.o.d"
+  "/root/repo/test/common/provider_trace.c" "test/common/CMakeFiles/umf_test_common.dir/provider_trace.c.o" "gcc" "test/common/CMakeFiles/umf_test_common.dir/provider_trace.c.o.d"
+  "/root/repo/test/common/test_helpers.c" "test/common/CMakeFiles/umf_test_common.dir/test_helpers.c.o" "gcc" "test/common/CMakeFiles/umf_test_common.dir/test_helpers.c.o.d"
+  "/root/repo/test/common/test_helpers_linux.c" "test/common/CMakeFiles/umf_test_common.dir/test_helpers_linux.c.o" "gcc" "test/common/CMakeFiles/umf_test_common.dir/test_helpers_linux.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
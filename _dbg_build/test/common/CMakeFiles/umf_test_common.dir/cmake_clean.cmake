@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "../../lib/libumf_test_common.a"
+  "../../lib/libumf_test_common.pdb"
+  "CMakeFiles/umf_test_common.dir/pool_null.c.o"
+  "CMakeFiles/umf_test_common.dir/pool_null.c.o.d"
+  "CMakeFiles/umf_test_common.dir/pool_trace.c.o"
+  "CMakeFiles/umf_test_common.dir/pool_trace.c.o.d"
+  "CMakeFiles/umf_test_common.dir/provider_null.c.o"
+  "CMakeFiles/umf_test_common.dir/provider_null.c.o.d"
+  "CMakeFiles/umf_test_common.dir/provider_trace.c.o"
+  "CMakeFiles/umf_test_common.dir/provider_trace.c.o.d"
+  "CMakeFiles/umf_test_common.dir/test_helpers.c.o"
+  "CMakeFiles/umf_test_common.dir/test_helpers.c.o.d"
+  "CMakeFiles/umf_test_common.dir/test_helpers_linux.c.o"
+  "CMakeFiles/umf_test_common.dir/test_helpers_linux.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/umf_test_common.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "../../lib/libumf_test_common.a"
+)
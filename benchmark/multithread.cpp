@@ -9,12 +9,17 @@
 
 #include "multithread.hpp"
 
+#include "critnib.h"
+
 #include <umf/memory_pool.h>
 #include <umf/pools/pool_disjoint.h>
 #include <umf/pools/pool_jemalloc.h>
+#include <umf/pools/pool_proxy.h>
 #include <umf/pools/pool_scalable.h>
+#include <umf/providers/provider_coarse.h>
 #include <umf/providers/provider_os_memory.h>
 
+#include <atomic>
 #include <iostream>
 #include <memory>
 #include <numeric>
@@ -90,6 +95,179 @@ static void mt_alloc_free(poolCreateExtParams params,
               << std::endl;
 }
 
+#if defined(UMF_BUILD_LIBUMF_POOL_DISJOINT)
+// Threads work in pairs: the even thread allocates messages and passes them
+// to the odd thread through a ring of slots, which frees them.
+static void mt_producer_consumer(poolCreateExtParams params,
+                                 const bench_params &bench = bench_params()) {
+    static constexpr size_t queue_size = 1024;
+
+    auto pool = poolCreateExtUnique(params);
+
+    size_t n_pairs = bench.n_threads / 2;
+    std::vector<std::unique_ptr<std::atomic<void *>[]>> queues(n_pairs);
+    for (auto &queue : queues) {
+        queue = std::make_unique<std::atomic<void *>[]>(queue_size);
+        for (size_t i = 0; i < queue_size; i++) {
+            queue[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    std::vector<size_t> numFailures(bench.n_threads);
+
+    auto values = umf_bench::measure<std::chrono::milliseconds>(
+        bench.n_repeats, n_pairs * 2, [&, pool = pool.get()](auto thread_id) {
+            auto &queue = queues[thread_id / 2];
+            for (size_t i = 0; i < bench.n_iterations; i++) {
+                auto &slot = queue[i % queue_size];
+                if (thread_id % 2 == 0) {
+                    void *ptr = umfPoolMalloc(pool, bench.alloc_size);
+                    if (!ptr) {
+                        numFailures[thread_id]++;
+                        // the consumer waits for a non-null pointer
+                        ptr = &slot;
+                    }
+                    while (slot.load(std::memory_order_acquire)) {
+                        std::this_thread::yield();
+                    }
+                    slot.store(ptr, std::memory_order_release);
+                } else {
+                    void *ptr;
+                    while (!(ptr = slot.load(std::memory_order_acquire))) {
+                        std::this_thread::yield();
+                    }
+                    slot.store(nullptr, std::memory_order_release);
+                    if (ptr != &slot) {
+                        umfPoolFree(pool, ptr);
+                    }
+                }
+            }
+        });
+
+    std::cout << "mean: " << umf_bench::mean(values)
+              << " [ms] std_dev: " << umf_bench::std_dev(values) << " [ms]"
+              << " (total alloc failures: "
+              << std::accumulate(numFailures.begin(), numFailures.end(), 0ULL)
+              << " out of " << bench.n_iterations * bench.n_repeats * n_pairs
+              << ")" << std::endl;
+}
+#endif
+
+// Threads allocate and free memory directly from a coarse provider
+// on top of the OS memory provider.
+static void mt_coarse_alloc_free(size_t num_heaps,
+                                 const bench_params &bench = bench_params()) {
+    umf_memory_provider_handle_t os_provider = nullptr;
+    auto osParams = umfOsMemoryProviderParamsDefault();
+    auto ret = umfMemoryProviderCreate(umfOsMemoryProviderOps(), &osParams,
+                                       &os_provider);
+    if (ret != UMF_RESULT_SUCCESS) {
+        std::cerr << "provider create failed" << std::endl;
+        abort();
+    }
+
+    auto coarseParams = umfCoarseMemoryProviderParamsDefault();
+    coarseParams.upstream_memory_provider = os_provider;
+    coarseParams.destroy_upstream_memory_provider = true;
+    coarseParams.num_heaps = num_heaps;
+
+    umf_memory_provider_handle_t provider = nullptr;
+    ret = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(), &coarseParams,
+                                  &provider);
+    if (ret != UMF_RESULT_SUCCESS) {
+        std::cerr << "provider create failed" << std::endl;
+        abort();
+    }
+
+    std::vector<std::vector<void *>> allocs(bench.n_threads);
+    std::vector<size_t> numFailures(bench.n_threads);
+    for (auto &v : allocs) {
+        v.reserve(bench.n_iterations);
+    }
+
+    auto values = umf_bench::measure<std::chrono::milliseconds>(
+        bench.n_repeats, bench.n_threads, [&](auto thread_id) {
+            for (size_t i = 0; i < bench.n_iterations; i++) {
+                void *ptr = nullptr;
+                // sizes of 1-8 pages
+                size_t size = (i % 8 + 1) * 4096;
+                if (umfMemoryProviderAlloc(provider, size, 0, &ptr) !=
+                    UMF_RESULT_SUCCESS) {
+                    numFailures[thread_id]++;
+                }
+                allocs[thread_id].push_back(ptr);
+            }
+
+            for (size_t i = 0; i < bench.n_iterations; i++) {
+                if (allocs[thread_id][i]) {
+                    umfMemoryProviderFree(provider, allocs[thread_id][i],
+                                          (i % 8 + 1) * 4096);
+                }
+            }
+
+            // clear the vector as this function might be called multiple times
+            allocs[thread_id].clear();
+        });
+
+    umfMemoryProviderDestroy(provider);
+
+    std::cout << "mean: " << umf_bench::mean(values)
+              << " [ms] std_dev: " << umf_bench::std_dev(values) << " [ms]"
+              << " (total alloc failures: "
+              << std::accumulate(numFailures.begin(), numFailures.end(), 0ULL)
+              << " out of "
+              << bench.n_iterations * bench.n_repeats * bench.n_threads << ")"
+              << std::endl;
+}
+
+// Lookups (FIND_LE) of addresses inside the page-aligned entries
+// of a critnib, like the tracker does on every umfFree(), by all threads
+// at once.
+static void mt_critnib_find(const bench_params &bench = bench_params()) {
+    const size_t n_entries = 64 * 1024;
+    const uintptr_t base = (uintptr_t)0x7f0000000000;
+
+    critnib *c = critnib_new();
+    if (c == nullptr) {
+        std::cerr << "critnib_new() failed" << std::endl;
+        abort();
+    }
+
+    for (size_t i = 0; i < n_entries; i++) {
+        uintptr_t key = base + i * 2 * 4096;
+        if (critnib_insert(c, key, (void *)key, 0)) {
+            std::cerr << "critnib_insert() failed" << std::endl;
+            abort();
+        }
+    }
+
+    std::vector<size_t> numFailures(bench.n_threads);
+
+    auto values = umf_bench::measure<std::chrono::milliseconds>(
+        bench.n_repeats, bench.n_threads, [&](auto thread_id) {
+            uint64_t seed = thread_id + 1;
+            for (size_t i = 0; i < bench.n_iterations; i++) {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+                uintptr_t key = base + ((seed >> 33) % n_entries) * 2 * 4096;
+                uintptr_t rkey;
+                void *rvalue;
+                if (!critnib_find(c, key + 100, FIND_LE, &rkey, &rvalue) ||
+                    rkey != key) {
+                    numFailures[thread_id]++;
+                }
+            }
+        });
+
+    critnib_delete(c);
+
+    std::cout << "mean: " << umf_bench::mean(values)
+              << " [ms] std_dev: " << umf_bench::std_dev(values) << " [ms]"
+              << " (total lookup failures: "
+              << std::accumulate(numFailures.begin(), numFailures.end(), 0ULL)
+              << " out of "
+              << bench.n_iterations * bench.n_repeats * bench.n_threads << ")"
+              << std::endl;
+}
+
 int main() {
     auto osParams = umfOsMemoryProviderParamsDefault();
 
@@ -122,10 +300,124 @@ int main() {
     std::cout << "disjoint_pool mt_alloc_free: ";
     mt_alloc_free(poolCreateExtParams{umfDisjointPoolOps(), &disjointParams,
                                       umfOsMemoryProviderOps(), &osParams});
+
+    // Scaling with the number of threads, without and with the thread-local
+    // chunk cache.
+    bench_params scalingParams;
+    scalingParams.n_iterations = 10000;
+
+    for (size_t threadCacheCapacity : {0, 64}) {
+        disjointParams.ThreadCacheCapacity = threadCacheCapacity;
+        for (size_t n_threads : {1, 2, 4, 8, 16}) {
+            scalingParams.n_threads = n_threads;
+            std::cout << "disjoint_pool mt_alloc_free (threads: " << n_threads
+                      << ", thread cache: " << threadCacheCapacity << "): ";
+            mt_alloc_free(poolCreateExtParams{umfDisjointPoolOps(),
+                                              &disjointParams,
+                                              umfOsMemoryProviderOps(),
+                                              &osParams},
+                          scalingParams);
+        }
+    }
+    disjointParams.ThreadCacheCapacity = 0;
+
+    // Scaling of chunks of 1 KiB from slabs grown up to 16 times
+    // SlabMinSize, so that most frees land past SlabMinSize in their slab.
+    bench_params grownSlabsParams;
+    grownSlabsParams.n_iterations = 10000;
+    grownSlabsParams.alloc_size = 1024;
+
+    auto grownSlabsPoolParams = disjointParams;
+    grownSlabsPoolParams.SlabMinSize = 64 * 1024;
+    grownSlabsPoolParams.MaxPoolableSize = 64 * 1024;
+    grownSlabsPoolParams.Capacity = 4;
+    grownSlabsPoolParams.SlabMaxSize = 16 * grownSlabsPoolParams.SlabMinSize;
+    for (size_t n_threads : {1, 2, 4, 8, 16}) {
+        grownSlabsParams.n_threads = n_threads;
+        std::cout << "disjoint_pool mt_alloc_free grown slabs (threads: "
+                  << n_threads << "): ";
+        mt_alloc_free(poolCreateExtParams{umfDisjointPoolOps(),
+                                          &grownSlabsPoolParams,
+                                          umfOsMemoryProviderOps(), &osParams},
+                      grownSlabsParams);
+    }
+
+    // Messages allocated by one thread and freed by another, without and
+    // with the lock-free remote frees.
+    bench_params producerConsumerParams;
+    producerConsumerParams.n_iterations = 20000;
+
+    for (int remoteFrees : {0, 1}) {
+        disjointParams.RemoteFrees = remoteFrees;
+        for (size_t n_threads : {2, 4, 8}) {
+            producerConsumerParams.n_threads = n_threads;
+            std::cout << "disjoint_pool mt_producer_consumer (threads: "
+                      << n_threads << ", remote frees: " << remoteFrees
+                      << "): ";
+            mt_producer_consumer(
+                poolCreateExtParams{umfDisjointPoolOps(), &disjointParams,
+                                    umfOsMemoryProviderOps(), &osParams},
+                producerConsumerParams);
+        }
+    }
 #else
     std::cout << "skipping disjoint_pool mt_alloc_free" << std::endl;
 #endif
 
+    // Scaling of the coarse provider with the number of threads,
+    // with a single heap and with a heap per thread.
+    bench_params coarseParams;
+    coarseParams.n_iterations = 2000;
+
+    for (size_t n_threads : {2, 4, 8}) {
+        coarseParams.n_threads = n_threads;
+        for (size_t num_heaps : {(size_t)1, n_threads}) {
+            std::cout << "coarse_provider mt_alloc_free (threads: " << n_threads
+                      << ", heaps: " << num_heaps << "): ";
+            mt_coarse_alloc_free(num_heaps, coarseParams);
+        }
+    }
+
+    // Every allocation of the proxy pool adds an entry to the tracker
+    // and every free removes it. The coarse provider below has a heap
+    // per thread, so the updates of the tracker dominate.
+    bench_params trackerParams;
+    trackerParams.n_iterations = 10000;
+    trackerParams.alloc_size = 4096;
+
+    for (size_t n_threads : {1, 2, 4, 8}) {
+        trackerParams.n_threads = n_threads;
+
+        umf_memory_provider_handle_t os_provider = nullptr;
+        auto ret = umfMemoryProviderCreate(umfOsMemoryProviderOps(), &osParams,
+                                           &os_provider);
+        if (ret != UMF_RESULT_SUCCESS) {
+            std::cerr << "provider create failed" << std::endl;
+            abort();
+        }
+
+        auto coarseProviderParams = umfCoarseMemoryProviderParamsDefault();
+        coarseProviderParams.upstream_memory_provider = os_provider;
+        coarseProviderParams.destroy_upstream_memory_provider = true;
+        coarseProviderParams.num_heaps = n_threads;
+
+        std::cout << "proxy_pool mt_alloc_free tracker (threads: " << n_threads
+                  << "): ";
+        mt_alloc_free(poolCreateExtParams{umfProxyPoolOps(), nullptr,
+                                          umfCoarseMemoryProviderOps(),
+                                          &coarseProviderParams},
+                      trackerParams);
+    }
+
+    bench_params critnibParams;
+    critnibParams.n_iterations = 1000000;
+
+    for (size_t n_threads : {1, 2, 4, 8}) {
+        critnibParams.n_threads = n_threads;
+        std::cout << "critnib mt_find (threads: " << n_threads << "): ";
+        mt_critnib_find(critnibParams);
+    }
+
     // ctest looks for "PASSED" in the output
     std::cout << "PASSED" << std::endl;
 
@@ -8,6 +8,8 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 
 #ifndef _WIN32
 #include <unistd.h>
@@ -17,6 +19,7 @@
 #include <umf/memory_pool.h>
 #include <umf/pools/pool_proxy.h>
 #include <umf/pools/pool_scalable.h>
+#include <umf/providers/provider_coarse.h>
 #include <umf/providers/provider_level_zero.h>
 #include <umf/providers/provider_os_memory.h>
 
@@ -28,6 +31,7 @@
 #include <umf/pools/pool_jemalloc.h>
 #endif
 
+#include "critnib.h"
 #include "utils_common.h"
 
 #if (defined UMF_BUILD_LIBUMF_POOL_DISJOINT &&                                 \
@@ -287,6 +291,260 @@ UBENCH_EX(simple, disjoint_pool_with_os_memory_provider) {
     umfMemoryProviderDestroy(os_memory_provider);
     free(array);
 }
+
+////////////////// VECTOR GROWTH IN DISJOINT POOL
+
+#define VECTOR_GROWTH_MAX_SIZE (16 * 1024)
+#define VECTOR_GROWTH_N_VECTORS 100
+
+// Append 8-byte elements to a vector that grows by 1.5x like std::vector.
+// If use_usable_size is set, the capacity is extended to the usable size
+// of each allocation, so the slack of the buckets is used before the next
+// reallocation.
+static void do_vector_growth_benchmark(umf_memory_pool_handle_t pool,
+                                       bool use_usable_size) {
+    for (int v = 0; v < VECTOR_GROWTH_N_VECTORS; v++) {
+        uint64_t *data = NULL;
+        size_t size = 0;
+        size_t capacity = 0;
+
+        while (size < VECTOR_GROWTH_MAX_SIZE / sizeof(uint64_t)) {
+            if (size == capacity) {
+                size_t new_capacity = capacity ? capacity + capacity / 2 : 2;
+                uint64_t *new_data =
+                    umfPoolMalloc(pool, new_capacity * sizeof(uint64_t));
+                if (new_data == NULL) {
+                    fprintf(stderr, "error: umfPoolMalloc() failed\n");
+                    exit(-1);
+                }
+
+                if (use_usable_size) {
+                    new_capacity = umfPoolMallocUsableSize(pool, new_data) /
+                                   sizeof(uint64_t);
+                }
+
+                if (data) {
+                    memcpy(new_data, data, size * sizeof(uint64_t));
+                    umfPoolFree(pool, data);
+                }
+                data = new_data;
+                capacity = new_capacity;
+            }
+
+            data[size] = size;
+            size++;
+        }
+
+        umfPoolFree(pool, data);
+    }
+}
+
+static umf_memory_pool_handle_t
+create_disjoint_pool(umf_disjoint_pool_params_t *disjoint_memory_pool_params,
+                     umf_memory_provider_handle_t *os_memory_provider) {
+    umf_result_t umf_result;
+    umf_result = umfMemoryProviderCreate(umfOsMemoryProviderOps(),
+                                         &UMF_OS_MEMORY_PROVIDER_PARAMS,
+                                         os_memory_provider);
+    if (umf_result != UMF_RESULT_SUCCESS) {
+        fprintf(stderr, "error: umfMemoryProviderCreate() failed\n");
+        exit(-1);
+    }
+
+    umf_memory_pool_handle_t disjoint_pool;
+    umf_result = umfPoolCreate(umfDisjointPoolOps(), *os_memory_provider,
+                               disjoint_memory_pool_params, 0, &disjoint_pool);
+    if (umf_result != UMF_RESULT_SUCCESS) {
+        fprintf(stderr, "error: umfPoolCreate() failed\n");
+        exit(-1);
+    }
+
+    return disjoint_pool;
+}
+
+static umf_memory_pool_handle_t
+create_vector_growth_pool(umf_memory_provider_handle_t *os_memory_provider) {
+    umf_disjoint_pool_params_t disjoint_memory_pool_params =
+        umfDisjointPoolParamsDefault();
+    disjoint_memory_pool_params.MaxPoolableSize = VECTOR_GROWTH_MAX_SIZE * 2;
+
+    return create_disjoint_pool(&disjoint_memory_pool_params,
+                                os_memory_provider);
+}
+
+UBENCH_EX(vector_growth, disjoint_pool_requested_size) {
+    umf_memory_provider_handle_t os_memory_provider = NULL;
+    umf_memory_pool_handle_t disjoint_pool =
+        create_vector_growth_pool(&os_memory_provider);
+
+    do_vector_growth_benchmark(disjoint_pool, false); // WARMUP
+
+    UBENCH_DO_BENCHMARK() { do_vector_growth_benchmark(disjoint_pool, false); }
+
+    umfPoolDestroy(disjoint_pool);
+    umfMemoryProviderDestroy(os_memory_provider);
+}
+
+UBENCH_EX(vector_growth, disjoint_pool_usable_size) {
+    umf_memory_provider_handle_t os_memory_provider = NULL;
+    umf_memory_pool_handle_t disjoint_pool =
+        create_vector_growth_pool(&os_memory_provider);
+
+    do_vector_growth_benchmark(disjoint_pool, true); // WARMUP
+
+    UBENCH_DO_BENCHMARK() { do_vector_growth_benchmark(disjoint_pool, true); }
+
+    umfPoolDestroy(disjoint_pool);
+    umfMemoryProviderDestroy(os_memory_provider);
+}
+
+////////////////// FRAGMENTATION OF DISJOINT POOL SIZE CLASSES
+
+// Message objects of 130-180 bytes
+#define FRAGMENTATION_MIN_SIZE 130
+#define FRAGMENTATION_MAX_SIZE 180
+#define FRAGMENTATION_N_ALLOCS 10000
+
+static const size_t FRAGMENTATION_BUCKET_SIZES[] = {136, 144, 152, 160,
+                                                    168, 176, 184};
+
+// Allocate and free FRAGMENTATION_N_ALLOCS objects of pseudo-random sizes.
+// Return the internal fragmentation: wasted bytes per 100 requested bytes.
+static double do_fragmentation_benchmark(umf_memory_pool_handle_t pool,
+                                         alloc_t *array) {
+    size_t requested = 0;
+    size_t usable = 0;
+    unsigned seed = 1;
+
+    for (size_t i = 0; i < FRAGMENTATION_N_ALLOCS; i++) {
+        seed = seed * 1103515245 + 12345;
+        array[i].size = FRAGMENTATION_MIN_SIZE +
+                        (seed >> 16) % (FRAGMENTATION_MAX_SIZE -
+                                        FRAGMENTATION_MIN_SIZE + 1);
+        array[i].ptr = umfPoolMalloc(pool, array[i].size);
+        if (array[i].ptr == NULL) {
+            fprintf(stderr, "error: umfPoolMalloc() failed\n");
+            exit(-1);
+        }
+
+        requested += array[i].size;
+        usable += umfPoolMallocUsableSize(pool, array[i].ptr);
+    }
+
+    for (size_t i = 0; i < FRAGMENTATION_N_ALLOCS; i++) {
+        umfPoolFree(pool, array[i].ptr);
+    }
+
+    return 100.0 * (double)(usable - requested) / (double)requested;
+}
+
+static void run_fragmentation_benchmark(
+    struct ubench_run_state_s *ubench_run_state, const char *name,
+    umf_disjoint_pool_params_t *disjoint_memory_pool_params) {
+    alloc_t *array = alloc_array(FRAGMENTATION_N_ALLOCS);
+    umf_memory_provider_handle_t os_memory_provider = NULL;
+    umf_memory_pool_handle_t disjoint_pool =
+        create_disjoint_pool(disjoint_memory_pool_params, &os_memory_provider);
+
+    double wasted = do_fragmentation_benchmark(disjoint_pool, array); // WARMUP
+    printf("%s: %.1f%% of the requested size wasted\n", name, wasted);
+
+    UBENCH_DO_BENCHMARK() { do_fragmentation_benchmark(disjoint_pool, array); }
+
+    umfPoolDestroy(disjoint_pool);
+    umfMemoryProviderDestroy(os_memory_provider);
+    free(array);
+}
+
+UBENCH_EX(fragmentation, disjoint_pool_2_classes_per_doubling) {
+    umf_disjoint_pool_params_t params = umfDisjointPoolParamsDefault();
+    params.SlabMinSize = 64 * 1024;
+    params.MaxPoolableSize = 4096;
+    run_fragmentation_benchmark(ubench_run_state, "2 classes per doubling",
+                                &params);
+}
+
+UBENCH_EX(fragmentation, disjoint_pool_8_classes_per_doubling) {
+    umf_disjoint_pool_params_t params = umfDisjointPoolParamsDefault();
+    params.SlabMinSize = 64 * 1024;
+    params.MaxPoolableSize = 4096;
+    params.SizeClassesPerDoubling = 8;
+    run_fragmentation_benchmark(ubench_run_state, "8 classes per doubling",
+                                &params);
+}
+
+UBENCH_EX(fragmentation, disjoint_pool_explicit_bucket_sizes) {
+    umf_disjoint_pool_params_t params = umfDisjointPoolParamsDefault();
+    params.SlabMinSize = 64 * 1024;
+    params.MaxPoolableSize = 4096;
+    params.BucketSizes = FRAGMENTATION_BUCKET_SIZES;
+    params.NumBucketSizes = sizeof(FRAGMENTATION_BUCKET_SIZES) /
+                            sizeof(FRAGMENTATION_BUCKET_SIZES[0]);
+    run_fragmentation_benchmark(ubench_run_state, "explicit bucket sizes",
+                                &params);
+}
+
+////////////////// umfFree() OF DISJOINT POOL ALLOCATIONS
+
+// umfFree() looks up the pool of every pointer in the tracker, which caches
+// the last few regions found by every thread. All allocations
+// of the "few_regions" benchmark come from a few slabs, so the lookups hit
+// the cache. Every allocation of the "many_regions" benchmark is a separate
+// slab (region), so every lookup misses the cache and walks the tracker
+// like it would without the cache.
+#define UMF_FREE_SMALL_SIZE 64
+
+static void w_umfFree(void *provider, void *ptr, size_t size) {
+    (void)provider; // unused
+    (void)size;     // unused
+    umf_result_t umf_result = umfFree(ptr);
+    if (umf_result != UMF_RESULT_SUCCESS) {
+        fprintf(stderr, "error: umfFree() failed\n");
+        exit(-1);
+    }
+}
+
+static void
+run_umf_free_benchmark(struct ubench_run_state_s *ubench_run_state,
+                       umf_disjoint_pool_params_t *disjoint_memory_pool_params,
+                       size_t alloc_size) {
+    alloc_t *array = alloc_array(N_ITERATIONS);
+    Alloc_size = (int)alloc_size;
+
+    umf_memory_provider_handle_t os_memory_provider = NULL;
+    umf_memory_pool_handle_t disjoint_pool =
+        create_disjoint_pool(disjoint_memory_pool_params, &os_memory_provider);
+
+    do_benchmark(array, N_ITERATIONS, w_umfPoolMalloc, w_umfFree,
+                 disjoint_pool); // WARMUP
+
+    UBENCH_DO_BENCHMARK() {
+        do_benchmark(array, N_ITERATIONS, w_umfPoolMalloc, w_umfFree,
+                     disjoint_pool);
+    }
+
+    umfPoolDestroy(disjoint_pool);
+    umfMemoryProviderDestroy(os_memory_provider);
+    free(array);
+}
+
+UBENCH_EX(umf_free, disjoint_pool_few_regions) {
+    umf_disjoint_pool_params_t params = umfDisjointPoolParamsDefault();
+    params.SlabMinSize = 64 * 1024;
+    params.MaxPoolableSize = 4096;
+    params.Capacity = DISJOINT_POOL_CAPACITY;
+    params.MinBucketSize = UMF_FREE_SMALL_SIZE;
+    run_umf_free_benchmark(ubench_run_state, &params, UMF_FREE_SMALL_SIZE);
+}
+
+UBENCH_EX(umf_free, disjoint_pool_many_regions) {
+    umf_disjoint_pool_params_t params = umfDisjointPoolParamsDefault();
+    params.SlabMinSize = DISJOINT_POOL_SLAB_MIN_SIZE;
+    params.MaxPoolableSize = DISJOINT_POOL_MAX_POOLABLE_SIZE;
+    params.Capacity = DISJOINT_POOL_CAPACITY;
+    params.MinBucketSize = DISJOINT_POOL_MIN_BUCKET_SIZE;
+    run_umf_free_benchmark(ubench_run_state, &params, ALLOC_SIZE);
+}
 #endif /* (defined UMF_BUILD_LIBUMF_POOL_DISJOINT) */
 
 #if (defined UMF_BUILD_LIBUMF_POOL_JEMALLOC)
@@ -508,6 +766,190 @@ err_destroy_context:
 
 // TODO add IPC benchmark for CUDA
 
+////////////////// POOL CREATE/DESTROY
+
+// The pool_lifecycle benchmark creates a pool, allocates and frees a few
+// regions of it and destroys it, while another pool keeps
+// POOL_LIFECYCLE_N_LIVE regions in the tracker. Destroying a pool should
+// not depend on the number of the regions of the other pools.
+// All pools are proxy pools over coarse providers with an initial buffer,
+// so every allocation is a separate region in the tracker.
+#define POOL_LIFECYCLE_N_LIVE (256 * 1024)
+#define POOL_LIFECYCLE_N_ALLOCS 16
+#define POOL_LIFECYCLE_ALLOC_SIZE 64
+
+static umf_memory_provider_handle_t create_coarse_provider(void *buffer,
+                                                           size_t buffer_size) {
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.init_buffer = buffer;
+    coarse_memory_provider_params.init_buffer_size = buffer_size;
+
+    umf_memory_provider_handle_t coarse_provider = NULL;
+    umf_result_t umf_result = umfMemoryProviderCreate(
+        umfCoarseMemoryProviderOps(), &coarse_memory_provider_params,
+        &coarse_provider);
+    if (umf_result != UMF_RESULT_SUCCESS) {
+        fprintf(stderr, "error: umfMemoryProviderCreate() failed\n");
+        exit(-1);
+    }
+
+    return coarse_provider;
+}
+
+static umf_memory_pool_handle_t
+create_proxy_pool(umf_memory_provider_handle_t provider) {
+    umf_memory_pool_handle_t proxy_pool;
+    umf_result_t umf_result =
+        umfPoolCreate(umfProxyPoolOps(), provider, NULL, 0, &proxy_pool);
+    if (umf_result != UMF_RESULT_SUCCESS) {
+        fprintf(stderr, "error: umfPoolCreate() failed\n");
+        exit(-1);
+    }
+
+    return proxy_pool;
+}
+
+static void do_pool_lifecycle_benchmark(umf_memory_provider_handle_t provider,
+                                        alloc_t *array) {
+    umf_memory_pool_handle_t pool = create_proxy_pool(provider);
+
+    do_benchmark(array, POOL_LIFECYCLE_N_ALLOCS, w_umfPoolMalloc,
+                 w_umfPoolFree, pool);
+
+    umfPoolDestroy(pool);
+}
+
+UBENCH_EX(pool_lifecycle, create_destroy_with_256K_live_regions) {
+    alloc_t *array = alloc_array(POOL_LIFECYCLE_N_LIVE);
+    Alloc_size = POOL_LIFECYCLE_ALLOC_SIZE;
+
+    size_t live_buffer_size = POOL_LIFECYCLE_N_LIVE * POOL_LIFECYCLE_ALLOC_SIZE;
+    void *live_buffer = malloc(live_buffer_size);
+    size_t buffer_size = POOL_LIFECYCLE_N_ALLOCS * POOL_LIFECYCLE_ALLOC_SIZE;
+    void *buffer = malloc(buffer_size);
+    if (live_buffer == NULL || buffer == NULL) {
+        perror("malloc() failed");
+        exit(-1);
+    }
+
+    umf_memory_provider_handle_t live_provider =
+        create_coarse_provider(live_buffer, live_buffer_size);
+    umf_memory_pool_handle_t live_pool = create_proxy_pool(live_provider);
+    for (size_t i = 0; i < POOL_LIFECYCLE_N_LIVE; i++) {
+        array[i].ptr = w_umfPoolMalloc(live_pool, POOL_LIFECYCLE_ALLOC_SIZE, 0);
+        if (array[i].ptr == NULL) {
+            fprintf(stderr, "error: umfPoolMalloc() failed\n");
+            exit(-1);
+        }
+    }
+
+    // the pools of the benchmark are created over this provider
+    umf_memory_provider_handle_t provider =
+        create_coarse_provider(buffer, buffer_size);
+
+    alloc_t allocs[POOL_LIFECYCLE_N_ALLOCS];
+    do_pool_lifecycle_benchmark(provider, allocs); // WARMUP
+
+    UBENCH_DO_BENCHMARK() { do_pool_lifecycle_benchmark(provider, allocs); }
+
+    umfMemoryProviderDestroy(provider);
+
+    for (size_t i = 0; i < POOL_LIFECYCLE_N_LIVE; i++) {
+        w_umfPoolFree(live_pool, array[i].ptr, POOL_LIFECYCLE_ALLOC_SIZE);
+    }
+    umfPoolDestroy(live_pool);
+    umfMemoryProviderDestroy(live_provider);
+
+    free(buffer);
+    free(live_buffer);
+    free(array);
+}
+
+////////////////// CRITNIB
+
+// The find benchmarks look up (FIND_LE) addresses inside page-aligned regions
+// of CRITNIB_N_ENTRIES entries, like the tracker does on every umfFree().
+// The regions are spread over CRITNIB_N_CLUSTERS distant address ranges.
+#define CRITNIB_N_ENTRIES (1024 * 1024)
+#define CRITNIB_N_CLUSTERS 16
+#define CRITNIB_N_LOOKUPS 4096
+#define CRITNIB_BASE_ADDRESS ((uintptr_t)0x7f0000000000)
+
+static uintptr_t critnib_entry_key(size_t i) {
+    // every second page of a cluster
+    return CRITNIB_BASE_ADDRESS + ((uintptr_t)(i % CRITNIB_N_CLUSTERS) << 36) +
+           (i / CRITNIB_N_CLUSTERS) * 2 * 4096;
+}
+
+// Filling a map with CRITNIB_N_ENTRIES takes much longer than the measured
+// lookups and ubench calls every benchmark many times, so each map is built
+// once and kept until the process exits.
+static critnib *get_critnib_map(critnib **map, critnib *(*map_new)(void)) {
+    if (*map) {
+        return *map;
+    }
+
+    critnib *c = map_new();
+    if (c == NULL) {
+        fprintf(stderr, "error: critnib_new() failed\n");
+        exit(-1);
+    }
+
+    for (size_t i = 0; i < CRITNIB_N_ENTRIES; i++) {
+        uintptr_t key = critnib_entry_key(i);
+        if (critnib_insert(c, key, (void *)key, 0)) {
+            fprintf(stderr, "error: critnib_insert() failed\n");
+            exit(-1);
+        }
+    }
+
+    *map = c;
+    return c;
+}
+
+static void run_critnib_find_le_benchmark(
+    struct ubench_run_state_s *ubench_run_state, critnib *c) {
+    // the same pseudo-random sequence of entries in every run
+    size_t lookups[CRITNIB_N_LOOKUPS];
+    uint64_t seed = 1234;
+    for (size_t i = 0; i < CRITNIB_N_LOOKUPS; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        lookups[i] = (size_t)(seed >> 33) % CRITNIB_N_ENTRIES;
+    }
+
+    size_t n_found = 0;
+    UBENCH_DO_BENCHMARK() {
+        for (size_t i = 0; i < CRITNIB_N_LOOKUPS; i++) {
+            uintptr_t key = critnib_entry_key(lookups[i]);
+            uintptr_t rkey;
+            void *rvalue;
+            n_found += critnib_find(c, key + 100, FIND_LE, &rkey, &rvalue) &&
+                       rkey == key;
+        }
+    }
+
+    if (n_found % CRITNIB_N_LOOKUPS) {
+        fprintf(stderr, "error: critnib_find() returned a wrong entry\n");
+        exit(-1);
+    }
+}
+
+static critnib *critnib_map_narrow;
+static critnib *critnib_map_wide;
+
+UBENCH_EX(critnib, find_le_1M_entries) {
+    run_critnib_find_le_benchmark(
+        ubench_run_state, get_critnib_map(&critnib_map_narrow, critnib_new));
+}
+
+UBENCH_EX(critnib, find_le_1M_entries_wide) {
+    run_critnib_find_le_benchmark(
+        ubench_run_state, get_critnib_map(&critnib_map_wide, critnib_new_wide));
+}
+
 UBENCH_MAIN()
 
 #if defined(_MSC_VER)
@@ -58,6 +58,80 @@ typedef struct umf_disjoint_pool_params_t {
 
     /// Name used in traces
     const char *Name;
+
+    /// Maximum number of free chunks each thread keeps cached per bucket.
+    /// Cached chunks are served and absorbed without taking the bucket lock
+    /// and are exchanged with the bucket in batches. Only buckets used in
+    /// chunked mode are cached. 0 disables the thread-local cache.
+    size_t ThreadCacheCapacity;
+
+    /// Whether memory freshly allocated from the memory provider is known
+    /// to be zero-filled (e.g. anonymous mappings of the OS memory provider).
+    /// If set, umfPoolCalloc skips zeroing memory that was never used.
+    /// Purged memory is not assumed to be zero-filled.
+    int ProviderZeroesMemory;
+
+    /// Number of bucket sizes per doubling of the size, starting from
+    /// MinBucketSize, e.g. 4 gives 64, 80, 96, 112, 128, 160, ... Must be
+    /// a power of 2 not larger than 16. Bucket sizes of the doubling
+    /// starting at size are at least min(8, size / 2) bytes apart.
+    /// 0 selects the default of 2 buckets per doubling (64, 96, 128, 192, ...).
+    size_t SizeClassesPerDoubling;
+
+    /// Optional array of NumBucketSizes strictly increasing bucket sizes.
+    /// If set, it replaces MinBucketSize and the bucket sizes up to the last
+    /// entry; larger sizes use the buckets of SizeClassesPerDoubling.
+    const size_t *BucketSizes;
+
+    /// Number of entries in BucketSizes
+    size_t NumBucketSizes;
+
+    /// Age in milliseconds after which an idle pooled slab is purged with
+    /// umfMemoryProviderPurgeLazy. After twice this age it is purged with
+    /// umfMemoryProviderPurgeForce and after three times this age it is
+    /// returned to the memory provider. 0 keeps pooled slabs indefinitely.
+    size_t DecayMs;
+
+    /// Whether pooled slabs are aged by a background thread. Otherwise they
+    /// are aged from time to time during allocations and frees.
+    int DecayBackgroundThread;
+
+    /// Whether the buckets are sharded by NUMA node. Each shard has its own
+    /// slabs and serves the threads running on its node; memory freed on
+    /// another node goes back to the shard it was allocated from. Without
+    /// hwloc or on a machine with a single NUMA node there is one shard.
+    int NumaShards;
+
+    /// Whether chunks freed by a thread other than the one which last
+    /// allocated from their slab are queued on a lock-free list instead of
+    /// taking the bucket lock. The queued chunks are reused by the next
+    /// allocation from the bucket (or the next decay pass), until then they
+    /// count as in use. Only applies to frees that bypass the thread cache
+    /// and to bucket sizes that are a multiple of the pointer size.
+    int RemoteFrees;
+
+    /// Maximum size of the slabs of the buckets used in chunked mode. If it
+    /// is larger than SlabMinSize, a bucket which needs a new slab while it
+    /// has N slabs in use creates one of SlabMinSize * 2^k bytes, where k is
+    /// the number of bits of N, so the slab size doubles as the bucket's
+    /// demand grows. A slab never holds more chunks than a SlabMinSize slab
+    /// of the smallest bucket. 0 keeps all slabs at SlabMinSize.
+    size_t SlabMaxSize;
+
+    /// Maximum number of bytes of freed allocations larger than
+    /// MaxPoolableSize kept for reuse instead of being returned to the memory
+    /// provider. An allocation is served from the smallest cached extent
+    /// that fits, whose tail stays cached if the provider supports
+    /// umfMemoryProviderAllocationSplit. The least recently freed extents
+    /// are released above the cap. 0 disables the cache.
+    size_t LargeCacheSize;
+
+    /// Age in milliseconds after which an idle extent of the large-allocation
+    /// cache is returned to the memory provider. Extents are aged on the
+    /// pool's allocations and frees larger than MaxPoolableSize, and by the
+    /// decay passes if DecayMs is set. 0 keeps extents until they are
+    /// evicted above LargeCacheSize.
+    size_t LargeCacheDecayMs;
 } umf_disjoint_pool_params_t;
 
 umf_memory_pool_ops_t *umfDisjointPoolOps(void);
@@ -72,12 +146,98 @@ static inline umf_disjoint_pool_params_t umfDisjointPoolParamsDefault(void) {
         0,                                         /* CurPoolSize */
         0,                                         /* PoolTrace */
         NULL,                                      /* SharedLimits */
-        "disjoint_pool"                            /* Name */
+        "disjoint_pool",                           /* Name */
+        0,                                         /* ThreadCacheCapacity */
+        0,                                         /* ProviderZeroesMemory */
+        0,                                         /* SizeClassesPerDoubling */
+        NULL,                                      /* BucketSizes */
+        0,                                         /* NumBucketSizes */
+        0,                                         /* DecayMs */
+        0,                                         /* DecayBackgroundThread */
+        0,                                         /* NumaShards */
+        0,                                         /* RemoteFrees */
+        0,                                         /* SlabMaxSize */
+        0,                                         /* LargeCacheSize */
+        0                                          /* LargeCacheDecayMs */
     };
 
     return params;
 }
 
+/// @brief Statistics of a single bucket of a disjoint pool
+typedef struct umf_disjoint_pool_bucket_stats_t {
+    /// Allocation size of the bucket
+    size_t BucketSize;
+
+    /// Size of the last slab created by the bucket (see SlabMaxSize)
+    size_t SlabSize;
+
+    /// Number of allocations served by the bucket
+    size_t AllocCount;
+
+    /// Number of allocations served from slabs already owned by the pool
+    size_t AllocPoolCount;
+
+    /// Number of frees of the bucket's allocations
+    size_t FreeCount;
+
+    /// Number of slabs currently in use and the peak of that number
+    size_t CurSlabsInUse;
+    size_t MaxSlabsInUse;
+
+    /// Number of slabs currently kept in the pool and the peak of that number
+    size_t CurSlabsInPool;
+    size_t MaxSlabsInPool;
+
+    /// Number of bytes of pooled slabs purged by decay
+    size_t PurgedBytes;
+
+    /// NUMA shard of the bucket, 0 if the pool is not sharded
+    size_t Shard;
+} umf_disjoint_pool_bucket_stats_t;
+
+/// @brief Get a snapshot of the per-bucket statistics of a live disjoint
+///        pool. The counters are read without locking, so they are not
+///        necessarily consistent with each other.
+/// @param hPool handle to a disjoint pool
+/// @param Stats array of *NumBuckets entries to be filled with the
+///        statistics of the first *NumBuckets buckets, or NULL. The buckets
+///        of a sharded pool are listed shard by shard.
+/// @param NumBuckets [in,out] number of entries in Stats; set to the number
+///        of buckets of the pool
+/// @return UMF_RESULT_SUCCESS on success or UMF_RESULT_ERROR_INVALID_ARGUMENT
+///         if hPool is not a disjoint pool or NumBuckets is NULL.
+umf_result_t
+umfDisjointPoolGetStats(umf_memory_pool_handle_t hPool,
+                        umf_disjoint_pool_bucket_stats_t *Stats,
+                        size_t *NumBuckets);
+
+/// @brief Statistics of the large-allocation cache of a disjoint pool
+///        (see LargeCacheSize)
+typedef struct umf_disjoint_pool_large_cache_stats_t {
+    /// Number of allocations larger than MaxPoolableSize served from the
+    /// cache and of those which had to go to the memory provider
+    size_t Hits;
+    size_t Misses;
+
+    /// Number of bytes and extents currently cached
+    size_t CachedBytes;
+    size_t CachedExtents;
+
+    /// Number of bytes returned to the memory provider by eviction or decay
+    size_t ReleasedBytes;
+} umf_disjoint_pool_large_cache_stats_t;
+
+/// @brief Get a snapshot of the statistics of the large-allocation cache of
+///        a live disjoint pool.
+/// @param hPool handle to a disjoint pool
+/// @param Stats [out] statistics of the cache
+/// @return UMF_RESULT_SUCCESS on success or UMF_RESULT_ERROR_INVALID_ARGUMENT
+///         if hPool is not a disjoint pool or Stats is NULL.
+umf_result_t
+umfDisjointPoolGetLargeCacheStats(umf_memory_pool_handle_t hPool,
+                                  umf_disjoint_pool_large_cache_stats_t *Stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,6 +36,16 @@ typedef enum coarse_memory_provider_strategy_t {
     /// use the `UMF_COARSE_MEMORY_STRATEGY_FASTEST` strategy.
     UMF_COARSE_MEMORY_STRATEGY_CHECK_ALL_SIZE,
 
+    /// Keep free blocks in a two-level segregated-fit index (TLSF-like)
+    /// and take the first free block of the smallest size class
+    /// that fits the requested size. Inserting and looking up a free block
+    /// takes a constant time regardless of the number of free blocks
+    /// (unless only blocks of the size class of the requested size fit).
+    /// For a non-zero alignment check if that block has the correct alignment.
+    /// If not, use a block of the (size + alignment) size
+    /// like the `UMF_COARSE_MEMORY_STRATEGY_FASTEST` strategy.
+    UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT,
+
     /// The maximum value (it has to be the last one).
     UMF_COARSE_MEMORY_STRATEGY_MAX
 } coarse_memory_provider_strategy_t;
@@ -74,6 +84,56 @@ typedef struct coarse_memory_provider_params_t {
 
     /// Destroy upstream_memory_provider in finalize().
     bool destroy_upstream_memory_provider;
+
+    /// Number of independently locked sub-heaps the provider consists of
+    /// (0 and 1 mean a single heap). Every thread allocates from its own
+    /// sub-heap. A sub-heap without a suitable free block takes it from
+    /// another sub-heap before getting more memory from the upstream provider.
+    /// The initial buffer is split evenly between the sub-heaps.
+    /// Allocations of different sub-heaps cannot be merged.
+    size_t num_heaps;
+
+    /// Minimum size of memory allocated from the upstream provider at once
+    /// (0 means allocating exactly the size needed by an allocation).
+    /// Smaller allocations are carved out of such upstream chunks.
+    size_t min_upstream_chunk_size;
+
+    /// Factor the size of every next upstream chunk grows by
+    /// (0 and 1 mean that all chunks are of min_upstream_chunk_size).
+    size_t upstream_chunk_growth_factor;
+
+    /// Maximum size the upstream chunks grow to (0 means no limit).
+    /// It cannot be smaller than min_upstream_chunk_size.
+    size_t max_upstream_chunk_size;
+
+    /// When the free memory of a (sub-)heap exceeds this number of bytes,
+    /// blocks allocated from the upstream provider that become entirely free
+    /// are returned to it with umfMemoryProviderFree()
+    /// (0 disables the automatic trimming). If the upstream provider
+    /// does not support the free() operation, such blocks are purged
+    /// with umfMemoryProviderPurgeForce() instead.
+    size_t trim_threshold;
+
+    /// Amount of free memory the automatic trimming always leaves
+    /// in a (sub-)heap. It has to be smaller than trim_threshold,
+    /// so that freeing and allocating memory around the threshold
+    /// does not make the provider go to the upstream provider every time.
+    size_t trim_retained_size;
+
+    /// Free blocks of at least this size that are not used for a while
+    /// give their physical memory back to the upstream provider
+    /// (0 disables it). They are checked by the alloc() and free()
+    /// operations and by umfCoarseMemoryProviderTrim().
+    size_t purge_min_size;
+
+    /// Time (in milliseconds) after which such a free block is purged
+    /// with umfMemoryProviderPurgeLazy().
+    uint64_t purge_lazy_delay_ms;
+
+    /// Time (in milliseconds) after which such a free block is purged
+    /// with umfMemoryProviderPurgeForce().
+    /// It cannot be smaller than purge_lazy_delay_ms.
+    uint64_t purge_force_delay_ms;
 } coarse_memory_provider_params_t;
 
 /// @brief Coarse Memory Provider stats (TODO move to CTL)
@@ -92,6 +152,9 @@ typedef struct coarse_memory_provider_stats_t {
 
     /// Number of free memory blocks.
     size_t num_free_blocks;
+
+    /// Number of allocations requested from the upstream provider.
+    size_t num_upstream_calls;
 } coarse_memory_provider_stats_t;
 
 umf_memory_provider_ops_t *umfCoarseMemoryProviderOps(void);
@@ -100,6 +163,20 @@ umf_memory_provider_ops_t *umfCoarseMemoryProviderOps(void);
 coarse_memory_provider_stats_t
 umfCoarseMemoryProviderGetStats(umf_memory_provider_handle_t provider);
 
+/// @brief Return entirely free blocks of memory to the upstream provider,
+///        for example on a memory-pressure event. If the upstream provider
+///        does not support the free() operation, the blocks are purged
+///        (umfMemoryProviderPurgeForce()) instead. It also purges the free
+///        blocks that have not been used for purge_lazy_delay_ms or
+///        purge_force_delay_ms, so calling it with retained_size = SIZE_MAX
+///        decays an idle provider without trimming it.
+/// @param provider handle to the coarse memory provider
+/// @param retained_size amount of free memory kept in the provider
+///        (it is split evenly between the sub-heaps)
+/// @return UMF_RESULT_SUCCESS on success or appropriate error code on failure.
+umf_result_t umfCoarseMemoryProviderTrim(umf_memory_provider_handle_t provider,
+                                         size_t retained_size);
+
 /// @brief Create default params for the coarse memory provider
 static inline coarse_memory_provider_params_t
 umfCoarseMemoryProviderParamsDefault(void) {
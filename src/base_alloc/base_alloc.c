@@ -133,6 +133,13 @@ static void *ba_os_alloc_annotated(size_t pool_size) {
     return ptr;
 }
 
+static void ba_os_free_annotated(void *ptr, size_t pool_size) {
+    // the address range can be mapped again by anyone,
+    // so it must not stay marked as inaccessible
+    utils_annotate_memory_undefined(ptr, pool_size);
+    ba_os_free(ptr, pool_size);
+}
+
 umf_ba_pool_t *umf_ba_create(size_t size) {
     size_t chunk_size = ALIGN_UP(size, MEMORY_ALIGNMENT);
     size_t mutex_size = ALIGN_UP(utils_mutex_get_size(), MEMORY_ALIGNMENT);
@@ -174,7 +181,7 @@ umf_ba_pool_t *umf_ba_create(size_t size) {
     // init free_lock
     utils_mutex_t *mutex = utils_mutex_init(&pool->metadata.free_lock);
     if (!mutex) {
-        ba_os_free(pool, pool_size);
+        ba_os_free_annotated(pool, pool_size);
         return NULL;
     }
 
@@ -307,9 +314,9 @@ void umf_ba_destroy(umf_ba_pool_t *pool) {
     while (next_pool) {
         current_pool = next_pool;
         next_pool = next_pool->next_pool;
-        ba_os_free(current_pool, size);
+        ba_os_free_annotated(current_pool, size);
     }
 
     utils_mutex_destroy_not_free(&pool->metadata.free_lock);
-    ba_os_free(pool, size);
+    ba_os_free_annotated(pool, size);
 }
@@ -190,6 +190,10 @@ void umf_ba_global_free(void *ptr) {
     size_t total_size;
     ptr = get_original_alloc(ptr, &total_size, NULL);
 
+    // base_alloc expects the allocation to be undefined memory
+    // and the memory unmapped below must not stay marked as inaccessible
+    utils_annotate_memory_undefined(ptr, total_size);
+
     int ac_index = size_to_idx(total_size);
     if (ac_index >= NUM_ALLOCATION_CLASSES) {
         ba_os_free(ptr, total_size);
@@ -202,8 +206,6 @@ void umf_ba_global_free(void *ptr) {
         return;
     }
 
-    // base_alloc expects the allocation to be undefined memory
-    utils_annotate_memory_undefined(ptr, total_size);
     umf_ba_free(BASE_ALLOC.ac[ac_index], ptr);
 }
 
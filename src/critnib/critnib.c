@@ -52,6 +52,16 @@
  * free.  Any synchronization with reads would kill their speed, thus
  * instead we have a remove count.  The grace period is DELETED_LIFE,
  * after which any read will notice staleness and restart its work.
+ *
+ * After the grace period the memory of removed nodes is retired, and it is
+ * freed only when no reader can reach it any more (epoch-based reclamation).
+ * Every thread has its own reader record (a cache line that only it writes
+ * to), where a read announces the global epoch it started in and clears it
+ * when it ends -- a store and a fence, so reads never wait nor retry.
+ * The writers advance the global epoch (shared by all critnibs) once every
+ * read in progress has announced the current one, and the nodes retired
+ * two epochs before can be freed then.  The records are released when
+ * their threads exit and reused by new threads.
  */
 #include <errno.h>
 #include <stdbool.h>
@@ -60,6 +70,7 @@
 
 #include "base_alloc.h"
 #include "base_alloc_global.h"
+#include "base_alloc_internal.h"
 #include "critnib.h"
 #include "utils_assert.h"
 #include "utils_common.h"
@@ -69,9 +80,9 @@
  * A node that has been deleted is left untouched for this many delete
  * cycles.  Reads have guaranteed correctness if they took no longer than
  * DELETED_LIFE concurrent deletes, otherwise they notice something is
- * wrong and restart.  The memory of deleted nodes is never freed to
- * malloc nor their pointers lead anywhere wrong, thus a stale read will
- * (temporarily) get a wrong answer but won't crash.
+ * wrong and restart.  The memory of deleted nodes is not freed while
+ * any read can still reach it nor their pointers lead anywhere wrong,
+ * thus a stale read will (temporarily) get a wrong answer but won't crash.
  *
  * There's no need to count writes as they never interfere with reads.
  *
@@ -84,9 +95,22 @@
  */
 #define DELETED_LIFE 16
 
+/*
+ * Slices of critnib_new() are SLICE bits wide.
+ *
+ * Slices of critnib_new_wide() are WIDE_SLICE bits wide and they are aligned
+ * to WIDE_SLICE_BASE (the page boundary), so that the low bits of page-aligned
+ * keys (always zero) don't make any node sparse.  The lowest slice (below
+ * WIDE_SLICE_BASE % WIDE_SLICE) is narrower -- see slice_of().
+ */
 #define SLICE 4
-#define NIB ((1ULL << SLICE) - 1)
-#define SLNODES (1 << SLICE)
+#define WIDE_SLICE 8
+#define WIDE_SLICE_BASE 12
+
+#define CACHE_LINE_SIZE 64
+
+/* nodes are retired to one of RETIRED_LISTS lists, by the epoch */
+#define RETIRED_LISTS 3
 
 typedef uintptr_t word;
 typedef unsigned char sh_t;
@@ -97,7 +121,7 @@ struct critnib_node {
 	 * explicit nodes or collapsed links) -- ie, any subtree below has all
 	 * those bits set to this value.
 	 *
-	 * nib is a 4-bit slice that's an index into the node's children.
+	 * nib is a slice (bits wide) that's an index into the node's children.
 	 *
 	 * shift is the length (in bits) of the part of the key below this node.
 	 *
@@ -107,9 +131,10 @@ struct critnib_node {
 	 *              +-----+
 	 *               shift
 	 */
-    struct critnib_node *child[SLNODES];
     word path;
     sh_t shift;
+    sh_t bits;
+    struct critnib_node *child[]; /* 1 << bits children */
 };
 
 struct critnib_leaf {
@@ -117,22 +142,67 @@ struct critnib_leaf {
     void *value;
 };
 
+/* the reader record of a thread */
+struct critnib_reader {
+    /* the epoch the read in progress started in, 0 if there is none */
+    uint64_t epoch;
+    /* 1 if a thread owns the record */
+    uint64_t in_use;
+    /* the next record in Readers */
+    struct critnib_reader *next;
+    char padding[CACHE_LINE_SIZE - 2 * sizeof(uint64_t) -
+                 sizeof(struct critnib_reader *)];
+};
+
 struct critnib {
     struct critnib_node *root;
 
-    /* pool of freed nodes: singly linked list, next at child[0] */
-    struct critnib_node *deleted_node;
-    struct critnib_leaf *deleted_leaf;
+    /* width of slices and the width of the lowest one */
+    sh_t slice;
+    sh_t low_slice;
+
+    /* pool of nodes (NULL if they are allocated from the global allocator) */
+    umf_ba_pool_t *node_pool;
 
-    /* nodes removed but not yet eligible for reuse */
+    /*
+     * nodes retired in the epoch retired_epoch[i] (i == epoch % 3), waiting
+     * to be freed: singly linked lists, next at child[0] (nodes)
+     * or at value (leaves)
+     */
+    struct critnib_node *retired_nodes[RETIRED_LISTS];
+    struct critnib_leaf *retired_leaves[RETIRED_LISTS];
+    uint64_t retired_epoch[RETIRED_LISTS];
+
+    /* nodes removed but not yet retired */
     struct critnib_node *pending_del_nodes[DELETED_LIFE];
     struct critnib_leaf *pending_del_leaves[DELETED_LIFE];
 
     uint64_t remove_count;
 
+    /*
+     * number of completed removes and updates of values, incremented
+     * after the leaf is unlinked or the value is replaced
+     */
+    uint64_t change_count;
+
     struct utils_mutex_t mutex; /* writes/removes */
 };
 
+/* the global epoch of all critnibs (0 is never used) */
+static uint64_t Epoch = 1;
+
+/* all reader records (the list only grows) */
+static struct critnib_reader *Readers;
+
+/* the reader record of this thread */
+static __TLS struct critnib_reader *Reader;
+
+/*
+ * number of reads in progress of threads that could not get a record
+ * (out of memory) -- the epoch is not advanced while there are any
+ */
+static uint64_t Readers_without_record;
+
 /*
  * atomic load
  */
@@ -164,22 +234,181 @@ static inline struct critnib_leaf *to_leaf(struct critnib_node *n) {
 }
 
 /*
- * internal: path_mask -- return bit mask of a path above a subtree [shift]
- * bits tall
+ * internal: node_nib -- return the mask of the slice of a node
+ */
+static inline word node_nib(const struct critnib_node *n) {
+    return ((word)1 << n->bits) - 1;
+}
+
+/*
+ * internal: path_mask -- return bit mask of a path above a subtree of a node
  */
-static inline word path_mask(sh_t shift) { return ~NIB << shift; }
+static inline word path_mask(const struct critnib_node *n) {
+    return ~node_nib(n) << n->shift;
+}
 
 /*
  * internal: slice_index -- return index of child at the given nib
  */
-static inline unsigned slice_index(word key, sh_t shift) {
-    return (unsigned)((key >> shift) & NIB);
+static inline unsigned slice_index(word key, const struct critnib_node *n) {
+    return (unsigned)((key >> n->shift) & node_nib(n));
 }
 
 /*
- * critnib_new -- allocates a new critnib structure
+ * internal: slice_of -- set the shift and the width of the slice
+ * containing the given bit of a key
  */
-struct critnib *critnib_new(void) {
+static inline void slice_of(const struct critnib *c, unsigned bit,
+                            struct critnib_node *n) {
+    if (bit < c->low_slice) {
+        n->shift = 0;
+        n->bits = c->low_slice;
+    } else {
+        n->shift =
+            (sh_t)(c->low_slice + ((bit - c->low_slice) & ~(c->slice - 1U)));
+        n->bits = c->slice;
+    }
+}
+
+/*
+ * internal: reader_release -- release the reader record of an exiting thread
+ */
+static void reader_release(void *reader) {
+    if (Reader == reader) {
+        Reader = NULL;
+    }
+    utils_atomic_store_release(&((struct critnib_reader *)reader)->in_use, 0);
+}
+
+#ifdef _WIN32
+static DWORD Reader_key = FLS_OUT_OF_INDEXES;
+
+static VOID WINAPI reader_release_fls(PVOID reader) {
+    if (reader) {
+        reader_release(reader);
+    }
+}
+
+static void reader_key_create(void) {
+    Reader_key = FlsAlloc(reader_release_fls);
+}
+
+static void reader_key_set(struct critnib_reader *reader) {
+    if (Reader_key != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(Reader_key, reader);
+    }
+}
+#else  /* !_WIN32 */
+static pthread_key_t Reader_key;
+static bool Reader_key_created;
+
+static void reader_key_create(void) {
+    Reader_key_created = (pthread_key_create(&Reader_key, reader_release) == 0);
+}
+
+static void reader_key_set(struct critnib_reader *reader) {
+    if (Reader_key_created) {
+        pthread_setspecific(Reader_key, reader);
+    }
+}
+#endif /* !_WIN32 */
+
+static UTIL_ONCE_FLAG Reader_key_initialized = UTIL_ONCE_FLAG_INIT;
+
+/*
+ * internal: reader_acquire -- get a reader record for this thread, a free
+ * one or a new one (new records are allocated a page at a time)
+ *
+ * The records are never freed, so that a writer can walk the list at any
+ * time (even after the library is torn down and initialized again).
+ */
+static struct critnib_reader *reader_acquire(void) {
+    struct critnib_reader *reader;
+
+    load(&Readers, &reader);
+    for (; reader; reader = reader->next) {
+        uint64_t not_in_use = 0;
+        if (utils_compare_exchange(&reader->in_use, &not_in_use, 1)) {
+            goto acquired;
+        }
+    }
+
+    size_t page_size = ba_os_get_page_size();
+    struct critnib_reader *page = ba_os_alloc(page_size);
+    if (!page) {
+        return NULL;
+    }
+
+    size_t n = page_size / sizeof(struct critnib_reader);
+    for (size_t i = 0; i < n; i++) {
+        page[i].epoch = 0;
+        page[i].in_use = (i == 0);
+        page[i].next = &page[i + 1];
+    }
+
+    VALGRIND_HG_DRD_DISABLE_CHECKING(page, page_size);
+
+    struct critnib_reader *head;
+    load(&Readers, &head);
+    do {
+        page[n - 1].next = head;
+    } while (!utils_compare_exchange(&Readers, &head, page));
+
+    reader = &page[0];
+
+acquired:
+    utils_init_once(&Reader_key_initialized, reader_key_create);
+    reader_key_set(reader);
+    Reader = reader;
+    return reader;
+}
+
+/*
+ * internal: read_begin -- announce a read in the current epoch, returns
+ * the reader record to be passed to read_end()
+ *
+ * The fence makes the announcement visible to the writers before any node
+ * is loaded: a writer that does not see it yet could not have retired
+ * anything this read can reach.  An epoch that has just advanced is still
+ * safe to announce: it only holds back the writers until the read ends.
+ */
+static struct critnib_reader *read_begin(void) {
+    struct critnib_reader *reader = Reader;
+    if (!reader) {
+        reader = reader_acquire();
+    }
+
+    if (!reader) {
+        utils_atomic_increment(&Readers_without_record);
+        utils_atomic_fence();
+        return NULL;
+    }
+
+    uint64_t epoch;
+    load64(&Epoch, &epoch);
+    utils_atomic_store_release(&reader->epoch, epoch);
+    utils_atomic_fence();
+
+    return reader;
+}
+
+/*
+ * internal: read_end -- finish a read started by read_begin()
+ */
+static void read_end(struct critnib_reader *reader) {
+    if (reader) {
+        utils_atomic_store_release(&reader->epoch, 0);
+    } else {
+        utils_fetch_and_add64(&Readers_without_record, (uint64_t)-1);
+    }
+}
+
+/*
+ * internal: critnib_new_sliced -- allocates a new critnib structure
+ * with slices of the given width
+ */
+static struct critnib *critnib_new_sliced(sh_t slice, sh_t low_slice,
+                                          bool own_node_pool) {
     struct critnib *c = umf_ba_global_alloc(sizeof(struct critnib));
     if (!c) {
         return NULL;
@@ -187,20 +416,66 @@ struct critnib *critnib_new(void) {
 
     memset(c, 0, sizeof(struct critnib));
 
+    c->slice = slice;
+    c->low_slice = low_slice;
+
+    if (own_node_pool) {
+        c->node_pool =
+            umf_ba_create(sizeof(struct critnib_node) +
+                          ((size_t)1 << slice) * sizeof(struct critnib_node *));
+        if (!c->node_pool) {
+            goto err_free_critnib;
+        }
+    }
+
     void *mutex_ptr = utils_mutex_init(&c->mutex);
     if (!mutex_ptr) {
-        goto err_free_critnib;
+        goto err_destroy_node_pool;
     }
 
     VALGRIND_HG_DRD_DISABLE_CHECKING(&c->root, sizeof(c->root));
     VALGRIND_HG_DRD_DISABLE_CHECKING(&c->remove_count, sizeof(c->remove_count));
+    VALGRIND_HG_DRD_DISABLE_CHECKING(&c->change_count, sizeof(c->change_count));
 
     return c;
+err_destroy_node_pool:
+    if (c->node_pool) {
+        umf_ba_destroy(c->node_pool);
+    }
 err_free_critnib:
     umf_ba_global_free(c);
     return NULL;
 }
 
+/*
+ * critnib_new -- allocates a new critnib structure
+ */
+struct critnib *critnib_new(void) {
+    return critnib_new_sliced(SLICE, SLICE, false);
+}
+
+/*
+ * critnib_new_wide -- allocates a new critnib structure with wider
+ * (WIDE_SLICE) nodes, suited for many page-aligned keys
+ *
+ * Lookups take about half as many steps as in critnib_new(), but every node
+ * takes 2 kB, so it pays off only for big maps.
+ */
+struct critnib *critnib_new_wide(void) {
+    return critnib_new_sliced(WIDE_SLICE, WIDE_SLICE_BASE % WIDE_SLICE, true);
+}
+
+/*
+ * internal: free_node_memory -- free (to malloc) a node
+ */
+static void free_node_memory(struct critnib *c, struct critnib_node *n) {
+    if (c->node_pool) {
+        umf_ba_free(c->node_pool, n);
+    } else {
+        umf_ba_global_free(n);
+    }
+}
+
 /*
  * internal: delete_node -- recursively free (to malloc) a subtree
  */
@@ -208,14 +483,34 @@ static void delete_node(struct critnib *c, struct critnib_node *__restrict n) {
     if (is_leaf(n)) {
         umf_ba_global_free(to_leaf(n));
     } else {
-        for (int i = 0; i < SLNODES; i++) {
+        for (word i = 0; i <= node_nib(n); i++) {
             if (n->child[i]) {
                 delete_node(c, n->child[i]);
             }
         }
 
-        umf_ba_global_free(n);
+        free_node_memory(c, n);
+    }
+}
+
+/*
+ * internal: free_retired -- free (to malloc) the nodes of a retired list
+ */
+static void free_retired(struct critnib *c, unsigned list) {
+    for (struct critnib_node *m = c->retired_nodes[list]; m;) {
+        struct critnib_node *mm = m->child[0];
+        free_node_memory(c, m);
+        m = mm;
+    }
+
+    for (struct critnib_leaf *k = c->retired_leaves[list]; k;) {
+        struct critnib_leaf *kk = k->value;
+        umf_ba_global_free(k);
+        k = kk;
     }
+
+    c->retired_nodes[list] = NULL;
+    c->retired_leaves[list] = NULL;
 }
 
 /*
@@ -228,33 +523,101 @@ void critnib_delete(struct critnib *c) {
 
     utils_mutex_destroy_not_free(&c->mutex);
 
-    for (struct critnib_node *m = c->deleted_node; m;) {
-        struct critnib_node *mm = m->child[0];
-        umf_ba_global_free(m);
-        m = mm;
-    }
-
-    for (struct critnib_leaf *k = c->deleted_leaf; k;) {
-        struct critnib_leaf *kk = k->value;
-        umf_ba_global_free(k);
-        k = kk;
+    for (unsigned i = 0; i < RETIRED_LISTS; i++) {
+        free_retired(c, i);
     }
 
     for (int i = 0; i < DELETED_LIFE; i++) {
-        umf_ba_global_free(c->pending_del_nodes[i]);
+        if (c->pending_del_nodes[i]) {
+            free_node_memory(c, c->pending_del_nodes[i]);
+        }
         umf_ba_global_free(c->pending_del_leaves[i]);
     }
 
+    if (c->node_pool) {
+        umf_ba_destroy(c->node_pool);
+    }
+
     umf_ba_global_free(c);
 }
 
 /*
- * internal: free_node -- free (to internal pool, not malloc) a node.
+ * internal: reclaim -- advance the global epoch if all reads in progress
+ * started in the current one and free the nodes retired two epochs ago.
  *
- * We cannot free them to malloc as a stalled reader thread may still walk
- * through such nodes; it will notice the result being bogus but only after
- * completing the walk, thus we need to ensure any freed nodes still point
- * to within the critnib structure.
+ * Reads that started in an epoch (or before) might still walk through nodes
+ * retired in it.  The epoch advances twice only after all of them are
+ * finished, and later reads can't reach the nodes retired before.
+ */
+static void reclaim(struct critnib *c) {
+    bool retired = false;
+    for (unsigned i = 0; i < RETIRED_LISTS; i++) {
+        retired = retired || c->retired_nodes[i] || c->retired_leaves[i];
+    }
+    if (!retired) {
+        return;
+    }
+
+    uint64_t epoch;
+    load64(&Epoch, &epoch);
+
+    /* orders the loads of the records after the removals */
+    utils_atomic_fence();
+
+    uint64_t without_record;
+    load64(&Readers_without_record, &without_record);
+    bool can_advance = (without_record == 0);
+
+    struct critnib_reader *reader;
+    load(&Readers, &reader);
+    for (; reader && can_advance; reader = reader->next) {
+        uint64_t reader_epoch;
+        load64(&reader->epoch, &reader_epoch);
+        can_advance = (reader_epoch == 0 || reader_epoch == epoch);
+    }
+
+    if (can_advance) {
+        /* it fails if another writer has just advanced it */
+        uint64_t expected = epoch;
+        epoch = utils_compare_exchange(&Epoch, &expected, epoch + 1)
+                    ? epoch + 1
+                    : expected;
+    }
+
+    for (unsigned i = 0; i < RETIRED_LISTS; i++) {
+        if (c->retired_epoch[i] + 2 <= epoch) {
+            free_retired(c, i);
+        }
+    }
+}
+
+/*
+ * internal: retired_list -- return the retired list of the current epoch
+ *
+ * The list held nodes of an epoch at least RETIRED_LISTS epochs older,
+ * they are freed first.
+ */
+static unsigned retired_list(struct critnib *c) {
+    uint64_t epoch;
+    load64(&Epoch, &epoch);
+
+    unsigned list = (unsigned)(epoch % RETIRED_LISTS);
+    if (c->retired_epoch[list] != epoch) {
+        free_retired(c, list);
+        c->retired_epoch[list] = epoch;
+    }
+
+    return list;
+}
+
+/*
+ * internal: free_node -- retire a node, to be freed (to malloc) when
+ * no reader can reach it.
+ *
+ * We cannot free them to malloc immediately as a stalled reader thread may
+ * still walk through such nodes; it will notice the result being bogus but
+ * only after completing the walk, thus we need to ensure any freed nodes
+ * still point to within the critnib structure.
  */
 static void free_node(struct critnib *__restrict c,
                       struct critnib_node *__restrict n) {
@@ -263,28 +626,26 @@ static void free_node(struct critnib *__restrict c,
     }
 
     ASSERT(!is_leaf(n));
-    n->child[0] = c->deleted_node;
-    c->deleted_node = n;
+    unsigned list = retired_list(c);
+    n->child[0] = c->retired_nodes[list];
+    c->retired_nodes[list] = n;
 }
 
 /*
- * internal: alloc_node -- allocate a node from our pool or from malloc
+ * internal: alloc_node -- allocate a node from malloc
  */
 static struct critnib_node *alloc_node(struct critnib *__restrict c) {
-    if (!c->deleted_node) {
-        return umf_ba_global_alloc(sizeof(struct critnib_node));
+    if (c->node_pool) {
+        return umf_ba_alloc(c->node_pool);
     }
 
-    struct critnib_node *n = c->deleted_node;
-
-    c->deleted_node = n->child[0];
-    VALGRIND_ANNOTATE_NEW_MEMORY(n, sizeof(*n));
-
-    return n;
+    return umf_ba_global_alloc(sizeof(struct critnib_node) +
+                               ((size_t)1 << c->slice) *
+                                   sizeof(struct critnib_node *));
 }
 
 /*
- * internal: free_leaf -- free (to internal pool, not malloc) a leaf.
+ * internal: free_leaf -- retire a leaf.
  *
  * See free_node().
  */
@@ -294,24 +655,17 @@ static void free_leaf(struct critnib *__restrict c,
         return;
     }
 
-    k->value = c->deleted_leaf;
-    c->deleted_leaf = k;
+    unsigned list = retired_list(c);
+    k->value = c->retired_leaves[list];
+    c->retired_leaves[list] = k;
 }
 
 /*
- * internal: alloc_leaf -- allocate a leaf from our pool or from malloc
+ * internal: alloc_leaf -- allocate a leaf from malloc
  */
 static struct critnib_leaf *alloc_leaf(struct critnib *__restrict c) {
-    if (!c->deleted_leaf) {
-        return umf_ba_global_alloc(sizeof(struct critnib_leaf));
-    }
-
-    struct critnib_leaf *k = c->deleted_leaf;
-
-    c->deleted_leaf = k->value;
-    VALGRIND_ANNOTATE_NEW_MEMORY(k, sizeof(*k));
-
-    return k;
+    (void)c; // unused
+    return umf_ba_global_alloc(sizeof(struct critnib_leaf));
 }
 
 /*
@@ -327,6 +681,8 @@ static struct critnib_leaf *alloc_leaf(struct critnib *__restrict c) {
 int critnib_insert(struct critnib *c, word key, void *value, int update) {
     utils_mutex_lock(&c->mutex);
 
+    reclaim(c);
+
     struct critnib_leaf *k = alloc_leaf(c);
     if (!k) {
         utils_mutex_unlock(&c->mutex);
@@ -353,15 +709,15 @@ int critnib_insert(struct critnib *c, word key, void *value, int update) {
     struct critnib_node **parent = &c->root;
     struct critnib_node *prev = c->root;
 
-    while (n && !is_leaf(n) && (key & path_mask(n->shift)) == n->path) {
+    while (n && !is_leaf(n) && (key & path_mask(n)) == n->path) {
         prev = n;
-        parent = &n->child[slice_index(key, n->shift)];
+        parent = &n->child[slice_index(key, n)];
         n = *parent;
     }
 
     if (!n) {
         n = prev;
-        store(&n->child[slice_index(key, n->shift)], kn);
+        store(&n->child[slice_index(key, n)], kn);
 
         utils_mutex_unlock(&c->mutex);
 
@@ -373,10 +729,12 @@ int critnib_insert(struct critnib *c, word key, void *value, int update) {
     word at = path ^ key;
     if (!at) {
         ASSERT(is_leaf(n));
-        free_leaf(c, to_leaf(kn));
+        umf_ba_global_free(k);
 
         if (update) {
             to_leaf(n)->value = value;
+            /* the old value is gone, as if it was removed */
+            utils_atomic_increment(&c->change_count);
             utils_mutex_unlock(&c->mutex);
             return 0;
         } else {
@@ -385,27 +743,29 @@ int critnib_insert(struct critnib *c, word key, void *value, int update) {
         }
     }
 
-    /* and convert that to an index. */
-    sh_t sh = utils_mssb_index(at) & (sh_t) ~(SLICE - 1);
-
     struct critnib_node *m = alloc_node(c);
     if (!m) {
-        free_leaf(c, to_leaf(kn));
+        umf_ba_global_free(k);
 
         utils_mutex_unlock(&c->mutex);
 
         return ENOMEM;
     }
-    VALGRIND_HG_DRD_DISABLE_CHECKING(m, sizeof(struct critnib_node));
 
-    for (int i = 0; i < SLNODES; i++) {
+    /* and convert that to an index. */
+    slice_of(c, utils_mssb_index(at), m);
+
+    VALGRIND_HG_DRD_DISABLE_CHECKING(
+        m, sizeof(struct critnib_node) +
+               (node_nib(m) + 1) * sizeof(struct critnib_node *));
+
+    for (word i = 0; i <= node_nib(m); i++) {
         m->child[i] = NULL;
     }
 
-    m->child[slice_index(key, sh)] = kn;
-    m->child[slice_index(path, sh)] = n;
-    m->shift = sh;
-    m->path = key & path_mask(sh);
+    m->child[slice_index(key, m)] = kn;
+    m->child[slice_index(path, m)] = n;
+    m->path = key & path_mask(m);
     store(parent, m);
 
     utils_mutex_unlock(&c->mutex);
@@ -433,6 +793,8 @@ void *critnib_remove(struct critnib *c, word key) {
     c->pending_del_nodes[del] = NULL;
     c->pending_del_leaves[del] = NULL;
 
+    reclaim(c);
+
     if (is_leaf(n)) {
         k = to_leaf(n);
         if (k->key == key) {
@@ -453,7 +815,7 @@ void *critnib_remove(struct critnib *c, word key) {
     while (!is_leaf(kn)) {
         n_parent = k_parent;
         n = kn;
-        k_parent = &kn->child[slice_index(key, kn->shift)];
+        k_parent = &kn->child[slice_index(key, kn)];
         kn = *k_parent;
 
         if (!kn) {
@@ -466,11 +828,11 @@ void *critnib_remove(struct critnib *c, word key) {
         goto not_found;
     }
 
-    store(&n->child[slice_index(key, n->shift)], NULL);
+    store(&n->child[slice_index(key, n)], NULL);
 
     /* Remove the node if there's only one remaining child. */
     int ochild = -1;
-    for (int i = 0; i < SLNODES; i++) {
+    for (int i = 0; i <= (int)node_nib(n); i++) {
         if (n->child[i]) {
             if (ochild != -1) {
                 goto del_leaf;
@@ -488,6 +850,7 @@ void *critnib_remove(struct critnib *c, word key) {
 del_leaf:
     value = k->value;
     c->pending_del_leaves[del] = k;
+    utils_atomic_increment(&c->change_count);
 
 not_found:
     utils_mutex_unlock(&c->mutex);
@@ -508,6 +871,7 @@ void *critnib_get(struct critnib *c, word key) {
     uint64_t wrs1, wrs2;
     void *res;
 
+    struct critnib_reader *reader = read_begin();
     do {
         struct critnib_node *n;
 
@@ -520,7 +884,7 @@ void *critnib_get(struct critnib *c, word key) {
 		 * going wrong way if our path is missing, but that's ok...
 		 */
         while (n && !is_leaf(n)) {
-            load(&n->child[slice_index(key, n->shift)], &n);
+            load(&n->child[slice_index(key, n)], &n);
         }
 
         /* ... as we check it at the end. */
@@ -528,6 +892,7 @@ void *critnib_get(struct critnib *c, word key) {
         res = (n && k->key == key) ? k->value : NULL;
         load64(&c->remove_count, &wrs2);
     } while (wrs1 + DELETED_LIFE <= wrs2);
+    read_end(reader);
 
     return res;
 }
@@ -538,18 +903,20 @@ void *critnib_get(struct critnib *c, word key) {
 static struct critnib_leaf *
 find_predecessor(struct critnib_node *__restrict n) {
     while (1) {
-        int nib;
-        for (nib = NIB; nib >= 0; nib--) {
-            if (n->child[nib]) {
+        /* load every child once, a concurrent remove can clear it */
+        struct critnib_node *m = NULL;
+        for (int nib = (int)node_nib(n); nib >= 0; nib--) {
+            load(&n->child[nib], &m);
+            if (m) {
                 break;
             }
         }
 
-        if (nib < 0) {
+        if (!m) {
             return NULL;
         }
 
-        n = n->child[nib];
+        n = m;
         if (is_leaf(n)) {
             return to_leaf(n);
         }
@@ -577,7 +944,7 @@ static struct critnib_leaf *find_le(struct critnib_node *__restrict n,
 	 * that shift points at the nib's lower rather than upper edge, so it
 	 * needs to be masked away as well.
 	 */
-    if ((key ^ n->path) >> (n->shift) & ~NIB) {
+    if ((key ^ n->path) >> (n->shift) & ~node_nib(n)) {
         /*
 		 * subtree is too far to the left?
 		 * -> its rightmost value is good
@@ -593,7 +960,7 @@ static struct critnib_leaf *find_le(struct critnib_node *__restrict n,
         return NULL;
     }
 
-    unsigned nib = slice_index(key, n->shift);
+    unsigned nib = slice_index(key, n);
     /* recursive call: follow the path */
     {
         struct critnib_node *m;
@@ -634,6 +1001,7 @@ void *critnib_find_le(struct critnib *c, word key) {
     uint64_t wrs1, wrs2;
     void *res;
 
+    struct critnib_reader *reader = read_begin();
     do {
         load64(&c->remove_count, &wrs1);
         struct critnib_node *n; /* avoid a subtle TOCTOU */
@@ -642,6 +1010,7 @@ void *critnib_find_le(struct critnib *c, word key) {
         res = k ? k->value : NULL;
         load64(&c->remove_count, &wrs2);
     } while (wrs1 + DELETED_LIFE <= wrs2);
+    read_end(reader);
 
     return res;
 }
@@ -651,18 +1020,20 @@ void *critnib_find_le(struct critnib *c, word key) {
  */
 static struct critnib_leaf *find_successor(struct critnib_node *__restrict n) {
     while (1) {
-        unsigned nib;
-        for (nib = 0; nib <= NIB; nib++) {
-            if (n->child[nib]) {
+        /* see find_predecessor() */
+        struct critnib_node *m = NULL;
+        for (unsigned nib = 0; nib <= node_nib(n); nib++) {
+            load(&n->child[nib], &m);
+            if (m) {
                 break;
             }
         }
 
-        if (nib > NIB) {
+        if (!m) {
             return NULL;
         }
 
-        n = n->child[nib];
+        n = m;
         if (is_leaf(n)) {
             return to_leaf(n);
         }
@@ -683,7 +1054,7 @@ static struct critnib_leaf *find_ge(struct critnib_node *__restrict n,
         return (k->key >= key) ? k : NULL;
     }
 
-    if ((key ^ n->path) >> (n->shift) & ~NIB) {
+    if ((key ^ n->path) >> (n->shift) & ~node_nib(n)) {
         if (n->path > key) {
             return find_successor(n);
         }
@@ -691,7 +1062,7 @@ static struct critnib_leaf *find_ge(struct critnib_node *__restrict n,
         return NULL;
     }
 
-    unsigned nib = slice_index(key, n->shift);
+    unsigned nib = slice_index(key, n);
     {
         struct critnib_node *m;
         load(&n->child[nib], &m);
@@ -701,7 +1072,7 @@ static struct critnib_leaf *find_ge(struct critnib_node *__restrict n,
         }
     }
 
-    for (; nib < NIB; nib++) {
+    for (; nib < node_nib(n); nib++) {
         struct critnib_node *m;
         load(&n->child[nib + 1], &m);
         if (m) {
@@ -740,6 +1111,7 @@ int critnib_find(struct critnib *c, uintptr_t key, enum find_dir_t dir,
         key++;
     }
 
+    struct critnib_reader *reader = read_begin();
     do {
         load64(&c->remove_count, &wrs1);
         struct critnib_node *n;
@@ -751,7 +1123,7 @@ int critnib_find(struct critnib *c, uintptr_t key, enum find_dir_t dir,
             k = find_ge(n, key);
         } else {
             while (n && !is_leaf(n)) {
-                load(&n->child[slice_index(key, n->shift)], &n);
+                load(&n->child[slice_index(key, n)], &n);
             }
 
             struct critnib_leaf *kk = to_leaf(n);
@@ -763,6 +1135,7 @@ int critnib_find(struct critnib *c, uintptr_t key, enum find_dir_t dir,
         }
         load64(&c->remove_count, &wrs2);
     } while (wrs1 + DELETED_LIFE <= wrs2);
+    read_end(reader);
 
     if (k) {
         if (rkey) {
@@ -796,11 +1169,11 @@ static int iter(struct critnib_node *__restrict n, word min, word max,
     if (n->path > max) {
         return 1;
     }
-    if ((n->path | path_mask(n->shift)) < min) {
+    if ((n->path | path_mask(n)) < min) {
         return 0;
     }
 
-    for (int i = 0; i < SLNODES; i++) {
+    for (word i = 0; i <= node_nib(n); i++) {
         struct critnib_node *__restrict m = n->child[i];
         if (m && iter(m, min, max, func, privdata)) {
             return 1;
@@ -819,3 +1192,14 @@ void critnib_iter(critnib *c, uintptr_t min, uintptr_t max,
     }
     utils_mutex_unlock(&c->mutex);
 }
+
+/*
+ * critnib_change_count -- get the number of completed removes and updates
+ * of values; a value found after the count was read is still there as long
+ * as the count does not change
+ */
+uint64_t critnib_change_count(critnib *c) {
+    uint64_t change_count;
+    load64(&c->change_count, &change_count);
+    return change_count;
+}
@@ -28,6 +28,7 @@ enum find_dir_t {
 };
 
 critnib *critnib_new(void);
+critnib *critnib_new_wide(void);
 void critnib_delete(critnib *c);
 
 int critnib_insert(critnib *c, uintptr_t key, void *value, int update);
@@ -39,6 +40,7 @@ int critnib_find(critnib *c, uintptr_t key, enum find_dir_t dir,
 void critnib_iter(critnib *c, uintptr_t min, uintptr_t max,
                   int (*func)(uintptr_t key, void *value, void *privdata),
                   void *privdata);
+uint64_t critnib_change_count(critnib *c);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,29 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Under the Apache License v2.0 with LLVM Exceptions. See LICENSE.TXT.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#include "decay_clock.h"
+#include "utils_common.h"
+#include "utils_concurrency.h"
+
+// the time set by umf_decay_clock_set_ms() or -1 if the monotonic clock is used
+static int64_t Set_time_ms = -1;
+
+uint64_t umf_decay_clock_ms(void) {
+    int64_t time_ms;
+    utils_atomic_load_acquire(&Set_time_ms, &time_ms);
+    if (time_ms >= 0) {
+        return (uint64_t)time_ms;
+    }
+
+    return utils_get_time_ms();
+}
+
+void umf_decay_clock_set_ms(int64_t time_ms) {
+    utils_atomic_store_release(&Set_time_ms, time_ms < 0 ? -1 : time_ms);
+}
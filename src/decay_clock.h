@@ -0,0 +1,32 @@
+/*
+ *
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Under the Apache License v2.0 with LLVM Exceptions. See LICENSE.TXT.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ *
+ */
+
+#ifndef UMF_DECAY_CLOCK_H
+#define UMF_DECAY_CLOCK_H 1
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Get the time, in milliseconds, of the clock which ages the free memory
+// kept by the disjoint pools and the coarse providers before they give it
+// back. It is the monotonic clock unless a test has set the time.
+uint64_t umf_decay_clock_ms(void);
+
+// Set the time of the decay clock. A negative time returns to the monotonic
+// clock. Used by tests to run the decay without waiting on the wall clock.
+void umf_decay_clock_set_ms(int64_t time_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UMF_DECAY_CLOCK_H */
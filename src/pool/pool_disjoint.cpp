@@ -8,20 +8,27 @@
 #include <bitset>
 #include <cassert>
 #include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
 #include <iomanip>
 #include <limits>
-#include <list>
 #include <memory>
 #include <mutex>
-#include <shared_mutex>
 #include <string>
-#include <unordered_map>
+#include <thread>
 #include <utility>
 #include <vector>
 
 // TODO: replace with logger?
 #include <iostream>
 
+#include "base_alloc.h"
+#include "critnib/critnib.h"
+#include "decay_clock.h"
+#include "ravl/ravl.h"
+#include "memory_pool_internal.h"
 #include "provider/provider_tracking.h"
 
 #include "../cpp_helpers.hpp"
@@ -31,6 +38,10 @@
 #include "utils_math.h"
 #include "utils_sanitizers.h"
 
+#ifndef UMF_NO_HWLOC
+#include "topology.h"
+#endif
+
 // Temporary solution for disabling memory poisoning. This is needed because
 // AddressSanitizer does not support memory poisoning for GPU allocations.
 // More info: https://github.com/oneapi-src/unified-memory-framework/issues/634
@@ -72,6 +83,9 @@ class DisjointPool {
     umf_result_t free(void *ptr);
     umf_result_t get_last_allocation_error();
 
+    void getStats(umf_disjoint_pool_bucket_stats_t *Stats, size_t *NumBuckets);
+    void getLargeCacheStats(umf_disjoint_pool_large_cache_stats_t *Stats);
+
     DisjointPool();
     ~DisjointPool();
 
@@ -109,6 +123,16 @@ void umfDisjointPoolSharedLimitsDestroy(
 // go directly to the provider.
 static constexpr size_t CutOff = (size_t)1 << 31; // 2GB
 
+// Alignment of the slabs if the provider does not report its page size
+static constexpr size_t DefaultSlabAlignment = 4096;
+
+// Bucket lookup divides each doubling of the size into
+// 2^BucketLookupPrecision ranges and maps every range to the first bucket
+// that can hold its smallest size (see sizeToIdx()).
+static constexpr size_t BucketLookupPrecision = 4;
+static constexpr size_t MaxSizeClassesPerDoubling = (size_t)1
+                                                    << BucketLookupPrecision;
+
 // Aligns the pointer down to the specified alignment
 // (e.g. returns 8 for Size = 13, Alignment = 8)
 static void *AlignPtrDown(void *Ptr, const size_t Alignment) {
@@ -139,21 +163,131 @@ typedef struct MemoryProviderError {
 } MemoryProviderError_t;
 
 class Bucket;
+class Slab;
+
+// A chunk kept in a thread-local cache together with the slab it belongs to,
+// so that it can be given back to its bucket without a slab map lookup.
+struct CachedChunk {
+    void *Ptr;
+    Slab *ChunkSlab;
+    // The chunk was never used since its slab came from the provider
+    bool Fresh;
+};
+
+// Free chunks cached by one thread for one pool, one list per bucket.
+// The lists are accessed only by the owning thread. Pool is set to nullptr
+// (under ThreadCacheRegistryLock) when the pool is destroyed, after the
+// cached chunks were returned to their buckets.
+struct ThreadCache {
+    std::atomic<DisjointPool::AllocImpl *> Pool;
+    std::vector<std::vector<CachedChunk>> Buckets;
+
+    // Counters of the allocations and frees served by the cache, one per
+    // bucket. Written only by the owning thread, read by
+    // umfDisjointPoolGetStats() under ThreadCacheRegistryLock.
+    struct Counters {
+        std::atomic<size_t> AllocCount{0};
+        std::atomic<size_t> AllocPoolCount{0};
+        std::atomic<size_t> FreeCount{0};
+    };
+    std::unique_ptr<Counters[]> Stats;
+};
+
+// Increment a counter that has a single writer
+static inline void incrementCounter(std::atomic<size_t> &Counter) {
+    Counter.store(Counter.load(std::memory_order_relaxed) + 1,
+                  std::memory_order_relaxed);
+}
+
+// Return an address unique to the calling thread while it runs
+static inline const void *threadToken() {
+    static thread_local char Token;
+    return &Token;
+}
+
+// The clock of the decay, shared with the coarse provider
+// (see umf_decay_clock_ms()).
+struct DecayClock {
+    using duration = std::chrono::steady_clock::duration;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<DecayClock>;
+    static constexpr bool is_steady = true;
+
+    static time_point now() {
+        return time_point(std::chrono::milliseconds(umf_decay_clock_ms()));
+    }
+};
+
+// Links of a slab on a SlabList
+struct SlabLinks {
+    Slab *Prev = nullptr;
+    Slab *Next = nullptr;
+};
 
-// Represents the allocated memory block of size 'SlabMinSize'
+// Header of a slab record, followed by the Slab object. Records of destroyed
+// slabs are kept by the pool for new slabs and go back to the base allocator
+// only when the pool is destroyed, so the header of any slab found in the
+// slab map can be read even if the slab is being destroyed concurrently.
+// Its bounds are then guarded by a sequence number, like a seqlock.
+struct SlabRecordHeader {
+    // Odd from the start of the destruction of the slab in the record
+    // until the next slab in the record is registered
+    std::atomic<uint64_t> Seq{1};
+
+    // Bounds of the slab, valid while Seq is even
+    std::atomic<uintptr_t> Start{0};
+    std::atomic<size_t> Size{0};
+
+    // Next unused record, while the record is not used by a slab
+    SlabRecordHeader *NextFree = nullptr;
+
+    // Return true if Addr lies inside the slab in the record. May return
+    // false while the slab is being destroyed or the record reused.
+    bool contains(uintptr_t Addr) const {
+        uint64_t Seq1 = Seq.load(std::memory_order_acquire);
+        uintptr_t SlabStart = Start.load(std::memory_order_relaxed);
+        size_t SlabSize = Size.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t Seq2 = Seq.load(std::memory_order_relaxed);
+
+        return Seq1 == Seq2 && !(Seq1 & 1) && Addr >= SlabStart &&
+               Addr - SlabStart < SlabSize;
+    }
+};
+
+// Represents the allocated memory block of at least 'SlabMinSize' bytes
 // Internally, it splits the memory block into chunks. The number of
-// chunks depends of the size of a Bucket which created the Slab.
+// chunks depends of the size of a Bucket which created the Slab and of the
+// size of the slab, which may grow with the bucket's demand
+// (see Bucket::nextSlabSize()).
 // Note: Bucket's methods are responsible for thread safety of Slab access,
 // so no locking happens here.
+// The Slab object and its bitmap are stored in a single fixed-size record
+// allocated from the pool's base allocator (see Bucket::createSlab()),
+// right after a SlabRecordHeader.
 class Slab {
 
-    // Pointer to the allocated memory of SlabMinSize bytes
+    // Pointer to the allocated memory of SlabSize bytes
     void *MemPtr;
 
-    // Represents the current state of each chunk:
-    // if the bit is set then the chunk is allocated
-    // the chunk is free for allocation otherwise
-    std::vector<bool> Chunks;
+    size_t SlabSize;
+
+    // Number of chunks in the slab
+    size_t NumChunks;
+
+    // Number of 64-bit words needed to hold one bit per chunk
+    size_t NumWords;
+
+    // Represents the current state of each chunk, packed into NumWords
+    // 64-bit words: if the bit is set then the chunk is allocated
+    // the chunk is free for allocation otherwise. Bits past the last chunk
+    // are always set.
+    // The chunk words are followed by a summary level with one bit per chunk
+    // word, set if the word has no free chunk. Finding a free chunk thus
+    // takes a bit scan of a summary word and a bit scan of a chunk word.
+    // The bitmap is stored right after the Slab object in its record.
+    uint64_t *Bitmap;
 
     // Total number of allocated chunks at the moment.
     size_t NumAllocated = 0;
@@ -161,44 +295,85 @@ class Slab {
     // The bucket which the slab belongs to
     Bucket &bucket;
 
-    using ListIter = std::list<std::unique_ptr<Slab>>::iterator;
+    // Hints where to start search for free chunk in a slab: all chunk words
+    // before this one are full
+    size_t FirstFreeWordIdx = 0;
+
+    // Chunks at this index and above were never handed out since the slab
+    // memory came from the provider. Chunks are always handed out lowest
+    // index first, so this is enough to tell which chunks are untouched.
+    size_t FirstFreshChunkIdx = 0;
+
+    // When the slab was put in the pool, valid while it is pooled
+    DecayClock::time_point PooledSince;
 
-    // Store iterator to the corresponding node in avail/unavail list
-    // to achieve O(1) removal
-    ListIter SlabListIter;
+    // How far the memory of the pooled slab was purged
+    enum class PurgeState { None, Lazy, Force } Purged = PurgeState::None;
 
-    // Hints where to start search for free chunk in a slab
-    size_t FirstFreeChunkIdx = 0;
+    uint64_t *getSummary() const { return Bitmap + NumWords; }
+    size_t getNumSummaryWords() const { return (NumWords + 63) / 64; }
+
+    static size_t getNumWords(size_t NumChunks) {
+        return (NumChunks + 63) / 64;
+    }
 
     // Return the index of the first available chunk, SIZE_MAX otherwise
     size_t FindFirstAvailableChunkIdx() const;
 
-    // Register/Unregister the slab in the global slab address map.
-    void regSlab(Slab &);
-    void unregSlab(Slab &);
-    static void regSlabByAddr(void *, Slab &);
-    static void unregSlabByAddr(void *, Slab &);
+    // Register/Unregister the slab in the pool's slab address map.
+    void regSlab();
+    void unregSlab();
 
   public:
-    Slab(Bucket &);
+    // Must be constructed in a record of at least getRecordSize() bytes.
+    Slab(Bucket &, size_t SlabSize);
     ~Slab();
 
-    void setIterator(ListIter It) { SlabListIter = It; }
-    ListIter getIterator() const { return SlabListIter; }
+    // Links of the avail/unavail list the slab is on, for O(1) removal
+    SlabLinks ListLinks;
+
+    // Links of the bucket's list of pooled slabs
+    SlabLinks PooledLinks;
+
+    // Chunks freed by threads other than the owner, linked through their
+    // first word. The lowest bit is set while the slab is on the bucket's
+    // list of slabs with remote frees.
+    std::atomic<uintptr_t> RemoteFrees{0};
+
+    // Next slab on the bucket's list of slabs with remote frees
+    Slab *RemoteNext = nullptr;
+
+    // The thread which last took a chunk from the slab (see threadToken())
+    std::atomic<const void *> Owner{nullptr};
+
+    // Size of the record holding a slab of NumChunks chunks.
+    static size_t getRecordSize(size_t NumChunks) {
+        size_t NumWords = getNumWords(NumChunks);
+        return sizeof(SlabRecordHeader) + sizeof(Slab) +
+               (NumWords + (NumWords + 63) / 64) * sizeof(uint64_t);
+    }
+
+    // The header of the record holding the slab.
+    SlabRecordHeader *getRecordHeader() const {
+        auto *Self = const_cast<Slab *>(this);
+        return reinterpret_cast<SlabRecordHeader *>(Self) - 1;
+    }
 
     size_t getNumAllocated() const { return NumAllocated; }
 
     // Get pointer to allocation that is one piece of this slab.
-    void *getChunk();
+    // Fresh is set if the chunk was never used before.
+    void *getChunk(bool &Fresh);
 
     // Get pointer to allocation that is this entire slab.
     void *getSlab();
 
     void *getPtr() const { return MemPtr; }
     void *getEnd() const;
+    size_t getSize() const { return SlabSize; }
 
     size_t getChunkSize() const;
-    size_t getNumChunks() const { return Chunks.size(); }
+    size_t getNumChunks() const { return NumChunks; }
 
     bool hasAvail();
 
@@ -206,20 +381,91 @@ class Slab {
     const Bucket &getBucket() const;
 
     void freeChunk(void *Ptr);
+
+    // Return the start of the chunk containing Ptr.
+    void *getChunkStart(void *Ptr) const;
+
+    // Note that the slab was put in the pool at time Now.
+    void setPooled(DecayClock::time_point Now) {
+        PooledSince = Now;
+        Purged = PurgeState::None;
+    }
+
+    DecayClock::time_point getPooledSince() const { return PooledSince; }
+
+    // Purge the memory of the pooled slab, return the number of bytes
+    // purged for the first time.
+    size_t purge(bool Force);
+};
+
+// Intrusive doubly-linked list of slabs, linked through the Links member.
+// Does not own the slabs.
+template <SlabLinks Slab::*Links> class SlabList {
+    Slab *Head = nullptr;
+    Slab *Tail = nullptr;
+    size_t Size = 0;
+
+  public:
+    bool empty() const { return Head == nullptr; }
+    size_t size() const { return Size; }
+    Slab *front() const { return Head; }
+    Slab *back() const { return Tail; }
+
+    void pushFront(Slab &S) {
+        auto &L = S.*Links;
+        assert(!L.Prev && !L.Next && Head != &S && "Slab is already on a list");
+        L.Next = Head;
+        if (Head) {
+            (Head->*Links).Prev = &S;
+        } else {
+            Tail = &S;
+        }
+        Head = &S;
+        Size++;
+    }
+
+    void remove(Slab &S) {
+        auto &L = S.*Links;
+        if (L.Prev) {
+            (L.Prev->*Links).Next = L.Next;
+        } else {
+            assert(Head == &S && "Slab is not on this list");
+            Head = L.Next;
+        }
+        if (L.Next) {
+            (L.Next->*Links).Prev = L.Prev;
+        } else {
+            Tail = L.Prev;
+        }
+        L.Prev = L.Next = nullptr;
+        Size--;
+    }
 };
 
 class Bucket {
     const size_t Size;
 
+    // Index of the bucket in AllocImpl::Buckets and its NUMA shard
+    const size_t Idx;
+    const size_t Shard;
+
     // List of slabs which have at least 1 available chunk.
-    std::list<std::unique_ptr<Slab>> AvailableSlabs;
+    SlabList<&Slab::ListLinks> AvailableSlabs;
 
     // List of slabs with 0 available chunk.
-    std::list<std::unique_ptr<Slab>> UnavailableSlabs;
+    SlabList<&Slab::ListLinks> UnavailableSlabs;
+
+    // Slabs in the pool, most recently pooled first. They are also on
+    // AvailableSlabs.
+    SlabList<&Slab::PooledLinks> PooledSlabs;
 
     // Protects the bucket and all the corresponding slabs
     std::mutex BucketLock;
 
+    // Slabs with chunks freed by threads other than their owner. Pushed
+    // without the lock, drained under the lock by the next allocation.
+    std::atomic<Slab *> RemoteSlabs{nullptr};
+
     // Reference to the allocator context, used access memory allocation
     // routines, slab map and etc.
     DisjointPool::AllocImpl &OwnAllocCtx;
@@ -243,27 +489,40 @@ class Bucket {
     // if a slab in this bucket is already pooled.
     size_t chunkedSlabsInPool;
 
-    // Statistics
-    size_t allocPoolCount;
-    size_t freeCount;
-    size_t currSlabsInUse;
-    size_t currSlabsInPool;
-    size_t maxSlabsInPool;
+    // Statistics, read without the lock by umfDisjointPoolGetStats().
+    // The allocation and free counts are updated with relaxed atomic
+    // increments, the others only under BucketLock.
+    std::atomic<size_t> allocCount;
+    std::atomic<size_t> allocPoolCount;
+    std::atomic<size_t> freeCount;
+    std::atomic<size_t> currSlabsInUse;
+    std::atomic<size_t> maxSlabsInUse;
+    std::atomic<size_t> currSlabsInPool;
+    std::atomic<size_t> maxSlabsInPool;
+    std::atomic<size_t> purgedBytes;
+
+    // Size of the last slab created, starts at SlabAllocSize()
+    std::atomic<size_t> lastSlabSize;
 
   public:
-    // Statistics
-    size_t allocCount;
-    size_t maxSlabsInUse;
+    Bucket(size_t Sz, DisjointPool::AllocImpl &AllocCtx, size_t Index,
+           size_t ShardIdx)
+        : Size{Sz}, Idx{Index}, Shard{ShardIdx}, OwnAllocCtx{AllocCtx},
+          chunkedSlabsInPool(0),
+          allocCount(0), allocPoolCount(0), freeCount(0), currSlabsInUse(0),
+          maxSlabsInUse(0), currSlabsInPool(0), maxSlabsInPool(0),
+          purgedBytes(0), lastSlabSize(SlabAllocSize()) {}
 
-    Bucket(size_t Sz, DisjointPool::AllocImpl &AllocCtx)
-        : Size{Sz}, OwnAllocCtx{AllocCtx}, chunkedSlabsInPool(0),
-          allocPoolCount(0), freeCount(0), currSlabsInUse(0),
-          currSlabsInPool(0), maxSlabsInPool(0), allocCount(0),
-          maxSlabsInUse(0) {}
+    ~Bucket();
 
     // Get pointer to allocation that is one piece of an available slab in this
-    // bucket.
-    void *getChunk(bool &FromPool);
+    // bucket. Fresh is set if the chunk was never used before.
+    void *getChunk(bool &FromPool, bool &Fresh);
+
+    // Get up to Count chunks (at least one) from this bucket under a single
+    // lock acquisition and append them to Chunks.
+    void getChunks(std::vector<CachedChunk> &Chunks, size_t Count,
+                   bool &FromPool);
 
     // Get pointer to allocation that is a full slab in this bucket.
     void *getSlab(bool &FromPool);
@@ -271,18 +530,40 @@ class Bucket {
     // Return the allocation size of this bucket.
     size_t getSize() const { return Size; }
 
+    size_t getIdx() const { return Idx; }
+    size_t getShard() const { return Shard; }
+
     // Free an allocation that is one piece of a slab in this bucket.
     void freeChunk(void *Ptr, Slab &Slab, bool &ToPool);
 
+    // Free Count chunks of this bucket under a single lock acquisition.
+    void freeChunks(const CachedChunk *Chunks, size_t Count, bool &ToPool);
+
+    // Free an allocation of a slab owned by another thread without taking
+    // the lock. The chunk is put back into the slab by the next allocation
+    // from this bucket. The bucket size must be a multiple of
+    // alignof(uintptr_t).
+    void freeRemoteChunk(void *Ptr, Slab &Slab);
+
     // Free an allocation that is a full slab in this bucket.
     void freeSlab(Slab &Slab, bool &ToPool);
 
+    // Purge the pooled slabs idle for at least Age, purge them harder after
+    // 2 * Age and return them to the provider after 3 * Age.
+    void decay(DecayClock::time_point Now, DecayClock::duration Age);
+
+    // Fill Stats with a snapshot of the bucket's counters.
+    void getStats(umf_disjoint_pool_bucket_stats_t &Stats);
+
+    // Add the counters of a thread cache that goes away.
+    void addCounters(const ThreadCache::Counters &Counters);
+
     umf_memory_provider_handle_t getMemHandle();
 
     DisjointPool::AllocImpl &getAllocCtx() { return OwnAllocCtx; }
 
-    // Check whether an allocation to be freed can be placed in the pool.
-    bool CanPool(bool &ToPool);
+    // Check whether an empty slab can be placed in the pool.
+    bool CanPool(Slab &Slab, bool &ToPool);
 
     // The minimum allocation size for any slab.
     size_t SlabMinSize();
@@ -290,6 +571,11 @@ class Bucket {
     // The allocation size for a slab in this bucket.
     size_t SlabAllocSize();
 
+    // The size of the next slab created by this bucket. For buckets used in
+    // chunked mode it doubles with every doubling of the slabs in use, up
+    // to SlabMaxSize. The lock must be acquired before calling this method.
+    size_t nextSlabSize();
+
     // The minimum size of a chunk from this bucket's slabs.
     size_t ChunkCutOff();
 
@@ -305,37 +591,68 @@ class Bucket {
     // Update free count
     void countFree();
 
-    // Update statistics of Available/Unavailable
-    void updateStats(int InUse, int InPool);
-
-    // Print bucket statistics
-    void printStats(bool &TitlePrinted, const std::string &Label);
+    // Update statistics of Available/Unavailable of a slab of SlabSize bytes
+    void updateStats(int InUse, int InPool, size_t SlabSize);
 
   private:
     void onFreeChunk(Slab &, bool &ToPool);
 
+    // Put the chunks freed by other threads back into their slabs.
+    // The lock must be acquired before calling this method.
+    void drainRemoteFrees();
+
+    // Put an empty slab, already on AvailableSlabs, in the pool.
+    void addToPool(Slab &Slab);
+
     // Update statistics of pool usage, and indicate that an allocation was made
-    // from the pool.
-    void decrementPool(bool &FromPool);
+    // from the pooled slab.
+    void decrementPool(Slab &Slab, bool &FromPool);
 
     // Get a slab to be used for chunked allocations.
-    decltype(AvailableSlabs.begin()) getAvailSlab(bool &FromPool);
+    Slab *getAvailSlab(bool &FromPool);
 
     // Get a slab that will be used as a whole for a single allocation.
-    decltype(AvailableSlabs.begin()) getAvailFullSlab(bool &FromPool);
+    Slab *getAvailFullSlab(bool &FromPool);
+
+    // Create a new slab in a record from the pool's base allocator.
+    Slab &createSlab();
+
+    // Destroy the slab and return its record to the base allocator.
+    void destroySlab(Slab &Slab);
 };
 
 class DisjointPool::AllocImpl {
-    // It's important for the map to be destroyed last after buckets and their
-    // slabs This is because slab's destructor removes the object from the map.
-    std::unordered_multimap<void *, Slab &> KnownSlabs;
-    std::shared_timed_mutex KnownSlabsMapLock;
+    // Maps the start address of each slab to the Slab object. Lookups are
+    // lock-free. It's important for the map to be destroyed last after
+    // buckets and their slabs. This is because slab's destructor removes
+    // the object from the map.
+    critnib *KnownSlabs;
+
+    // The size of the largest slab this pool can create
+    size_t MaxSlabSize;
+
+    // The number of chunks a slab record has room for
+    size_t MaxSlabChunks;
+
+    // Base allocator of fixed-size slab records, each large enough for the
+    // slab with the most chunks. Destroyed after all the slabs.
+    umf_ba_pool_t *SlabRecords;
+
+    // Records of destroyed slabs, kept for new slabs (see SlabRecordHeader)
+    SlabRecordHeader *FreeSlabRecords = nullptr;
+    std::mutex FreeSlabRecordsLock;
 
     // Handle to the memory provider
     umf_memory_provider_handle_t MemHandle;
 
     // Store as unique_ptrs since Bucket is not Movable(because of std::mutex)
+    // NumShards sets of NumBucketSizes buckets, shard by shard.
     std::vector<std::unique_ptr<Bucket>> Buckets;
+    size_t NumBucketSizes = 0;
+
+    // Number of NUMA shards and the shard of each CPU, by OS index
+    size_t NumShards = 1;
+    std::vector<size_t> CpuToShard;
 
     // Configuration for this instance
     umf_disjoint_pool_params_t params;
@@ -343,55 +660,184 @@ class DisjointPool::AllocImpl {
     umf_disjoint_pool_shared_limits_t DefaultSharedLimits = {
         (std::numeric_limits<size_t>::max)(), 0};
 
-    // Used in algorithm for finding buckets
-    std::size_t MinBucketSizeExp;
+    // Maps the lookup key of a size (see sizeToIdx()) to the index of the
+    // first bucket that can hold the smallest size with that key.
+    std::vector<size_t> BucketLookup;
 
     // Coarse-grain allocation min alignment
     size_t ProviderMinPageSize;
 
+    // Alignment of the slabs, a power of 2. Slabs are allocated with this
+    // alignment if the provider does not report its page size.
+    size_t SlabAlignment;
+    std::atomic<bool> SlabsAligned{true};
+
+    // For each power of 2 alignment up to SlabAlignment (by its log2) and
+    // each bucket size index, the index of the first bucket not smaller
+    // whose chunks are aligned by construction.
+    std::vector<std::vector<size_t>> AlignedBucketLookup;
+
+    // Thread-local caches created for this pool.
+    // Protected by ThreadCacheRegistryLock().
+    std::vector<ThreadCache *> ThreadCaches;
+
+    // Time (DecayClock ticks) of the next decay pass driven by
+    // allocations and frees
+    std::atomic<DecayClock::rep> NextDecay{0};
+
+    // Freed allocations larger than MaxPoolableSize kept for reuse, if
+    // LargeCacheSize is set. The records come from LargeExtentRecords and
+    // are indexed by size in LargeCache and linked from the least to the
+    // most recently freed. Protected by LargeCacheLock.
+    struct LargeExtent {
+        void *Ptr;
+        size_t Size;
+        DecayClock::time_point FreedAt;
+        LargeExtent *Prev;
+        LargeExtent *Next;
+    };
+    umf_ba_pool_t *LargeExtentRecords = nullptr;
+    struct ravl *LargeCache = nullptr;
+    LargeExtent *OldestLargeExtent = nullptr;
+    LargeExtent *NewestLargeExtent = nullptr;
+    std::mutex LargeCacheLock;
+    umf_disjoint_pool_large_cache_stats_t LargeCacheStats = {};
+
+    // Background thread aging the pooled slabs, if enabled
+    std::thread DecayThread;
+    std::mutex DecayLock;
+    std::condition_variable DecayCond;
+    bool DecayStop = false;
+
   public:
     AllocImpl(umf_memory_provider_handle_t hProvider,
               umf_disjoint_pool_params_t *params)
         : MemHandle{hProvider}, params(*params) {
 
+        createShards();
+        createBuckets();
+        createBucketLookup();
+
         VALGRIND_DO_CREATE_MEMPOOL(this, 0, 0);
 
-        // Generate buckets sized such as: 64, 96, 128, 192, ..., CutOff.
-        // Powers of 2 and the value halfway between the powers of 2.
-        auto Size1 = this->params.MinBucketSize;
-        // MinBucketSize cannot be larger than CutOff.
-        Size1 = std::min(Size1, CutOff);
-        // Buckets sized smaller than the bucket default size- 8 aren't needed.
-        Size1 = std::max(Size1, UMF_DISJOINT_POOL_MIN_BUCKET_DEFAULT_SIZE);
-        // Calculate the exponent for MinBucketSize used for finding buckets.
-        MinBucketSizeExp = (size_t)log2Utils(Size1);
-        auto Size2 = Size1 + Size1 / 2;
-        for (; Size2 < CutOff; Size1 *= 2, Size2 *= 2) {
-            Buckets.push_back(std::make_unique<Bucket>(Size1, *this));
-            Buckets.push_back(std::make_unique<Bucket>(Size2, *this));
+        MaxSlabSize = this->params.SlabMinSize;
+        if (this->params.MaxPoolableSize) {
+            auto &Largest =
+                findBucket(std::min(this->params.MaxPoolableSize, CutOff), 0);
+            MaxSlabSize = std::max(MaxSlabSize, Largest.SlabAllocSize());
         }
-        Buckets.push_back(std::make_unique<Bucket>(CutOff, *this));
+        // Slabs of buckets used in chunked mode may grow up to SlabMaxSize.
+        MaxSlabSize = std::max(MaxSlabSize, this->params.SlabMaxSize);
 
         auto ret = umfMemoryProviderGetMinPageSize(hProvider, nullptr,
                                                    &ProviderMinPageSize);
         if (ret != UMF_RESULT_SUCCESS) {
             ProviderMinPageSize = 0;
         }
+
+        SlabAlignment = ProviderMinPageSize
+                            ? ProviderMinPageSize & (~ProviderMinPageSize + 1)
+                            : DefaultSlabAlignment;
+        createAlignedBucketLookup();
+
+        // The smallest bucket has the most chunks per slab of SlabMinSize.
+        // Larger slabs of the other buckets may hold as many chunks. Slabs
+        // used for a single allocation count as one chunk.
+        MaxSlabChunks = std::max<size_t>(
+            this->params.SlabMinSize / Buckets.front()->getSize(), 1);
+        SlabRecords = umf_ba_create(Slab::getRecordSize(MaxSlabChunks));
+        if (!SlabRecords) {
+            throw MemoryProviderError{UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY};
+        }
+
+        KnownSlabs = critnib_new();
+        if (!KnownSlabs) {
+            umf_ba_destroy(SlabRecords);
+            throw MemoryProviderError{UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY};
+        }
+
+        if (this->params.LargeCacheSize && !createLargeCache()) {
+            critnib_delete(KnownSlabs);
+            umf_ba_destroy(SlabRecords);
+            throw MemoryProviderError{UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY};
+        }
+
+        if (this->params.DecayMs && this->params.DecayBackgroundThread) {
+            try {
+                DecayThread = std::thread([this] { decayThread(); });
+            } catch (std::system_error &) {
+                destroyLargeCache();
+                critnib_delete(KnownSlabs);
+                umf_ba_destroy(SlabRecords);
+                throw MemoryProviderError{UMF_RESULT_ERROR_UNKNOWN};
+            }
+        }
     }
 
-    ~AllocImpl() { VALGRIND_DO_DESTROY_MEMPOOL(this); }
+    ~AllocImpl() {
+        if (DecayThread.joinable()) {
+            {
+                std::lock_guard<std::mutex> Lg(DecayLock);
+                DecayStop = true;
+            }
+            DecayCond.notify_one();
+            DecayThread.join();
+        }
+
+        detachThreadCaches();
+
+        destroyLargeCache();
+
+        // Destroy the slabs while the map is still alive.
+        Buckets.clear();
+        critnib_delete(KnownSlabs);
+        while (FreeSlabRecords) {
+            auto *Record = FreeSlabRecords;
+            FreeSlabRecords = Record->NextFree;
+            umf_ba_free(SlabRecords, Record);
+        }
+        umf_ba_destroy(SlabRecords);
+
+        VALGRIND_DO_DESTROY_MEMPOOL(this);
+    }
 
     void *allocate(size_t Size, size_t Alignment, bool &FromPool);
-    void *allocate(size_t Size, bool &FromPool);
+    // If Zeroed is given, it is set when the returned memory is known
+    // to be zero-filled.
+    void *allocate(size_t Size, bool &FromPool, bool *Zeroed = nullptr);
+    void *reallocate(void *Ptr, size_t Size);
     void deallocate(void *Ptr, bool &ToPool);
 
+    // Return the number of bytes usable at Ptr, 0 if Ptr was not allocated
+    // from this pool.
+    size_t getUsableSize(void *Ptr);
+
     umf_memory_provider_handle_t getMemHandle() { return MemHandle; }
 
-    std::shared_timed_mutex &getKnownSlabsMapLock() {
-        return KnownSlabsMapLock;
+    // Get a record for a new slab, nullptr if out of memory.
+    SlabRecordHeader *getSlabRecord();
+
+    // Keep the record of a destroyed slab for a new slab.
+    void putSlabRecord(SlabRecordHeader *Record);
+
+    critnib *getKnownSlabs() { return KnownSlabs; }
+    size_t getMaxSlabChunks() { return MaxSlabChunks; }
+
+    // Alignment to request for new slabs, 0 if the provider's page size
+    // already guarantees SlabAlignment.
+    size_t getSlabAllocAlignment() {
+        if (ProviderMinPageSize ||
+            !SlabsAligned.load(std::memory_order_relaxed)) {
+            return 0;
+        }
+        return SlabAlignment;
     }
-    std::unordered_multimap<void *, Slab &> &getKnownSlabs() {
-        return KnownSlabs;
+
+    void setSlabsUnaligned() {
+        if (SlabsAligned.exchange(false, std::memory_order_relaxed)) {
+            LOG_WARN("DisjointPool: slabs are not aligned to %zu bytes",
+                     SlabAlignment);
+        }
     }
 
     size_t SlabMinSize() { return params.SlabMinSize; };
@@ -409,11 +855,226 @@ class DisjointPool::AllocImpl {
     void printStats(bool &TitlePrinted, size_t &HighBucketSize,
                     size_t &HighPeakSlabsInUse, const std::string &Label);
 
+    // See umfDisjointPoolGetStats()
+    void getStats(umf_disjoint_pool_bucket_stats_t *Stats, size_t *NumBuckets);
+
+    // See umfDisjointPoolGetLargeCacheStats()
+    void getLargeCacheStats(umf_disjoint_pool_large_cache_stats_t *Stats);
+
+    // Register a new thread-local cache of the calling thread.
+    // ThreadCacheRegistryLock() must be held.
+    void registerThreadCache(ThreadCache &Cache);
+
+    // Return all chunks of the cache to the buckets and unregister it.
+    // ThreadCacheRegistryLock() must be held.
+    void unregisterThreadCache(ThreadCache &Cache);
+
   private:
-    Bucket &findBucket(size_t Size);
+    Bucket &findBucket(size_t Size, size_t Shard);
     std::size_t sizeToIdx(size_t Size);
+
+    // Find the bucket serving Size bytes aligned to Alignment, which must
+    // be a power of 2 not larger than SlabAlignment.
+    Bucket &findAlignedBucket(size_t Size, size_t Alignment, size_t Shard);
+    void createAlignedBucketLookup();
+
+    // Get memory from the bucket: a whole slab or a chunk, possibly from
+    // the calling thread's cache.
+    void *allocateFromBucket(Bucket &Bucket, bool &FromPool, bool &Fresh);
+
+    // Return the NUMA shard of the calling thread.
+    size_t getShard();
+
+    // Set up one shard per NUMA node with CPUs if NumaShards is set.
+    void createShards();
+
+    // Create the buckets from BucketSizes and SizeClassesPerDoubling
+    void createBuckets();
+    void createBucketLookup();
+
+    // Return the slab which contains Ptr or nullptr if Ptr does not belong
+    // to any slab of this pool.
+    Slab *findSlab(void *Ptr);
+
+    // Get a chunk from the calling thread's cache, refilling it from the
+    // bucket if it is empty.
+    void *getCachedChunk(Bucket &Bucket, bool &FromPool, bool &Fresh);
+
+    // Take a cached extent of at least Size bytes aligned to Alignment,
+    // splitting off its unused tail if the provider allows. Return nullptr
+    // if there is none.
+    void *getCachedLarge(size_t Size, size_t Alignment);
+
+    // Allocate from the large-allocation cache or the memory provider.
+    void *allocateLarge(size_t Size, size_t Alignment, bool *Zeroed);
+
+    // Free an allocation larger than MaxPoolableSize into the
+    // large-allocation cache, evicting the oldest extents above the cap.
+    void freeLarge(void *Ptr);
+
+    // Create the index and the record allocator of the large-allocation
+    // cache. Return false if out of memory.
+    bool createLargeCache();
+
+    // Return all cached extents to the provider and destroy the cache.
+    void destroyLargeCache();
+
+    // Order of the cached extents in LargeCache: by size, then by address
+    static int compareLargeExtents(const void *Lhs, const void *Rhs);
+
+    // Remove the extent from the cache and free its record.
+    // LargeCacheLock must be held, if needed.
+    void removeLargeExtent(LargeExtent &Extent);
+
+    // Remove the extent from the cache and return it to the provider.
+    // Errors of the provider are only logged.
+    // LargeCacheLock must be held, if needed.
+    void releaseLargeExtent(LargeExtent &Extent);
+
+    // Release the cached extents idle for LargeCacheDecayMs at time Now.
+    // LargeCacheLock must be held.
+    void releaseAgedLargeExtents(DecayClock::time_point Now);
+
+    // Try to extend the provider allocation at Ptr in place by allocating
+    // the memory right after it and merging both allocations.
+    bool growInPlace(void *Ptr, size_t OldSize, size_t NewSize);
+
+    // Cleared once the provider turned out not to support merging
+    std::atomic<bool> ProviderCanMerge{true};
+
+    // Every failed attempt to grow in place costs an extra allocation
+    // and free in the provider, so after GrowInPlaceMisses consecutive
+    // failures the next 2^GrowInPlaceMisses - 1 attempts (at most
+    // 2^MaxGrowInPlaceSkipsLog2 - 1) are skipped.
+    static constexpr size_t MaxGrowInPlaceSkipsLog2 = 10;
+    std::atomic<size_t> GrowInPlaceMisses{0};
+    std::atomic<size_t> GrowInPlaceSkips{0};
+
+    // Put a chunk into the calling thread's cache, flushing the oldest half
+    // of the cache to the bucket if it is full.
+    void freeCachedChunk(void *Ptr, Slab &Slab, bool &ToPool);
+
+    // Free a chunk to its bucket, without the lock if RemoteFrees is set
+    // and the slab is owned by another thread.
+    void freeChunk(void *Ptr, Slab &Slab, bool &ToPool);
+
+    // Number of chunks exchanged with a bucket on a cache refill or flush.
+    size_t threadCacheBatch() {
+        return std::max<size_t>(params.ThreadCacheCapacity / 2, 1);
+    }
+
+    ThreadCache &getThreadCache();
+    void flushThreadCache(ThreadCache &Cache);
+    void detachThreadCaches();
+
+    // Number of allocations and frees of a thread between the checks
+    // whether a decay pass is due.
+    static constexpr unsigned DecayTickInterval = 64;
+
+    DecayClock::duration getDecayAge() {
+        return std::chrono::milliseconds(params.DecayMs);
+    }
+
+    // Time between the decay passes
+    DecayClock::duration getDecayInterval() {
+        return std::max<DecayClock::duration>(getDecayAge() / 4,
+                                              std::chrono::milliseconds(1));
+    }
+
+    // Run a decay pass if it is due and not done by a background thread.
+    void tickDecay() {
+        if (!params.DecayMs || params.DecayBackgroundThread) {
+            return;
+        }
+
+        static thread_local unsigned Ticks = 0;
+        if (++Ticks % DecayTickInterval) {
+            return;
+        }
+
+        auto Now = DecayClock::now();
+        auto Next = NextDecay.load(std::memory_order_relaxed);
+        if (Now.time_since_epoch().count() < Next) {
+            return;
+        }
+
+        // Only one thread runs the pass.
+        auto NewNext = (Now + getDecayInterval()).time_since_epoch().count();
+        if (NextDecay.compare_exchange_strong(Next, NewNext,
+                                              std::memory_order_relaxed)) {
+            decay(Now);
+        }
+    }
+
+    void decay(DecayClock::time_point Now);
+    void decayThread();
+};
+
+// Serializes creation of thread caches, thread exit and pool destruction.
+// These are rare events, so a single lock for all pools is sufficient.
+static std::mutex &ThreadCacheRegistryLock() {
+    static std::mutex Lock;
+    return Lock;
+}
+
+// Owns the thread-local caches of the calling thread, one per pool it has
+// used. On thread exit the cached chunks are returned to their pools.
+class ThreadCacheHolder {
+    std::vector<std::unique_ptr<ThreadCache>> Caches;
+
+    // The most recently used cache.
+    ThreadCache *Last = nullptr;
+
+  public:
+    ThreadCache *find(DisjointPool::AllocImpl *Pool) {
+        if (Last && Last->Pool.load(std::memory_order_relaxed) == Pool) {
+            return Last;
+        }
+
+        for (auto &Cache : Caches) {
+            if (Cache->Pool.load(std::memory_order_relaxed) == Pool) {
+                Last = Cache.get();
+                return Last;
+            }
+        }
+
+        return nullptr;
+    }
+
+    ThreadCache &create(DisjointPool::AllocImpl *Pool, size_t NumBuckets) {
+        auto Cache = std::make_unique<ThreadCache>();
+        Cache->Pool.store(Pool, std::memory_order_relaxed);
+        Cache->Buckets.resize(NumBuckets);
+        Cache->Stats = std::make_unique<ThreadCache::Counters[]>(NumBuckets);
+
+        std::lock_guard<std::mutex> Lg(ThreadCacheRegistryLock());
+
+        // Drop the caches of pools that were destroyed in the meantime.
+        auto Detached = [](const std::unique_ptr<ThreadCache> &C) {
+            return C->Pool.load(std::memory_order_relaxed) == nullptr;
+        };
+        Caches.erase(std::remove_if(Caches.begin(), Caches.end(), Detached),
+                     Caches.end());
+
+        Pool->registerThreadCache(*Cache);
+        Caches.push_back(std::move(Cache));
+        Last = Caches.back().get();
+        return *Last;
+    }
+
+    ~ThreadCacheHolder() {
+        std::lock_guard<std::mutex> Lg(ThreadCacheRegistryLock());
+        for (auto &Cache : Caches) {
+            auto *Pool = Cache->Pool.load(std::memory_order_relaxed);
+            if (Pool) {
+                Pool->unregisterThreadCache(*Cache);
+            }
+        }
+    }
 };
 
+static thread_local ThreadCacheHolder LocalThreadCaches;
+
 static void *memoryProviderAlloc(umf_memory_provider_handle_t hProvider,
                                  size_t size, size_t alignment = 0) {
     void *ptr;
@@ -453,22 +1114,48 @@ std::ostream &operator<<(std::ostream &Os, const Slab &Slab) {
     return Os;
 }
 
-Slab::Slab(Bucket &Bkt)
-    : // In case bucket size is not a multiple of SlabMinSize, we would have
+Slab::Slab(Bucket &Bkt, size_t Size)
+    : SlabSize(Size),
+      // In case bucket size is not a multiple of SlabSize, we would have
       // some padding at the end of the slab.
-      Chunks(Bkt.SlabMinSize() / Bkt.getSize()), NumAllocated{0},
-      bucket(Bkt), SlabListIter{}, FirstFreeChunkIdx{0} {
-    auto SlabSize = Bkt.SlabAllocSize();
-    MemPtr = memoryProviderAlloc(Bkt.getMemHandle(), SlabSize);
-    regSlab(*this);
-}
+      NumChunks(Size / Bkt.getSize()),
+      NumWords(getNumWords(NumChunks)),
+      Bitmap(reinterpret_cast<uint64_t *>(this + 1)), NumAllocated{0},
+      bucket(Bkt), FirstFreeWordIdx{0}, FirstFreshChunkIdx{0} {
+    std::fill_n(Bitmap, NumWords + getNumSummaryWords(), 0);
+
+    // Mark the bits past the last chunk and past the last chunk word
+    // as allocated, so that they are never returned by the search.
+    if (NumChunks % 64) {
+        Bitmap[NumWords - 1] = ~uint64_t(0) << (NumChunks % 64);
+    }
+    if (NumWords % 64) {
+        getSummary()[getNumSummaryWords() - 1] = ~uint64_t(0)
+                                                 << (NumWords % 64);
+    }
+
+    size_t Alignment = Bkt.getAllocCtx().getSlabAllocAlignment();
+    try {
+        MemPtr = memoryProviderAlloc(Bkt.getMemHandle(), SlabSize, Alignment);
+    } catch (MemoryProviderError &) {
+        if (!Alignment) {
+            throw;
+        }
+        // The provider may not support aligned allocations at all
+        Bkt.getAllocCtx().setSlabsUnaligned();
+        MemPtr = memoryProviderAlloc(Bkt.getMemHandle(), SlabSize);
+    }
 
-Slab::~Slab() {
     try {
-        unregSlab(*this);
-    } catch (std::exception &e) {
-        LOG_ERR("DisjointPool: unexpected error: %s", e.what());
+        regSlab();
+    } catch (MemoryProviderError &) {
+        memoryProviderFree(Bkt.getMemHandle(), MemPtr);
+        throw;
     }
+}
+
+Slab::~Slab() {
+    unregSlab();
 
     try {
         memoryProviderFree(bucket.getMemHandle(), MemPtr);
@@ -493,17 +1180,20 @@ Slab::~Slab() {
 
 // Return the index of the first available chunk, SIZE_MAX otherwise
 size_t Slab::FindFirstAvailableChunkIdx() const {
-    // Use the first free chunk index as a hint for the search.
-    auto It = std::find_if(Chunks.begin() + FirstFreeChunkIdx, Chunks.end(),
-                           [](auto x) { return !x; });
-    if (It != Chunks.end()) {
-        return It - Chunks.begin();
+    const uint64_t *Summary = getSummary();
+
+    // Use the first free word index as a hint for the search.
+    for (size_t i = FirstFreeWordIdx / 64; i < getNumSummaryWords(); i++) {
+        if (Summary[i] != ~uint64_t(0)) {
+            size_t WordIdx = i * 64 + getRightmostSetBitPos(~Summary[i]);
+            return WordIdx * 64 + getRightmostSetBitPos(~Bitmap[WordIdx]);
+        }
     }
 
     return std::numeric_limits<size_t>::max();
 }
 
-void *Slab::getChunk() {
+void *Slab::getChunk(bool &Fresh) {
     // assert(NumAllocated != Chunks.size());
 
     const size_t ChunkIdx = FindFirstAvailableChunkIdx();
@@ -512,11 +1202,20 @@ void *Slab::getChunk() {
 
     void *const FreeChunk =
         (static_cast<uint8_t *>(getPtr())) + ChunkIdx * getChunkSize();
-    Chunks[ChunkIdx] = true;
+    const size_t WordIdx = ChunkIdx / 64;
+    Bitmap[WordIdx] |= uint64_t(1) << (ChunkIdx % 64);
+    if (Bitmap[WordIdx] == ~uint64_t(0)) {
+        getSummary()[WordIdx / 64] |= uint64_t(1) << (WordIdx % 64);
+    }
     NumAllocated += 1;
 
     // Use the found index as the next hint
-    FirstFreeChunkIdx = ChunkIdx;
+    FirstFreeWordIdx = WordIdx;
+
+    Fresh = ChunkIdx >= FirstFreshChunkIdx;
+    if (Fresh) {
+        FirstFreshChunkIdx = ChunkIdx + 1;
+    }
 
     return FreeChunk;
 }
@@ -528,48 +1227,37 @@ const Bucket &Slab::getBucket() const { return bucket; }
 
 size_t Slab::getChunkSize() const { return bucket.getSize(); }
 
-void Slab::regSlabByAddr(void *Addr, Slab &Slab) {
-    auto &Lock = Slab.getBucket().getAllocCtx().getKnownSlabsMapLock();
-    auto &Map = Slab.getBucket().getAllocCtx().getKnownSlabs();
-
-    std::lock_guard<std::shared_timed_mutex> Lg(Lock);
-    Map.insert({Addr, Slab});
-}
-
-void Slab::unregSlabByAddr(void *Addr, Slab &Slab) {
-    auto &Lock = Slab.getBucket().getAllocCtx().getKnownSlabsMapLock();
-    auto &Map = Slab.getBucket().getAllocCtx().getKnownSlabs();
-
-    std::lock_guard<std::shared_timed_mutex> Lg(Lock);
-
-    auto Slabs = Map.equal_range(Addr);
-    // At least the must get the current slab from the map.
-    assert(Slabs.first != Slabs.second && "Slab is not found");
-
-    for (auto It = Slabs.first; It != Slabs.second; ++It) {
-        if (It->second == Slab) {
-            Map.erase(It);
-            return;
-        }
+void Slab::regSlab() {
+    auto *Map = bucket.getAllocCtx().getKnownSlabs();
+    auto *Header = getRecordHeader();
+
+    // Publish the bounds before the slab can be found.
+    Header->Start.store(reinterpret_cast<uintptr_t>(getPtr()),
+                        std::memory_order_relaxed);
+    Header->Size.store(SlabSize, std::memory_order_relaxed);
+    Header->Seq.fetch_add(1, std::memory_order_release);
+
+    int ret = critnib_insert(Map, reinterpret_cast<uintptr_t>(getPtr()), this,
+                             0 /* update */);
+    if (ret != 0) {
+        Header->Seq.fetch_add(1, std::memory_order_relaxed);
+        // The start address of a live slab cannot be registered twice.
+        assert(ret != EEXIST && "Slab is already registered");
+        throw MemoryProviderError{UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY};
     }
-
-    assert(false && "Slab is not found");
 }
 
-void Slab::regSlab(Slab &Slab) {
-    void *StartAddr = AlignPtrDown(Slab.getPtr(), bucket.SlabMinSize());
-    void *EndAddr = static_cast<char *>(StartAddr) + bucket.SlabMinSize();
-
-    regSlabByAddr(StartAddr, Slab);
-    regSlabByAddr(EndAddr, Slab);
-}
+void Slab::unregSlab() {
+    auto &AllocCtx = bucket.getAllocCtx();
 
-void Slab::unregSlab(Slab &Slab) {
-    void *StartAddr = AlignPtrDown(Slab.getPtr(), bucket.SlabMinSize());
-    void *EndAddr = static_cast<char *>(StartAddr) + bucket.SlabMinSize();
+    // Lookups racing with the destruction no longer find Ptr in the slab,
+    // whose memory may be reused by the provider right after.
+    getRecordHeader()->Seq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
 
-    unregSlabByAddr(StartAddr, Slab);
-    unregSlabByAddr(EndAddr, Slab);
+    [[maybe_unused]] void *Removed = critnib_remove(
+        AllocCtx.getKnownSlabs(), reinterpret_cast<uintptr_t>(getPtr()));
+    assert(Removed == this && "Slab is not found");
 }
 
 void Slab::freeChunk(void *Ptr) {
@@ -584,114 +1272,247 @@ void Slab::freeChunk(void *Ptr) {
     auto ChunkIdx = (static_cast<char *>(Ptr) - static_cast<char *>(MemPtr)) /
                     getChunkSize();
 
+    const size_t WordIdx = ChunkIdx / 64;
+    const uint64_t ChunkBit = uint64_t(1) << (ChunkIdx % 64);
+
     // Make sure that the chunk was allocated
-    assert(Chunks[ChunkIdx] && "double free detected");
+    assert((Bitmap[WordIdx] & ChunkBit) && "double free detected");
 
-    Chunks[ChunkIdx] = false;
+    Bitmap[WordIdx] &= ~ChunkBit;
+    getSummary()[WordIdx / 64] &= ~(uint64_t(1) << (WordIdx % 64));
     NumAllocated -= 1;
 
-    if (ChunkIdx < FirstFreeChunkIdx) {
-        FirstFreeChunkIdx = ChunkIdx;
+    if (WordIdx < FirstFreeWordIdx) {
+        FirstFreeWordIdx = WordIdx;
     }
 }
 
 void *Slab::getEnd() const {
-    return static_cast<char *>(getPtr()) + bucket.SlabMinSize();
+    return static_cast<char *>(getPtr()) + SlabSize;
+}
+
+void *Slab::getChunkStart(void *Ptr) const {
+    auto ChunkIdx = (static_cast<char *>(Ptr) - static_cast<char *>(MemPtr)) /
+                    getChunkSize();
+    return static_cast<char *>(MemPtr) + ChunkIdx * getChunkSize();
 }
 
 bool Slab::hasAvail() { return NumAllocated != getNumChunks(); }
 
+size_t Slab::purge(bool Force) {
+    auto Wanted = Force ? PurgeState::Force : PurgeState::Lazy;
+    if (Purged >= Wanted) {
+        return 0;
+    }
+
+    auto hProvider = bucket.getMemHandle();
+    auto Size = SlabSize;
+    auto ret = Force ? umfMemoryProviderPurgeForce(hProvider, MemPtr, Size)
+                     : umfMemoryProviderPurgeLazy(hProvider, MemPtr, Size);
+
+    // If purging is not possible, the slab is just freed later.
+    size_t PurgedSize = 0;
+    if (ret == UMF_RESULT_SUCCESS && Purged == PurgeState::None) {
+        PurgedSize = Size;
+    }
+
+    Purged = Wanted;
+    return PurgedSize;
+}
+
 // If a slab was available in the pool then note that the current pooled
 // size has reduced by the size of a slab in this bucket.
-void Bucket::decrementPool(bool &FromPool) {
+void Bucket::decrementPool(Slab &Slab, bool &FromPool) {
+    PooledSlabs.remove(Slab);
     FromPool = true;
-    updateStats(1, -1);
-    OwnAllocCtx.getLimits()->TotalSize -= SlabAllocSize();
+    updateStats(1, -1, Slab.getSize());
+    OwnAllocCtx.getLimits()->TotalSize -= Slab.getSize();
+}
+
+Bucket::~Bucket() {
+    while (!AvailableSlabs.empty()) {
+        auto *S = AvailableSlabs.front();
+        AvailableSlabs.remove(*S);
+        destroySlab(*S);
+    }
+    while (!UnavailableSlabs.empty()) {
+        auto *S = UnavailableSlabs.front();
+        UnavailableSlabs.remove(*S);
+        destroySlab(*S);
+    }
+}
+
+Slab &Bucket::createSlab() {
+    auto *Record = OwnAllocCtx.getSlabRecord();
+    if (!Record) {
+        throw MemoryProviderError{UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY};
+    }
+
+    try {
+        size_t Size = nextSlabSize();
+        auto &NewSlab = *new (Record + 1) Slab(*this, Size);
+        lastSlabSize.store(Size, std::memory_order_relaxed);
+        return NewSlab;
+    } catch (...) {
+        OwnAllocCtx.putSlabRecord(Record);
+        throw;
+    }
+}
+
+void Bucket::destroySlab(Slab &Slab) {
+    auto *Record = Slab.getRecordHeader();
+    Slab.~Slab();
+    OwnAllocCtx.putSlabRecord(Record);
 }
 
-auto Bucket::getAvailFullSlab(bool &FromPool)
-    -> decltype(AvailableSlabs.begin()) {
+Slab *Bucket::getAvailFullSlab(bool &FromPool) {
     // Return a slab that will be used for a single allocation.
-    if (AvailableSlabs.size() == 0) {
-        auto It = AvailableSlabs.insert(AvailableSlabs.begin(),
-                                        std::make_unique<Slab>(*this));
-        (*It)->setIterator(It);
+    if (AvailableSlabs.empty()) {
+        AvailableSlabs.pushFront(createSlab());
         FromPool = false;
-        updateStats(1, 0);
+        updateStats(1, 0, AvailableSlabs.front()->getSize());
     } else {
-        decrementPool(FromPool);
+        decrementPool(*AvailableSlabs.front(), FromPool);
     }
 
-    return AvailableSlabs.begin();
+    return AvailableSlabs.front();
 }
 
 void *Bucket::getSlab(bool &FromPool) {
     std::lock_guard<std::mutex> Lg(BucketLock);
 
-    auto SlabIt = getAvailFullSlab(FromPool);
-    auto *FreeSlab = (*SlabIt)->getSlab();
-    auto It =
-        UnavailableSlabs.insert(UnavailableSlabs.begin(), std::move(*SlabIt));
-    AvailableSlabs.erase(SlabIt);
-    (*It)->setIterator(It);
-    return FreeSlab;
+    auto *FreeSlab = getAvailFullSlab(FromPool);
+    AvailableSlabs.remove(*FreeSlab);
+    UnavailableSlabs.pushFront(*FreeSlab);
+    return FreeSlab->getSlab();
 }
 
 void Bucket::freeSlab(Slab &Slab, bool &ToPool) {
     std::lock_guard<std::mutex> Lg(BucketLock);
-    auto SlabIter = Slab.getIterator();
-    assert(SlabIter != UnavailableSlabs.end());
-    if (CanPool(ToPool)) {
-        auto It =
-            AvailableSlabs.insert(AvailableSlabs.begin(), std::move(*SlabIter));
-        UnavailableSlabs.erase(SlabIter);
-        (*It)->setIterator(It);
+    UnavailableSlabs.remove(Slab);
+    if (CanPool(Slab, ToPool)) {
+        AvailableSlabs.pushFront(Slab);
+        addToPool(Slab);
     } else {
-        UnavailableSlabs.erase(SlabIter);
+        destroySlab(Slab);
+    }
+}
+
+void Bucket::addToPool(Slab &Slab) {
+    if (OwnAllocCtx.getParams().DecayMs) {
+        Slab.setPooled(DecayClock::now());
+    }
+    PooledSlabs.pushFront(Slab);
+}
+
+void Bucket::decay(DecayClock::time_point Now, DecayClock::duration Age) {
+    std::lock_guard<std::mutex> Lg(BucketLock);
+
+    // Remote frees are not left behind if the bucket is no longer used
+    drainRemoteFrees();
+
+    // Walk from the oldest pooled slab until one is too young.
+    auto *Oldest = PooledSlabs.back();
+    while (Oldest) {
+        auto &Slab = *Oldest;
+        Oldest = Slab.PooledLinks.Prev;
+
+        auto Idle = Now - Slab.getPooledSince();
+        if (Idle < Age) {
+            break;
+        }
+
+        if (Idle < 3 * Age) {
+            purgedBytes.fetch_add(Slab.purge(Idle >= 2 * Age),
+                                  std::memory_order_relaxed);
+            continue;
+        }
+
+        // Return the slab to the provider
+        PooledSlabs.remove(Slab);
+        AvailableSlabs.remove(Slab);
+        if (getSize() <= ChunkCutOff()) {
+            --chunkedSlabsInPool;
+        }
+        updateStats(0, -1, Slab.getSize());
+        OwnAllocCtx.getLimits()->TotalSize -= Slab.getSize();
+        destroySlab(Slab);
     }
 }
 
-auto Bucket::getAvailSlab(bool &FromPool) -> decltype(AvailableSlabs.begin()) {
+Slab *Bucket::getAvailSlab(bool &FromPool) {
 
-    if (AvailableSlabs.size() == 0) {
-        auto It = AvailableSlabs.insert(AvailableSlabs.begin(),
-                                        std::make_unique<Slab>(*this));
-        (*It)->setIterator(It);
+    if (AvailableSlabs.empty()) {
+        AvailableSlabs.pushFront(createSlab());
 
-        updateStats(1, 0);
+        updateStats(1, 0, AvailableSlabs.front()->getSize());
         FromPool = false;
     } else {
-        if ((*(AvailableSlabs.begin()))->getNumAllocated() == 0) {
+        if (AvailableSlabs.front()->getNumAllocated() == 0) {
             // If this was an empty slab, it was in the pool.
             // Now it is no longer in the pool, so update count.
             --chunkedSlabsInPool;
-            decrementPool(FromPool);
+            decrementPool(*AvailableSlabs.front(), FromPool);
         } else {
             // Allocation from existing slab is treated as from pool for statistics.
             FromPool = true;
         }
     }
 
-    return AvailableSlabs.begin();
+    return AvailableSlabs.front();
 }
 
-void *Bucket::getChunk(bool &FromPool) {
+void *Bucket::getChunk(bool &FromPool, bool &Fresh) {
     std::lock_guard<std::mutex> Lg(BucketLock);
 
-    auto SlabIt = getAvailSlab(FromPool);
-    auto *FreeChunk = (*SlabIt)->getChunk();
+    drainRemoteFrees();
+
+    auto *ChunkSlab = getAvailSlab(FromPool);
+    auto *FreeChunk = ChunkSlab->getChunk(Fresh);
+    ChunkSlab->Owner.store(threadToken(), std::memory_order_relaxed);
 
-    // If the slab is full, move it to unavailable slabs and update its iterator
-    if (!((*SlabIt)->hasAvail())) {
-        auto It = UnavailableSlabs.insert(UnavailableSlabs.begin(),
-                                          std::move(*SlabIt));
-        AvailableSlabs.erase(SlabIt);
-        (*It)->setIterator(It);
+    // If the slab is full, move it to unavailable slabs
+    if (!ChunkSlab->hasAvail()) {
+        AvailableSlabs.remove(*ChunkSlab);
+        UnavailableSlabs.pushFront(*ChunkSlab);
     }
 
     return FreeChunk;
 }
 
+void Bucket::getChunks(std::vector<CachedChunk> &Chunks, size_t Count,
+                       bool &FromPool) {
+    std::lock_guard<std::mutex> Lg(BucketLock);
+
+    drainRemoteFrees();
+
+    for (size_t i = 0; i < Count; i++) {
+        // Only the first chunk may require a new slab or a slab from the pool,
+        // the rest of the batch is taken from partially used slabs.
+        if (i > 0 && (AvailableSlabs.empty() ||
+                      AvailableSlabs.front()->getNumAllocated() == 0)) {
+            break;
+        }
+
+        bool ChunkFromPool;
+        auto &ChunkSlab = *getAvailSlab(ChunkFromPool);
+        if (i == 0) {
+            FromPool = ChunkFromPool;
+        }
+
+        bool Fresh;
+        void *Ptr = ChunkSlab.getChunk(Fresh);
+        ChunkSlab.Owner.store(threadToken(), std::memory_order_relaxed);
+        Chunks.push_back({Ptr, &ChunkSlab, Fresh});
+
+        // If the slab is full, move it to unavailable slabs
+        if (!ChunkSlab.hasAvail()) {
+            AvailableSlabs.remove(ChunkSlab);
+            UnavailableSlabs.pushFront(ChunkSlab);
+        }
+    }
+}
+
 void Bucket::freeChunk(void *Ptr, Slab &Slab, bool &ToPool) {
     std::lock_guard<std::mutex> Lg(BucketLock);
 
@@ -700,21 +1521,83 @@ void Bucket::freeChunk(void *Ptr, Slab &Slab, bool &ToPool) {
     onFreeChunk(Slab, ToPool);
 }
 
-// The lock must be acquired before calling this method
-void Bucket::onFreeChunk(Slab &Slab, bool &ToPool) {
+void Bucket::freeChunks(const CachedChunk *Chunks, size_t Count,
+                        bool &ToPool) {
+    std::lock_guard<std::mutex> Lg(BucketLock);
+
+    for (size_t i = 0; i < Count; i++) {
+        // A slab may be destroyed by onFreeChunk() only when its last chunk
+        // is freed, so no later entry can refer to it.
+        Chunks[i].ChunkSlab->freeChunk(Chunks[i].Ptr);
+        onFreeChunk(*Chunks[i].ChunkSlab, ToPool);
+    }
+}
+
+void Bucket::freeRemoteChunk(void *Ptr, Slab &Slab) {
+    auto *Chunk = static_cast<uintptr_t *>(Slab.getChunkStart(Ptr));
+
+    // The link word is read by the draining thread.
+    annotate_memory_undefined(Chunk, sizeof(*Chunk));
+
+    uintptr_t Head = Slab.RemoteFrees.load(std::memory_order_relaxed);
+    do {
+        *Chunk = Head & ~uintptr_t(1);
+    } while (!Slab.RemoteFrees.compare_exchange_weak(
+        Head, reinterpret_cast<uintptr_t>(Chunk) | 1,
+        std::memory_order_release, std::memory_order_relaxed));
+
+    if (Head & 1) {
+        // The slab is already queued
+        return;
+    }
+
+    // The slab cannot go away before it is drained, the chunk pushed
+    // above is still allocated.
+    auto *Top = RemoteSlabs.load(std::memory_order_relaxed);
+    do {
+        Slab.RemoteNext = Top;
+    } while (!RemoteSlabs.compare_exchange_weak(Top, &Slab,
+                                                std::memory_order_release,
+                                                std::memory_order_relaxed));
+}
+
+void Bucket::drainRemoteFrees() {
+    if (!RemoteSlabs.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    auto *Next = RemoteSlabs.exchange(nullptr, std::memory_order_acquire);
+    while (Next) {
+        auto &Slab = *Next;
+        // Read before the slab can be queued again
+        Next = Slab.RemoteNext;
+
+        uintptr_t Chunk =
+            Slab.RemoteFrees.exchange(0, std::memory_order_acquire) &
+            ~uintptr_t(1);
+        while (Chunk) {
+            auto *Ptr = reinterpret_cast<uintptr_t *>(Chunk);
+            Chunk = *Ptr;
+            annotate_memory_inaccessible(Ptr, sizeof(*Ptr));
+
+            // The slab may be destroyed with its last chunk, which is then
+            // the last chunk on the list.
+            bool ToPool;
+            Slab.freeChunk(Ptr);
+            onFreeChunk(Slab, ToPool);
+        }
+    }
+}
+
+// The lock must be acquired before calling this method
+void Bucket::onFreeChunk(Slab &Slab, bool &ToPool) {
     ToPool = true;
 
     // In case if the slab was previously full and now has 1 available
     // chunk, it should be moved to the list of available slabs
     if (Slab.getNumAllocated() == (Slab.getNumChunks() - 1)) {
-        auto SlabIter = Slab.getIterator();
-        assert(SlabIter != UnavailableSlabs.end());
-
-        auto It =
-            AvailableSlabs.insert(AvailableSlabs.begin(), std::move(*SlabIter));
-        UnavailableSlabs.erase(SlabIter);
-
-        (*It)->setIterator(It);
+        UnavailableSlabs.remove(Slab);
+        AvailableSlabs.pushFront(Slab);
     }
 
     // Check if slab is empty, and pool it if we can.
@@ -723,17 +1606,16 @@ void Bucket::onFreeChunk(Slab &Slab, bool &ToPool) {
         // If pool has capacity then put the slab in the pool.
         // The ToPool parameter indicates whether the Slab will be put in the
         // pool or freed.
-        if (!CanPool(ToPool)) {
-            // Note: since the slab is stored as unique_ptr, just remove it from
-            // the list to destroy the object.
-            auto It = Slab.getIterator();
-            assert(It != AvailableSlabs.end());
-            AvailableSlabs.erase(It);
+        if (!CanPool(Slab, ToPool)) {
+            AvailableSlabs.remove(Slab);
+            destroySlab(Slab);
+        } else {
+            addToPool(Slab);
         }
     }
 }
 
-bool Bucket::CanPool(bool &ToPool) {
+bool Bucket::CanPool(Slab &Slab, bool &ToPool) {
     size_t NewFreeSlabsInBucket;
     // Check if this bucket is used in chunked form or as full slabs.
     bool chunkedBucket = getSize() <= ChunkCutOff();
@@ -745,7 +1627,7 @@ bool Bucket::CanPool(bool &ToPool) {
     if (Capacity() >= NewFreeSlabsInBucket) {
         size_t PoolSize = OwnAllocCtx.getLimits()->TotalSize;
         while (true) {
-            size_t NewPoolSize = PoolSize + SlabAllocSize();
+            size_t NewPoolSize = PoolSize + Slab.getSize();
 
             if (OwnAllocCtx.getLimits()->MaxSize < NewPoolSize) {
                 break;
@@ -757,14 +1639,14 @@ bool Bucket::CanPool(bool &ToPool) {
                     ++chunkedSlabsInPool;
                 }
 
-                updateStats(-1, 1);
+                updateStats(-1, 1, Slab.getSize());
                 ToPool = true;
                 return true;
             }
         }
     }
 
-    updateStats(-1, 0);
+    updateStats(-1, 0, Slab.getSize());
     ToPool = false;
     return false;
 }
@@ -777,6 +1659,24 @@ size_t Bucket::SlabMinSize() { return OwnAllocCtx.getParams().SlabMinSize; }
 
 size_t Bucket::SlabAllocSize() { return std::max(getSize(), SlabMinSize()); }
 
+size_t Bucket::nextSlabSize() {
+    size_t Size = SlabAllocSize();
+    if (getSize() > ChunkCutOff()) {
+        return Size;
+    }
+
+    // Slab records have room for a limited number of chunks.
+    size_t MaxSize =
+        std::min(OwnAllocCtx.getParams().SlabMaxSize,
+                 OwnAllocCtx.getMaxSlabChunks() * getSize());
+    size_t InUse = currSlabsInUse.load(std::memory_order_relaxed);
+    for (; InUse && Size <= MaxSize / 2; InUse /= 2) {
+        Size *= 2;
+    }
+
+    return Size;
+}
+
 size_t Bucket::Capacity() {
     // For buckets used in chunked mode, just one slab in pool is sufficient.
     // For larger buckets, the capacity could be more and is adjustable.
@@ -794,69 +1694,127 @@ size_t Bucket::MaxPoolableSize() {
 size_t Bucket::ChunkCutOff() { return SlabMinSize() / 2; }
 
 void Bucket::countAlloc(bool FromPool) {
-    ++allocCount;
+    allocCount.fetch_add(1, std::memory_order_relaxed);
     if (FromPool) {
-        ++allocPoolCount;
+        allocPoolCount.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
-void Bucket::countFree() { ++freeCount; }
+void Bucket::countFree() { freeCount.fetch_add(1, std::memory_order_relaxed); }
+
+// The lock must be acquired before calling this method
+void Bucket::updateStats(int InUse, int InPool, size_t SlabSize) {
+    constexpr auto Relaxed = std::memory_order_relaxed;
+
+    size_t InUseNow = currSlabsInUse.load(Relaxed) + InUse;
+    currSlabsInUse.store(InUseNow, Relaxed);
+    if (InUseNow > maxSlabsInUse.load(Relaxed)) {
+        maxSlabsInUse.store(InUseNow, Relaxed);
+    }
+
+    size_t InPoolNow = currSlabsInPool.load(Relaxed) + InPool;
+    currSlabsInPool.store(InPoolNow, Relaxed);
+    if (InPoolNow > maxSlabsInPool.load(Relaxed)) {
+        maxSlabsInPool.store(InPoolNow, Relaxed);
+    }
 
-void Bucket::updateStats(int InUse, int InPool) {
     if (OwnAllocCtx.getParams().PoolTrace == 0) {
         return;
     }
-    currSlabsInUse += InUse;
-    maxSlabsInUse = std::max(currSlabsInUse, maxSlabsInUse);
-    currSlabsInPool += InPool;
-    maxSlabsInPool = std::max(currSlabsInPool, maxSlabsInPool);
     // Increment or decrement current pool sizes based on whether
     // slab was added to or removed from pool.
-    OwnAllocCtx.getParams().CurPoolSize += InPool * SlabAllocSize();
+    OwnAllocCtx.getParams().CurPoolSize += InPool * SlabSize;
+}
+
+void Bucket::getStats(umf_disjoint_pool_bucket_stats_t &Stats) {
+    constexpr auto Relaxed = std::memory_order_relaxed;
+
+    Stats.BucketSize = getSize();
+    Stats.SlabSize = lastSlabSize.load(Relaxed);
+    Stats.AllocCount = allocCount.load(Relaxed);
+    Stats.AllocPoolCount = allocPoolCount.load(Relaxed);
+    Stats.FreeCount = freeCount.load(Relaxed);
+    Stats.CurSlabsInUse = currSlabsInUse.load(Relaxed);
+    Stats.MaxSlabsInUse = maxSlabsInUse.load(Relaxed);
+    Stats.CurSlabsInPool = currSlabsInPool.load(Relaxed);
+    Stats.MaxSlabsInPool = maxSlabsInPool.load(Relaxed);
+    Stats.PurgedBytes = purgedBytes.load(Relaxed);
+    Stats.Shard = Shard;
 }
 
-void Bucket::printStats(bool &TitlePrinted, const std::string &Label) {
-    if (allocCount) {
+void Bucket::addCounters(const ThreadCache::Counters &Counters) {
+    constexpr auto Relaxed = std::memory_order_relaxed;
+
+    allocCount.fetch_add(Counters.AllocCount.load(Relaxed), Relaxed);
+    allocPoolCount.fetch_add(Counters.AllocPoolCount.load(Relaxed), Relaxed);
+    freeCount.fetch_add(Counters.FreeCount.load(Relaxed), Relaxed);
+}
+
+static void printBucketStats(const umf_disjoint_pool_bucket_stats_t &Stats,
+                             bool &TitlePrinted, const std::string &Label) {
+    if (Stats.AllocCount) {
         if (!TitlePrinted) {
             std::cout << Label << " memory statistics\n";
             std::cout << std::setw(14) << "Bucket Size" << std::setw(12)
                       << "Allocs" << std::setw(12) << "Frees" << std::setw(18)
                       << "Allocs from Pool" << std::setw(20)
                       << "Peak Slabs in Use" << std::setw(21)
-                      << "Peak Slabs in Pool" << std::endl;
+                      << "Peak Slabs in Pool" << std::setw(15)
+                      << "Purged Bytes" << std::endl;
             TitlePrinted = true;
         }
-        std::cout << std::setw(14) << getSize() << std::setw(12) << allocCount
-                  << std::setw(12) << freeCount << std::setw(18)
-                  << allocPoolCount << std::setw(20) << maxSlabsInUse
-                  << std::setw(21) << maxSlabsInPool << std::endl;
+        std::cout << std::setw(14) << Stats.BucketSize << std::setw(12)
+                  << Stats.AllocCount << std::setw(12) << Stats.FreeCount
+                  << std::setw(18) << Stats.AllocPoolCount << std::setw(20)
+                  << Stats.MaxSlabsInUse << std::setw(21)
+                  << Stats.MaxSlabsInPool << std::setw(15)
+                  << Stats.PurgedBytes << std::endl;
     }
 }
 
-void *DisjointPool::AllocImpl::allocate(size_t Size, bool &FromPool) try {
+void *DisjointPool::AllocImpl::allocateFromBucket(Bucket &Bucket,
+                                                  bool &FromPool,
+                                                  bool &Fresh) {
     void *Ptr;
+    if (Bucket.getSize() > Bucket.ChunkCutOff()) {
+        Ptr = Bucket.getSlab(FromPool);
+        Fresh = !FromPool;
+    } else if (getParams().ThreadCacheCapacity) {
+        Ptr = getCachedChunk(Bucket, FromPool, Fresh);
+    } else {
+        Ptr = Bucket.getChunk(FromPool, Fresh);
+    }
+
+    // Chunks from the thread cache are counted there
+    if (Bucket.getSize() > Bucket.ChunkCutOff() ||
+        !getParams().ThreadCacheCapacity) {
+        Bucket.countAlloc(FromPool);
+    }
+
+    return Ptr;
+}
+
+void *DisjointPool::AllocImpl::allocate(size_t Size, bool &FromPool,
+                                        bool *Zeroed) try {
+    void *Ptr;
+    bool Fresh;
 
     if (Size == 0) {
         return nullptr;
     }
 
+    tickDecay();
+
     FromPool = false;
     if (Size > getParams().MaxPoolableSize) {
-        Ptr = memoryProviderAlloc(getMemHandle(), Size);
-        annotate_memory_undefined(Ptr, Size);
-        return Ptr;
+        return allocateLarge(Size, 0, Zeroed);
     }
 
-    auto &Bucket = findBucket(Size);
+    auto &Bucket = findBucket(Size, getShard());
+    Ptr = allocateFromBucket(Bucket, FromPool, Fresh);
 
-    if (Size > Bucket.ChunkCutOff()) {
-        Ptr = Bucket.getSlab(FromPool);
-    } else {
-        Ptr = Bucket.getChunk(FromPool);
-    }
-
-    if (getParams().PoolTrace > 1) {
-        Bucket.countAlloc(FromPool);
+    if (Zeroed) {
+        *Zeroed = Fresh && getParams().ProviderZeroesMemory;
     }
 
     VALGRIND_DO_MEMPOOL_ALLOC(this, Ptr, Size);
@@ -871,6 +1829,7 @@ void *DisjointPool::AllocImpl::allocate(size_t Size, bool &FromPool) try {
 void *DisjointPool::AllocImpl::allocate(size_t Size, size_t Alignment,
                                         bool &FromPool) try {
     void *Ptr;
+    bool Fresh;
 
     if (Size == 0) {
         return nullptr;
@@ -880,39 +1839,49 @@ void *DisjointPool::AllocImpl::allocate(size_t Size, size_t Alignment,
         return allocate(Size, FromPool);
     }
 
-    size_t AlignedSize;
-    if (Alignment <= ProviderMinPageSize) {
-        // This allocation will be served from a Bucket which size is multiple
-        // of Alignment and Slab address is aligned to ProviderMinPageSize
-        // so the address will be properly aligned.
-        AlignedSize = (Size > 1) ? AlignUp(Size, Alignment) : Alignment;
-    } else {
-        // Slabs are only aligned to ProviderMinPageSize, we need to compensate
-        // for that in case the allocation is within pooling limit.
-        // TODO: consider creating properly-aligned Slabs on demand
-        AlignedSize = Size + Alignment - 1;
-    }
+    tickDecay();
 
-    // Check if requested allocation size is within pooling limit.
-    // If not, just request aligned pointer from the system.
     FromPool = false;
-    if (AlignedSize > getParams().MaxPoolableSize) {
-        Ptr = memoryProviderAlloc(getMemHandle(), Size, Alignment);
+    if (Alignment <= SlabAlignment &&
+        SlabsAligned.load(std::memory_order_relaxed)) {
+        // Served without padding from the first bucket whose chunks are
+        // aligned by construction.
+        Bucket *AlignedBucket = nullptr;
+        if (Size <= getParams().MaxPoolableSize) {
+            AlignedBucket = &findAlignedBucket(Size, Alignment, getShard());
+        }
+        if (!AlignedBucket ||
+            AlignedBucket->getSize() > getParams().MaxPoolableSize) {
+            return allocateLarge(Size, Alignment, nullptr);
+        }
+
+        Ptr = allocateFromBucket(*AlignedBucket, FromPool, Fresh);
+        VALGRIND_DO_MEMPOOL_ALLOC(this, Ptr, Size);
         annotate_memory_undefined(Ptr, Size);
-        return Ptr;
+        if ((reinterpret_cast<uintptr_t>(Ptr) & (Alignment - 1)) == 0) {
+            return Ptr;
+        }
+
+        // The provider did not honor the slab alignment, fall back to
+        // padding from now on.
+        setSlabsUnaligned();
+        bool ToPool;
+        deallocate(Ptr, ToPool);
+        FromPool = false;
     }
 
-    auto &Bucket = findBucket(AlignedSize);
+    // Slabs are not known to be aligned enough, compensate for that in
+    // case the allocation is within pooling limit.
+    size_t AlignedSize = Size + Alignment - 1;
 
-    if (AlignedSize > Bucket.ChunkCutOff()) {
-        Ptr = Bucket.getSlab(FromPool);
-    } else {
-        Ptr = Bucket.getChunk(FromPool);
+    // Check if requested allocation size is within pooling limit.
+    // If not, just request aligned pointer from the system.
+    if (AlignedSize > getParams().MaxPoolableSize) {
+        return allocateLarge(Size, Alignment, nullptr);
     }
 
-    if (getParams().PoolTrace > 1) {
-        Bucket.countAlloc(FromPool);
-    }
+    auto &Bucket = findBucket(AlignedSize, getShard());
+    Ptr = allocateFromBucket(Bucket, FromPool, Fresh);
 
     VALGRIND_DO_MEMPOOL_ALLOC(this, AlignPtrUp(Ptr, Alignment), Size);
     annotate_memory_undefined(AlignPtrUp(Ptr, Alignment), Size);
@@ -922,95 +1891,861 @@ void *DisjointPool::AllocImpl::allocate(size_t Size, size_t Alignment,
     return nullptr;
 }
 
-std::size_t DisjointPool::AllocImpl::sizeToIdx(size_t Size) {
-    assert(Size <= CutOff && "Unexpected size");
-    assert(Size > 0 && "Unexpected size");
+void DisjointPool::AllocImpl::createBuckets() {
+    size_t ClassesPerDoubling = params.SizeClassesPerDoubling;
+    if (ClassesPerDoubling == 0) {
+        ClassesPerDoubling = 2;
+    }
+    if ((ClassesPerDoubling & (ClassesPerDoubling - 1)) != 0 ||
+        ClassesPerDoubling > MaxSizeClassesPerDoubling) {
+        LOG_ERR("DisjointPool: SizeClassesPerDoubling must be a power of 2 "
+                "not larger than %zu",
+                MaxSizeClassesPerDoubling);
+        throw MemoryProviderError{UMF_RESULT_ERROR_INVALID_ARGUMENT};
+    }
+
+    std::vector<size_t> Sizes;
+    size_t LastSize = 0;
+    if (params.BucketSizes) {
+        for (size_t i = 0; i < params.NumBucketSizes; i++) {
+            size_t Size = params.BucketSizes[i];
+            if (Size <= LastSize || Size > CutOff) {
+                LOG_ERR("DisjointPool: BucketSizes must be strictly "
+                        "increasing and not larger than %zu",
+                        CutOff);
+                throw MemoryProviderError{UMF_RESULT_ERROR_INVALID_ARGUMENT};
+            }
+            Sizes.push_back(Size);
+            LastSize = Size;
+        }
+    }
+
+    // Generate buckets sized such as: 64, 96, 128, 192, ..., CutOff.
+    // Powers of 2 and ClassesPerDoubling - 1 values evenly spaced between
+    // them, skipping the sizes covered by BucketSizes.
+    auto MinSize = params.MinBucketSize;
+    // MinBucketSize cannot be larger than CutOff.
+    MinSize = std::min(MinSize, CutOff);
+    // Buckets sized smaller than the bucket default size- 8 aren't needed.
+    MinSize = std::max(MinSize, UMF_DISJOINT_POOL_MIN_BUCKET_DEFAULT_SIZE);
+    for (size_t Pow2 = MinSize; Pow2 < CutOff; Pow2 *= 2) {
+        // Keep the buckets at least min(8, Pow2 / 2) bytes apart, like the
+        // default buckets, which are Pow2 / 2 apart.
+        size_t Step = std::max(
+            Pow2 / ClassesPerDoubling,
+            std::min(Pow2 / 2, UMF_DISJOINT_POOL_MIN_BUCKET_DEFAULT_SIZE));
+        for (size_t Size = Pow2; Size < 2 * Pow2; Size += Step) {
+            if (Size > LastSize) {
+                Sizes.push_back(Size);
+            }
+        }
+    }
+    if (CutOff > LastSize) {
+        Sizes.push_back(CutOff);
+    }
+
+    NumBucketSizes = Sizes.size();
+    for (size_t Shard = 0; Shard < NumShards; Shard++) {
+        for (size_t Size : Sizes) {
+            Buckets.push_back(
+                std::make_unique<Bucket>(Size, *this, Buckets.size(), Shard));
+        }
+    }
+}
+
+#ifndef UMF_NO_HWLOC
+// Number of calls between the checks on which CPU the calling thread runs.
+static constexpr unsigned CpuRefreshInterval = 256;
+
+// Return the OS index of the CPU the calling thread last ran on. It is
+// looked up again every CpuRefreshInterval calls, so a thread that moved to
+// another node uses its new shard soon enough.
+static size_t currentCpu() {
+    struct CpuCache {
+        hwloc_bitmap_t Set = hwloc_bitmap_alloc();
+        size_t Cpu = 0;
+        unsigned Countdown = 0;
+        ~CpuCache() { hwloc_bitmap_free(Set); }
+    };
+    static thread_local CpuCache Cache;
+
+    if (Cache.Countdown-- == 0) {
+        Cache.Countdown = CpuRefreshInterval;
+        hwloc_topology_t Topology = umfGetTopology();
+        if (Topology && Cache.Set &&
+            hwloc_get_last_cpu_location(Topology, Cache.Set,
+                                        HWLOC_CPUBIND_THREAD) == 0) {
+            int First = hwloc_bitmap_first(Cache.Set);
+            Cache.Cpu = First < 0 ? 0 : First;
+        }
+    }
+
+    return Cache.Cpu;
+}
+#endif
+
+void DisjointPool::AllocImpl::createShards() {
+#ifndef UMF_NO_HWLOC
+    if (!params.NumaShards) {
+        return;
+    }
+
+    hwloc_topology_t Topology = umfGetTopology();
+    if (!Topology) {
+        LOG_WARN("DisjointPool: cannot get the topology, NUMA sharding is "
+                 "disabled");
+        return;
+    }
+
+    int LastCpu =
+        hwloc_bitmap_last(hwloc_topology_get_topology_cpuset(Topology));
+    if (LastCpu < 0) {
+        return;
+    }
+    CpuToShard.assign(LastCpu + 1, 0);
+
+    // Memory-only nodes get no shard, no thread runs there.
+    size_t Shard = 0;
+    hwloc_obj_t Node = nullptr;
+    while ((Node = hwloc_get_next_obj_by_type(Topology, HWLOC_OBJ_NUMANODE,
+                                              Node))) {
+        if (!Node->cpuset || hwloc_bitmap_iszero(Node->cpuset)) {
+            continue;
+        }
+        unsigned Cpu;
+        hwloc_bitmap_foreach_begin(Cpu, Node->cpuset) {
+            if (Cpu < CpuToShard.size()) {
+                CpuToShard[Cpu] = Shard;
+            }
+        }
+        hwloc_bitmap_foreach_end();
+        Shard++;
+    }
 
-    size_t MinBucketSize = (size_t)1 << MinBucketSizeExp;
-    if (Size < MinBucketSize) {
+    NumShards = std::max<size_t>(Shard, 1);
+#endif
+}
+
+size_t DisjointPool::AllocImpl::getShard() {
+    if (NumShards == 1) {
         return 0;
     }
 
-    // Get the position of the leftmost set bit.
-    size_t position = getLeftmostSetBitPos(Size);
+#ifndef UMF_NO_HWLOC
+    size_t Cpu = currentCpu();
+    return Cpu < CpuToShard.size() ? CpuToShard[Cpu] : 0;
+#else
+    return 0;
+#endif
+}
 
-    auto isPowerOf2 = 0 == (Size & (Size - 1));
-    auto largerThanHalfwayBetweenPowersOf2 =
-        !isPowerOf2 && bool((Size - 1) & (uint64_t(1) << (position - 1)));
-    auto index = (position - MinBucketSizeExp) * 2 + (int)(!isPowerOf2) +
-                 (int)largerThanHalfwayBetweenPowersOf2;
+// Return the key of the lookup range the size belongs to. Sizes up to
+// 2^BucketLookupPrecision have a range each, larger sizes are split into
+// 2^BucketLookupPrecision ranges per doubling. The ranges are
+// (Pow2 + i * Width, Pow2 + (i + 1) * Width], so that a bucket size is
+// always the largest size of its range for power of 2 ClassesPerDoubling.
+static size_t bucketLookupKey(size_t Size) {
+    constexpr size_t Ranges = (size_t)1 << BucketLookupPrecision;
+    size_t X = Size - 1;
+    if (X < Ranges) {
+        return X;
+    }
 
-    return index;
+    size_t Position = getLeftmostSetBitPos(X);
+    size_t Shift = Position - BucketLookupPrecision;
+    return (Shift + 1) * Ranges + ((X >> Shift) & (Ranges - 1));
 }
 
-Bucket &DisjointPool::AllocImpl::findBucket(size_t Size) {
+void DisjointPool::AllocImpl::createBucketLookup() {
+    BucketLookup.resize(bucketLookupKey(CutOff) + 1);
+
+    // Walk the keys in increasing order, each key starts at the smallest
+    // size mapping to it.
+    size_t Idx = 0;
+    size_t Key = 0;
+    for (size_t Size = 1; Size <= CutOff;) {
+        while (Buckets[Idx]->getSize() < Size) {
+            Idx++;
+        }
+        BucketLookup[Key] = Idx;
+
+        // Find the first size of the next key
+        size_t Width = 1;
+        if (Size > ((size_t)1 << BucketLookupPrecision)) {
+            Width = (size_t)1 << (getLeftmostSetBitPos(Size - 1) -
+                                  BucketLookupPrecision);
+        }
+        Size += Width;
+        Key++;
+    }
+    assert(Key == BucketLookup.size());
+}
+
+std::size_t DisjointPool::AllocImpl::sizeToIdx(size_t Size) {
+    assert(Size <= CutOff && "Unexpected size");
+    assert(Size > 0 && "Unexpected size");
+
+    auto Idx = BucketLookup[bucketLookupKey(Size)];
+
+    // Explicit BucketSizes may put several buckets into one lookup range.
+    // Generated bucket sizes always end a range, so this loop is never
+    // taken for them.
+    while (Buckets[Idx]->getSize() < Size) {
+        Idx++;
+    }
+
+    return Idx;
+}
+
+Bucket &DisjointPool::AllocImpl::findBucket(size_t Size, size_t Shard) {
     auto calculatedIdx = sizeToIdx(Size);
     assert((*(Buckets[calculatedIdx])).getSize() >= Size);
     if (calculatedIdx > 0) {
         assert((*(Buckets[calculatedIdx - 1])).getSize() < Size);
     }
 
-    return *(Buckets[calculatedIdx]);
+    return *(Buckets[Shard * NumBucketSizes + calculatedIdx]);
 }
 
-void DisjointPool::AllocImpl::deallocate(void *Ptr, bool &ToPool) {
-    auto *SlabPtr = AlignPtrDown(Ptr, SlabMinSize());
+void DisjointPool::AllocImpl::createAlignedBucketLookup() {
+    // A chunk at offset i * BucketSize of a slab aligned to SlabAlignment
+    // is aligned to the lowest set bit of BucketSize. A bucket used for
+    // whole slabs is aligned to SlabAlignment.
+    size_t NumAlignments = getLeftmostSetBitPos(SlabAlignment) + 1;
+    AlignedBucketLookup.assign(NumAlignments,
+                               std::vector<size_t>(NumBucketSizes));
+    for (size_t Log = 0; Log < NumAlignments; Log++) {
+        size_t Alignment = (size_t)1 << Log;
+        size_t Next = NumBucketSizes - 1;
+        for (size_t Idx = NumBucketSizes; Idx-- > 0;) {
+            auto &B = *Buckets[Idx];
+            if (B.getSize() % Alignment == 0 ||
+                B.getSize() > B.ChunkCutOff()) {
+                Next = Idx;
+            }
+            AlignedBucketLookup[Log][Idx] = Next;
+        }
+    }
+}
 
-    // Lock the map on read
-    std::shared_lock<std::shared_timed_mutex> Lk(getKnownSlabsMapLock());
+Bucket &DisjointPool::AllocImpl::findAlignedBucket(size_t Size,
+                                                   size_t Alignment,
+                                                   size_t Shard) {
+    assert(Alignment <= SlabAlignment);
+    auto Idx = AlignedBucketLookup[getLeftmostSetBitPos(Alignment)]
+                                  [sizeToIdx(Size)];
+    return *(Buckets[Shard * NumBucketSizes + Idx]);
+}
 
-    ToPool = false;
-    auto Slabs = getKnownSlabs().equal_range(SlabPtr);
-    if (Slabs.first == Slabs.second) {
-        Lk.unlock();
-        memoryProviderFree(getMemHandle(), Ptr);
+void DisjointPool::AllocImpl::decay(DecayClock::time_point Now) {
+    for (auto &B : Buckets) {
+        B->decay(Now, getDecayAge());
+    }
+
+    if (LargeCache) {
+        std::lock_guard<std::mutex> Lg(LargeCacheLock);
+        releaseAgedLargeExtents(Now);
+    }
+}
+
+void DisjointPool::AllocImpl::decayThread() {
+    std::unique_lock<std::mutex> Lock(DecayLock);
+    while (!DecayCond.wait_for(Lock, getDecayInterval(),
+                               [this] { return DecayStop; })) {
+        decay(DecayClock::now());
+    }
+}
+
+ThreadCache &DisjointPool::AllocImpl::getThreadCache() {
+    auto *Cache = LocalThreadCaches.find(this);
+    if (Cache) {
+        return *Cache;
+    }
+
+    return LocalThreadCaches.create(this, Buckets.size());
+}
+
+void *DisjointPool::AllocImpl::getCachedChunk(Bucket &Bucket, bool &FromPool,
+                                              bool &Fresh) {
+    auto &Cache = getThreadCache();
+    auto Idx = Bucket.getIdx();
+    auto &Chunks = Cache.Buckets[Idx];
+
+    if (Chunks.empty()) {
+        Chunks.reserve(params.ThreadCacheCapacity);
+        Bucket.getChunks(Chunks, threadCacheBatch(), FromPool);
+    } else {
+        FromPool = true;
+    }
+
+    incrementCounter(Cache.Stats[Idx].AllocCount);
+    if (FromPool) {
+        incrementCounter(Cache.Stats[Idx].AllocPoolCount);
+    }
+
+    void *Ptr = Chunks.back().Ptr;
+    Fresh = Chunks.back().Fresh;
+    Chunks.pop_back();
+    return Ptr;
+}
+
+void DisjointPool::AllocImpl::freeCachedChunk(void *Ptr, Slab &Slab,
+                                              bool &ToPool) {
+    auto &Bucket = Slab.getBucket();
+    if (Bucket.getShard() != getShard()) {
+        // Memory of another NUMA node goes straight back to its shard
+        // instead of being handed out to the threads of this node.
+        Bucket.countFree();
+        freeChunk(Ptr, Slab, ToPool);
         return;
     }
 
-    for (auto It = Slabs.first; It != Slabs.second; ++It) {
-        // The slab object won't be deleted until it's removed from the map which is
-        // protected by the lock, so it's safe to access it here.
-        auto &Slab = It->second;
-        if (Ptr >= Slab.getPtr() && Ptr < Slab.getEnd()) {
-            // Unlock the map before freeing the chunk, it may be locked on write
-            // there
-            Lk.unlock();
-            auto &Bucket = Slab.getBucket();
+    auto &Cache = getThreadCache();
+    auto Idx = Bucket.getIdx();
+    auto &Chunks = Cache.Buckets[Idx];
+
+    incrementCounter(Cache.Stats[Idx].FreeCount);
+
+    ToPool = true;
+    if (Chunks.size() >= params.ThreadCacheCapacity) {
+        // Give back the oldest chunks, the most recently freed ones are the
+        // most likely to be still in the CPU cache.
+        size_t Batch = std::min(threadCacheBatch(), Chunks.size());
+        Bucket.freeChunks(Chunks.data(), Batch, ToPool);
+        Chunks.erase(Chunks.begin(), Chunks.begin() + Batch);
+    }
+
+    Chunks.push_back({Ptr, &Slab, false});
+}
 
-            if (getParams().PoolTrace > 1) {
-                Bucket.countFree();
+void DisjointPool::AllocImpl::flushThreadCache(ThreadCache &Cache) {
+    for (size_t i = 0; i < Cache.Buckets.size(); i++) {
+        auto &Chunks = Cache.Buckets[i];
+        if (!Chunks.empty()) {
+            bool ToPool;
+            Buckets[i]->freeChunks(Chunks.data(), Chunks.size(), ToPool);
+            Chunks.clear();
+        }
+    }
+}
+
+void DisjointPool::AllocImpl::registerThreadCache(ThreadCache &Cache) {
+    ThreadCaches.push_back(&Cache);
+}
+
+void DisjointPool::AllocImpl::unregisterThreadCache(ThreadCache &Cache) {
+    flushThreadCache(Cache);
+    for (size_t i = 0; i < Buckets.size(); i++) {
+        Buckets[i]->addCounters(Cache.Stats[i]);
+    }
+    ThreadCaches.erase(
+        std::find(ThreadCaches.begin(), ThreadCaches.end(), &Cache));
+    Cache.Pool.store(nullptr, std::memory_order_relaxed);
+}
+
+void DisjointPool::AllocImpl::detachThreadCaches() {
+    std::lock_guard<std::mutex> Lg(ThreadCacheRegistryLock());
+    for (auto *Cache : ThreadCaches) {
+        flushThreadCache(*Cache);
+        Cache->Pool.store(nullptr, std::memory_order_relaxed);
+    }
+    ThreadCaches.clear();
+}
+
+Slab *DisjointPool::AllocImpl::findSlab(void *Ptr) {
+    uintptr_t SlabAddr;
+    void *Value;
+
+    // Find the slab with the highest start address not above Ptr.
+    if (!critnib_find(KnownSlabs, reinterpret_cast<uintptr_t>(Ptr), FIND_LE,
+                      &SlabAddr, &Value)) {
+        return nullptr;
+    }
+
+    // The found slab can be destroyed concurrently unless Ptr, which is
+    // a live allocation, lies inside of it. Every slab is at least
+    // SlabMinSize and at most MaxSlabSize bytes long, so in most cases
+    // the address alone tells whether it does, without touching the slab.
+    size_t Offset = reinterpret_cast<uintptr_t>(Ptr) - SlabAddr;
+    if (Offset < SlabMinSize()) {
+        return static_cast<Slab *>(Value);
+    }
+    if (Offset >= MaxSlabSize) {
+        return nullptr;
+    }
+
+    // Otherwise check the bounds kept in the slab's record, which stays
+    // readable even if the slab is being destroyed. If Ptr lies inside
+    // of it, the slab holds a live allocation and cannot be destroyed.
+    auto *FoundSlab = static_cast<Slab *>(Value);
+    if (FoundSlab->getRecordHeader()->contains(
+            reinterpret_cast<uintptr_t>(Ptr))) {
+        return FoundSlab;
+    }
+
+    return nullptr;
+}
+
+SlabRecordHeader *DisjointPool::AllocImpl::getSlabRecord() {
+    {
+        std::lock_guard<std::mutex> Lg(FreeSlabRecordsLock);
+        if (auto *Record = FreeSlabRecords) {
+            FreeSlabRecords = Record->NextFree;
+            return Record;
+        }
+    }
+
+    void *Record = umf_ba_alloc(SlabRecords);
+    if (!Record) {
+        return nullptr;
+    }
+
+    return new (Record) SlabRecordHeader;
+}
+
+void DisjointPool::AllocImpl::putSlabRecord(SlabRecordHeader *Record) {
+    std::lock_guard<std::mutex> Lg(FreeSlabRecordsLock);
+    Record->NextFree = FreeSlabRecords;
+    FreeSlabRecords = Record;
+}
+
+bool DisjointPool::AllocImpl::createLargeCache() {
+    LargeExtentRecords = umf_ba_create(sizeof(LargeExtent));
+    if (!LargeExtentRecords) {
+        return false;
+    }
+
+    LargeCache = ravl_new(compareLargeExtents);
+    if (!LargeCache) {
+        umf_ba_destroy(LargeExtentRecords);
+        LargeExtentRecords = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+void DisjointPool::AllocImpl::destroyLargeCache() {
+    if (!LargeCache) {
+        return;
+    }
+
+    while (OldestLargeExtent) {
+        releaseLargeExtent(*OldestLargeExtent);
+    }
+
+    ravl_delete(LargeCache);
+    umf_ba_destroy(LargeExtentRecords);
+    LargeCache = nullptr;
+    LargeExtentRecords = nullptr;
+}
+
+int DisjointPool::AllocImpl::compareLargeExtents(const void *Lhs,
+                                                 const void *Rhs) {
+    auto *L = static_cast<const LargeExtent *>(Lhs);
+    auto *R = static_cast<const LargeExtent *>(Rhs);
+    if (L->Size != R->Size) {
+        return L->Size < R->Size ? -1 : 1;
+    }
+
+    auto LAddr = reinterpret_cast<uintptr_t>(L->Ptr);
+    auto RAddr = reinterpret_cast<uintptr_t>(R->Ptr);
+    if (LAddr != RAddr) {
+        return LAddr < RAddr ? -1 : 1;
+    }
+
+    return 0;
+}
+
+void *DisjointPool::AllocImpl::getCachedLarge(size_t Size,
+                                              size_t Alignment) {
+    // Cached extents are only known to be aligned to the page size.
+    if (!params.LargeCacheSize || Alignment > ProviderMinPageSize) {
+        return nullptr;
+    }
+
+    std::lock_guard<std::mutex> Lg(LargeCacheLock);
+    releaseAgedLargeExtents(DecayClock::now());
+
+    // Best fit: the smallest extent large enough, at the lowest address
+    LargeExtent Key = {nullptr, Size, {}, nullptr, nullptr};
+    auto *Node = ravl_find(LargeCache, &Key, RAVL_PREDICATE_GREATER_EQUAL);
+    if (!Node) {
+        LargeCacheStats.Misses++;
+        return nullptr;
+    }
+
+    auto &Extent = *static_cast<LargeExtent *>(ravl_data(Node));
+    void *Ptr = Extent.Ptr;
+    size_t ExtentSize = Extent.Size;
+    size_t Head = ProviderMinPageSize ? AlignUp(Size, ProviderMinPageSize)
+                                      : Size;
+    if (Head < ExtentSize) {
+        // Keep the tail cached if the provider can split the extent. It
+        // reuses the record and stays as old as the extent was.
+        auto ret = umfMemoryProviderAllocationSplit(MemHandle, Ptr,
+                                                    ExtentSize, Head);
+        if (ret == UMF_RESULT_SUCCESS) {
+            ravl_remove(LargeCache, Node);
+            Extent.Ptr = static_cast<char *>(Ptr) + Head;
+            Extent.Size = ExtentSize - Head;
+            LargeCacheStats.CachedBytes -= Head;
+            LargeCacheStats.Hits++;
+
+            if (ravl_insert(LargeCache, &Extent) != 0) {
+                // No memory to index the tail, give it back instead.
+                releaseLargeExtent(Extent);
             }
+            return Ptr;
+        }
+
+        // Do not waste more than the request on an unsplittable extent.
+        if (ExtentSize / 2 > Size) {
+            LargeCacheStats.Misses++;
+            return nullptr;
+        }
+    }
+
+    removeLargeExtent(Extent);
+    LargeCacheStats.Hits++;
+    return Ptr;
+}
 
-            VALGRIND_DO_MEMPOOL_FREE(this, Ptr);
-            annotate_memory_inaccessible(Ptr, Bucket.getSize());
-            if (Bucket.getSize() <= Bucket.ChunkCutOff()) {
-                Bucket.freeChunk(Ptr, Slab, ToPool);
+void *DisjointPool::AllocImpl::allocateLarge(size_t Size, size_t Alignment,
+                                             bool *Zeroed) {
+    void *Ptr = getCachedLarge(Size, Alignment);
+    if (Ptr) {
+        if (Zeroed) {
+            *Zeroed = false;
+        }
+    } else {
+        Ptr = memoryProviderAlloc(getMemHandle(), Size, Alignment);
+        if (Zeroed) {
+            *Zeroed = getParams().ProviderZeroesMemory;
+        }
+    }
+
+    annotate_memory_undefined(Ptr, Size);
+    return Ptr;
+}
+
+void DisjointPool::AllocImpl::freeLarge(void *Ptr) {
+    umf_alloc_info_t AllocInfo = {NULL, 0, NULL};
+    if (!Ptr || !params.LargeCacheSize ||
+        umfMemoryTrackerGetAllocInfo(Ptr, &AllocInfo) != UMF_RESULT_SUCCESS ||
+        AllocInfo.base != Ptr || AllocInfo.baseSize > params.LargeCacheSize) {
+        memoryProviderFree(getMemHandle(), Ptr);
+        return;
+    }
+
+    auto *Record = umf_ba_alloc(LargeExtentRecords);
+    if (!Record) {
+        memoryProviderFree(getMemHandle(), Ptr);
+        return;
+    }
+
+    auto Now = DecayClock::now();
+    auto *Extent = new (Record)
+        LargeExtent{Ptr, AllocInfo.baseSize, Now, nullptr, nullptr};
+
+    {
+        std::lock_guard<std::mutex> Lg(LargeCacheLock);
+        releaseAgedLargeExtents(Now);
+        if (ravl_insert(LargeCache, Extent) == 0) {
+            annotate_memory_inaccessible(Ptr, AllocInfo.baseSize);
+
+            Extent->Prev = NewestLargeExtent;
+            if (NewestLargeExtent) {
+                NewestLargeExtent->Next = Extent;
             } else {
-                Bucket.freeSlab(Slab, ToPool);
+                OldestLargeExtent = Extent;
             }
+            NewestLargeExtent = Extent;
+            LargeCacheStats.CachedBytes += Extent->Size;
+            LargeCacheStats.CachedExtents++;
 
+            // Evict the least recently freed extents above the cap.
+            while (LargeCacheStats.CachedBytes > params.LargeCacheSize) {
+                releaseLargeExtent(*OldestLargeExtent);
+            }
             return;
         }
     }
 
-    Lk.unlock();
-    // There is a rare case when we have a pointer from system allocation next
-    // to some slab with an entry in the map. So we find a slab
-    // but the range checks fail.
+    umf_ba_free(LargeExtentRecords, Extent);
     memoryProviderFree(getMemHandle(), Ptr);
 }
 
+void DisjointPool::AllocImpl::removeLargeExtent(LargeExtent &Extent) {
+    // The extent is not indexed if its tail could not be reinserted
+    // (see getCachedLarge()).
+    auto *Node = ravl_find(LargeCache, &Extent, RAVL_PREDICATE_EQUAL);
+    if (Node) {
+        ravl_remove(LargeCache, Node);
+    }
+
+    if (Extent.Prev) {
+        Extent.Prev->Next = Extent.Next;
+    } else {
+        OldestLargeExtent = Extent.Next;
+    }
+    if (Extent.Next) {
+        Extent.Next->Prev = Extent.Prev;
+    } else {
+        NewestLargeExtent = Extent.Prev;
+    }
+
+    LargeCacheStats.CachedBytes -= Extent.Size;
+    LargeCacheStats.CachedExtents--;
+    umf_ba_free(LargeExtentRecords, &Extent);
+}
+
+void DisjointPool::AllocImpl::releaseLargeExtent(LargeExtent &Extent) {
+    void *Ptr = Extent.Ptr;
+    LargeCacheStats.ReleasedBytes += Extent.Size;
+    removeLargeExtent(Extent);
+
+    // The extent is released on behalf of another allocation or free,
+    // which must not fail because of it.
+    try {
+        memoryProviderFree(getMemHandle(), Ptr);
+    } catch (MemoryProviderError &e) {
+        LOG_ERR("DisjointPool: error from memory provider: %d", e.code);
+    }
+}
+
+void DisjointPool::AllocImpl::releaseAgedLargeExtents(
+    DecayClock::time_point Now) {
+    if (!params.LargeCacheDecayMs) {
+        return;
+    }
+
+    // Start from the oldest until one is too young.
+    auto Age = std::chrono::milliseconds(params.LargeCacheDecayMs);
+    while (OldestLargeExtent && Now - OldestLargeExtent->FreedAt >= Age) {
+        releaseLargeExtent(*OldestLargeExtent);
+    }
+}
+
+void DisjointPool::AllocImpl::getLargeCacheStats(
+    umf_disjoint_pool_large_cache_stats_t *Stats) {
+    std::lock_guard<std::mutex> Lg(LargeCacheLock);
+    *Stats = LargeCacheStats;
+}
+
+void DisjointPool::AllocImpl::deallocate(void *Ptr, bool &ToPool) {
+    ToPool = false;
+
+    tickDecay();
+
+    auto *FoundSlab = findSlab(Ptr);
+    if (!FoundSlab) {
+        // There is a rare case when we have a pointer from system allocation
+        // next to some slab. So we find a slab but the range checks fail.
+        freeLarge(Ptr);
+        return;
+    }
+
+    auto &Slab = *FoundSlab;
+    auto &Bucket = Slab.getBucket();
+
+    VALGRIND_DO_MEMPOOL_FREE(this, Ptr);
+    annotate_memory_inaccessible(Ptr, Bucket.getSize());
+    if (Bucket.getSize() > Bucket.ChunkCutOff()) {
+        Bucket.countFree();
+        Bucket.freeSlab(Slab, ToPool);
+    } else if (getParams().ThreadCacheCapacity) {
+        // Counted in the thread cache
+        freeCachedChunk(Ptr, Slab, ToPool);
+    } else {
+        Bucket.countFree();
+        freeChunk(Ptr, Slab, ToPool);
+    }
+}
+
+void DisjointPool::AllocImpl::freeChunk(void *Ptr, Slab &Slab, bool &ToPool) {
+    auto &Bucket = Slab.getBucket();
+    if (getParams().RemoteFrees &&
+        Bucket.getSize() % alignof(uintptr_t) == 0 &&
+        Slab.Owner.load(std::memory_order_relaxed) != threadToken()) {
+        ToPool = true;
+        Bucket.freeRemoteChunk(Ptr, Slab);
+    } else {
+        Bucket.freeChunk(Ptr, Slab, ToPool);
+    }
+}
+
+size_t DisjointPool::AllocImpl::getUsableSize(void *Ptr) {
+    auto *FoundSlab = findSlab(Ptr);
+    if (!FoundSlab) {
+        umf_alloc_info_t AllocInfo = {NULL, 0, NULL};
+        if (umfMemoryTrackerGetAllocInfo(Ptr, &AllocInfo) !=
+            UMF_RESULT_SUCCESS) {
+            return 0;
+        }
+        return static_cast<char *>(AllocInfo.base) + AllocInfo.baseSize -
+               static_cast<char *>(Ptr);
+    }
+
+    auto &Bucket = FoundSlab->getBucket();
+    char *End = static_cast<char *>(FoundSlab->getEnd());
+    if (Bucket.getSize() <= Bucket.ChunkCutOff()) {
+        // Even if the pointer was aligned up, it is still inside its chunk.
+        size_t ChunkIdx = (static_cast<char *>(Ptr) -
+                           static_cast<char *>(FoundSlab->getPtr())) /
+                          Bucket.getSize();
+        End = static_cast<char *>(FoundSlab->getPtr()) +
+              (ChunkIdx + 1) * Bucket.getSize();
+    }
+
+    return End - static_cast<char *>(Ptr);
+}
+
+bool DisjointPool::AllocImpl::growInPlace(void *Ptr, size_t OldSize,
+                                          size_t NewSize) {
+    if (!ProviderCanMerge.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    // The counters are only a heuristic, so the races between threads
+    // updating them are harmless.
+    size_t Skips = GrowInPlaceSkips.load(std::memory_order_relaxed);
+    if (Skips) {
+        GrowInPlaceSkips.store(Skips - 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t TailSize = NewSize - OldSize;
+    if (ProviderMinPageSize) {
+        TailSize = AlignUp(TailSize, ProviderMinPageSize);
+    }
+
+    void *Tail;
+    if (umfMemoryProviderAlloc(getMemHandle(), TailSize, 0, &Tail) !=
+        UMF_RESULT_SUCCESS) {
+        return false;
+    }
+
+    if (Tail == static_cast<char *>(Ptr) + OldSize) {
+        auto ret = umfMemoryProviderAllocationMerge(getMemHandle(), Ptr, Tail,
+                                                    OldSize + TailSize);
+        if (ret == UMF_RESULT_SUCCESS) {
+            annotate_memory_undefined(Tail, TailSize);
+            GrowInPlaceMisses.store(0, std::memory_order_relaxed);
+            return true;
+        }
+        if (ret == UMF_RESULT_ERROR_NOT_SUPPORTED) {
+            ProviderCanMerge.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    umfMemoryProviderFree(getMemHandle(), Tail, TailSize);
+
+    size_t Misses = GrowInPlaceMisses.load(std::memory_order_relaxed) + 1;
+    GrowInPlaceMisses.store(Misses, std::memory_order_relaxed);
+    GrowInPlaceSkips.store(
+        (size_t(1) << std::min(Misses, MaxGrowInPlaceSkipsLog2)) - 1,
+        std::memory_order_relaxed);
+    return false;
+}
+
+void *DisjointPool::AllocImpl::reallocate(void *Ptr, size_t Size) try {
+    bool FromPool, ToPool;
+
+    if (!Ptr) {
+        return allocate(Size, FromPool);
+    }
+
+    if (Size == 0) {
+        deallocate(Ptr, ToPool);
+        return nullptr;
+    }
+
+    auto *FoundSlab = findSlab(Ptr);
+    size_t OldSize = getUsableSize(Ptr);
+    if (Size <= OldSize) {
+        // Stay in the chunk or slab if Size maps to the same bucket, and
+        // in the provider allocation if at most half of it goes unused.
+        // Otherwise move, so that the larger block can be reclaimed.
+        bool InPlace;
+        if (FoundSlab) {
+            InPlace = Size > getParams().MaxPoolableSize ||
+                      findBucket(Size, 0).getSize() ==
+                          FoundSlab->getBucket().getSize();
+        } else {
+            InPlace = Size > OldSize / 2;
+        }
+
+        if (InPlace) {
+            return Ptr;
+        }
+    } else if (!FoundSlab && growInPlace(Ptr, OldSize, Size)) {
+        return Ptr;
+    }
+
+    void *NewPtr = allocate(Size, FromPool);
+    if (!NewPtr) {
+        return nullptr;
+    }
+
+    std::memcpy(NewPtr, Ptr, std::min(OldSize, Size));
+
+    // The data already lives in NewPtr, so failing to free the old block
+    // must not fail the realloc (and leak NewPtr).
+    try {
+        deallocate(Ptr, ToPool);
+    } catch (MemoryProviderError &e) {
+        LOG_ERR("DisjointPool: error from memory provider: %d", e.code);
+    }
+    return NewPtr;
+} catch (MemoryProviderError &e) {
+    umf::getPoolLastStatusRef<DisjointPool>() = e.code;
+    return nullptr;
+}
+
 void DisjointPool::AllocImpl::printStats(bool &TitlePrinted,
                                          size_t &HighBucketSize,
                                          size_t &HighPeakSlabsInUse,
                                          const std::string &MTName) {
     HighBucketSize = 0;
     HighPeakSlabsInUse = 0;
-    for (auto &B : Buckets) {
-        (*B).printStats(TitlePrinted, MTName);
-        HighPeakSlabsInUse = std::max((*B).maxSlabsInUse, HighPeakSlabsInUse);
-        if ((*B).allocCount) {
-            HighBucketSize = std::max((*B).SlabAllocSize(), HighBucketSize);
+
+    size_t NumBuckets = Buckets.size();
+    std::vector<umf_disjoint_pool_bucket_stats_t> Stats(NumBuckets);
+    getStats(Stats.data(), &NumBuckets);
+
+    for (auto &BucketStats : Stats) {
+        printBucketStats(BucketStats, TitlePrinted, MTName);
+        HighPeakSlabsInUse =
+            std::max(BucketStats.MaxSlabsInUse, HighPeakSlabsInUse);
+        if (BucketStats.AllocCount) {
+            HighBucketSize = std::max(BucketStats.SlabSize, HighBucketSize);
+        }
+    }
+}
+
+void DisjointPool::AllocImpl::getStats(umf_disjoint_pool_bucket_stats_t *Stats,
+                                       size_t *NumBuckets) {
+    size_t Count = Stats ? std::min(*NumBuckets, Buckets.size()) : 0;
+    *NumBuckets = Buckets.size();
+
+    for (size_t i = 0; i < Count; i++) {
+        Buckets[i]->getStats(Stats[i]);
+    }
+
+    if (!Count || !params.ThreadCacheCapacity) {
+        return;
+    }
+
+    // Add the counters of the live thread caches
+    constexpr auto Relaxed = std::memory_order_relaxed;
+    std::lock_guard<std::mutex> Lg(ThreadCacheRegistryLock());
+    for (auto *Cache : ThreadCaches) {
+        for (size_t i = 0; i < Count; i++) {
+            auto &Counters = Cache->Stats[i];
+            Stats[i].AllocCount += Counters.AllocCount.load(Relaxed);
+            Stats[i].AllocPoolCount += Counters.AllocPoolCount.load(Relaxed);
+            Stats[i].FreeCount += Counters.FreeCount.load(Relaxed);
         }
     }
 }
@@ -1027,7 +2762,12 @@ umf_result_t DisjointPool::initialize(umf_memory_provider_handle_t provider,
         return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
 
-    impl = std::make_unique<AllocImpl>(provider, parameters);
+    try {
+        impl = std::make_unique<AllocImpl>(provider, parameters);
+    } catch (MemoryProviderError &e) {
+        return e.code;
+    }
+
     return UMF_RESULT_SUCCESS;
 }
 
@@ -1045,16 +2785,27 @@ void *DisjointPool::malloc(size_t size) { // For full-slab allocations indicates
     return Ptr;
 }
 
-void *DisjointPool::calloc(size_t, size_t) {
-    // Not supported
-    umf::getPoolLastStatusRef<DisjointPool>() = UMF_RESULT_ERROR_NOT_SUPPORTED;
-    return NULL;
+void *DisjointPool::calloc(size_t num, size_t size) {
+    if (num && size > (std::numeric_limits<size_t>::max)() / num) {
+        umf::getPoolLastStatusRef<DisjointPool>() =
+            UMF_RESULT_ERROR_INVALID_ARGUMENT;
+        return NULL;
+    }
+
+    bool FromPool, Zeroed = false;
+    auto Ptr = impl->allocate(num * size, FromPool, &Zeroed);
+
+    // Memory that was never used since it came from a provider that
+    // returns zero-filled memory does not have to be cleared.
+    if (Ptr && !Zeroed) {
+        std::memset(Ptr, 0, num * size);
+    }
+
+    return Ptr;
 }
 
-void *DisjointPool::realloc(void *, size_t) {
-    // Not supported
-    umf::getPoolLastStatusRef<DisjointPool>() = UMF_RESULT_ERROR_NOT_SUPPORTED;
-    return NULL;
+void *DisjointPool::realloc(void *ptr, size_t size) {
+    return impl->reallocate(ptr, size);
 }
 
 void *DisjointPool::aligned_malloc(size_t size, size_t alignment) {
@@ -1071,9 +2822,12 @@ void *DisjointPool::aligned_malloc(size_t size, size_t alignment) {
     return Ptr;
 }
 
-size_t DisjointPool::malloc_usable_size(void *) {
-    // Not supported
-    return 0;
+size_t DisjointPool::malloc_usable_size(void *ptr) {
+    if (ptr == nullptr) {
+        return 0;
+    }
+
+    return impl->getUsableSize(ptr);
 }
 
 umf_result_t DisjointPool::free(void *ptr) try {
@@ -1098,6 +2852,16 @@ umf_result_t DisjointPool::get_last_allocation_error() {
     return umf::getPoolLastStatusRef<DisjointPool>();
 }
 
+void DisjointPool::getLargeCacheStats(
+    umf_disjoint_pool_large_cache_stats_t *Stats) {
+    impl->getLargeCacheStats(Stats);
+}
+
+void DisjointPool::getStats(umf_disjoint_pool_bucket_stats_t *Stats,
+                            size_t *NumBuckets) {
+    impl->getStats(Stats, NumBuckets);
+}
+
 DisjointPool::DisjointPool() {}
 
 // Define destructor for use with unique_ptr
@@ -1105,7 +2869,8 @@ DisjointPool::~DisjointPool() {
     bool TitlePrinted = false;
     size_t HighBucketSize;
     size_t HighPeakSlabsInUse;
-    if (impl->getParams().PoolTrace > 1) {
+    // impl is not set if initialize() failed
+    if (impl && impl->getParams().PoolTrace > 1) {
         auto name = impl->getParams().Name;
         try { // cannot throw in destructor
             impl->printStats(TitlePrinted, HighBucketSize, HighPeakSlabsInUse,
@@ -1118,6 +2883,12 @@ DisjointPool::~DisjointPool() {
                           << std::string(name + 1) << ":" << HighBucketSize
                           << "," << HighPeakSlabsInUse << ",64K" << std::endl;
             }
+            if (impl->getParams().LargeCacheSize) {
+                umf_disjoint_pool_large_cache_stats_t LargeStats;
+                impl->getLargeCacheStats(&LargeStats);
+                std::cout << "Large Cache Hits " << LargeStats.Hits << " of "
+                          << LargeStats.Hits + LargeStats.Misses << std::endl;
+            }
         } catch (...) { // ignore exceptions
         }
     }
@@ -1129,3 +2900,29 @@ static umf_memory_pool_ops_t UMF_DISJOINT_POOL_OPS =
 umf_memory_pool_ops_t *umfDisjointPoolOps(void) {
     return &UMF_DISJOINT_POOL_OPS;
 }
+
+umf_result_t umfDisjointPoolGetStats(umf_memory_pool_handle_t hPool,
+                                     umf_disjoint_pool_bucket_stats_t *Stats,
+                                     size_t *NumBuckets) {
+    if (!hPool || !NumBuckets ||
+        hPool->ops.initialize != UMF_DISJOINT_POOL_OPS.initialize) {
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    auto *Pool = static_cast<DisjointPool *>(hPool->pool_priv);
+    Pool->getStats(Stats, NumBuckets);
+    return UMF_RESULT_SUCCESS;
+}
+
+umf_result_t umfDisjointPoolGetLargeCacheStats(
+    umf_memory_pool_handle_t hPool,
+    umf_disjoint_pool_large_cache_stats_t *Stats) {
+    if (!hPool || !Stats ||
+        hPool->ops.initialize != UMF_DISJOINT_POOL_OPS.initialize) {
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    auto *Pool = static_cast<DisjointPool *>(hPool->pool_priv);
+    Pool->getLargeCacheStats(Stats);
+    return UMF_RESULT_SUCCESS;
+}
@@ -14,20 +14,39 @@
 
 #include <umf/providers/provider_coarse.h>
 
+#include "base_alloc.h"
 #include "base_alloc_global.h"
+#include "critnib.h"
+#include "decay_clock.h"
 #include "memory_provider_internal.h"
 #include "ravl.h"
 #include "utils_common.h"
 #include "utils_concurrency.h"
 #include "utils_log.h"
+#include "utils_math.h"
 
 #define COARSE_BASE_NAME "coarse"
 
+// Parameters of the two-level segregated-fit index of free blocks
+// (UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT):
+// the first level splits sizes by powers of 2,
+// the second level splits every power of 2 range into TLSF_SL_COUNT classes.
+#define TLSF_SL_LOG2 4
+#define TLSF_SL_COUNT (1 << TLSF_SL_LOG2)
+#define TLSF_FL_COUNT (sizeof(size_t) * 8 - TLSF_SL_LOG2 + 1)
+
 #define IS_ORIGIN_OF_BLOCK(origin, block)                                      \
     (((uintptr_t)(block)->data >= (uintptr_t)(origin)->data) &&                \
      ((uintptr_t)(block)->data + (block)->size <=                              \
       (uintptr_t)(origin)->data + (origin)->size))
 
+// The state of the physical memory of a free block.
+typedef enum block_purge_state_t {
+    BLOCK_NOT_PURGED = 0,
+    BLOCK_PURGED_LAZY,
+    BLOCK_PURGED_FORCE,
+} block_purge_state_t;
+
 typedef struct coarse_memory_provider_t {
     umf_memory_provider_handle_t upstream_memory_provider;
 
@@ -42,6 +61,38 @@ typedef struct coarse_memory_provider_t {
     size_t used_size;
     size_t alloc_size;
 
+    // number of allocations requested from the upstream provider
+    size_t num_upstream_calls;
+
+    // growth policy of memory allocated from the upstream provider
+    // (see coarse_memory_provider_params_t): size of the next upstream chunk
+    // (0 means allocating exactly the size needed), its growth factor
+    // and its maximum size (0 means no limit)
+    size_t upstream_chunk_size;
+    size_t upstream_chunk_growth_factor;
+    size_t max_upstream_chunk_size;
+
+    // trimming policy (see coarse_memory_provider_params_t):
+    // entirely free upstream blocks are returned to the upstream provider
+    // when the free memory exceeds trim_threshold (0 means never),
+    // but at least trim_retained_size bytes of free memory are kept
+    size_t trim_threshold;
+    size_t trim_retained_size;
+
+    // decay of large free blocks (see coarse_memory_provider_params_t):
+    // free blocks of at least purge_min_size bytes (0 means never)
+    // are purged after purge_lazy_delay_ms and purge_force_delay_ms
+    size_t purge_min_size;
+    uint64_t purge_lazy_delay_ms;
+    uint64_t purge_force_delay_ms;
+    size_t purge_page_size;
+
+    // decay_head, decay_tail - FIFO queues of free blocks waiting
+    // for the lazy ([BLOCK_NOT_PURGED]) and the forced ([BLOCK_PURGED_LAZY])
+    // purge, sorted by block_t->free_since
+    struct block_t *decay_head[BLOCK_PURGED_FORCE];
+    struct block_t *decay_tail[BLOCK_PURGED_FORCE];
+
     // upstream_blocks - tree of all blocks allocated from the upstream provider
     struct ravl *upstream_blocks;
 
@@ -51,8 +102,20 @@ typedef struct coarse_memory_provider_t {
     // free_blocks - tree of free blocks - sorted by a size of data,
     // each node contains a pointer (ravl_free_blocks_head_t)
     // to the head of the list of free blocks of the same size
+    // (not used by UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT)
     struct ravl *free_blocks;
 
+    // free_index - segregated-fit index of free blocks
+    // (used only by UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT)
+    struct tlsf_index_t *free_index;
+
+    // block_pool - pool of block_t records of all blocks,
+    // list_pool - pool of records (ravl_free_blocks_head_t and
+    // ravl_free_blocks_elem_t) of the lists of free blocks of the same size
+    // (both are used only under the lock of the provider)
+    umf_ba_pool_t *block_pool;
+    umf_ba_pool_t *list_pool;
+
     struct utils_mutex_t lock;
 
     // Name of the provider with the upstream provider:
@@ -63,6 +126,19 @@ typedef struct coarse_memory_provider_t {
     // Set to true if the free() operation of the upstream memory provider is not supported
     // (i.e. if (umfMemoryProviderFree(upstream_memory_provider, NULL, 0) == UMF_RESULT_ERROR_NOT_SUPPORTED)
     bool disable_upstream_provider_free;
+
+    // heaps - independently locked sub-heaps of the provider
+    // (see coarse_memory_provider_params_t.num_heaps).
+    // The first one is the provider itself.
+    // It is NULL if the provider consists of a single heap.
+    struct coarse_memory_provider_t **heaps;
+    size_t num_heaps;
+
+    // heap_ranges - the sub-heap owning the memory of each upstream block:
+    //    key   - pointer to the beginning of the upstream block
+    //    value - pointer (coarse_memory_provider_t) to the sub-heap
+    // It is shared by all sub-heaps and NULL if there is a single heap.
+    critnib *heap_ranges;
 } coarse_memory_provider_t;
 
 typedef struct ravl_node ravl_node_t;
@@ -77,11 +153,37 @@ typedef struct block_t {
     unsigned char *data;
     bool used;
 
+    // Purge state of the free block, so that it is purged only once.
+    block_purge_state_t purge_state;
+
     // Node in the list of free blocks of the same size pointing to this block.
     // The list is located in the (coarse_provider->free_blocks) RAVL tree.
     struct ravl_free_blocks_elem_t *free_list_ptr;
+
+    // Links in the list of free blocks of the same size class
+    // of the segregated-fit index (coarse_provider->free_index).
+    struct block_t *free_next;
+    struct block_t *free_prev;
+    bool in_free_index;
+
+    // Links in the decay queue of its purge state (see decay_add())
+    // and the time (in milliseconds) the block was added to it.
+    struct block_t *decay_next;
+    struct block_t *decay_prev;
+    bool in_decay_queue;
+    uint64_t free_since;
 } block_t;
 
+// The two-level segregated-fit index of free blocks.
+// A set bit in fl_bitmap means that the given first-level class
+// has a non-empty second-level class, a set bit in sl_bitmap[fl] means
+// that the list of free blocks heads[fl][sl] is not empty.
+typedef struct tlsf_index_t {
+    size_t fl_bitmap;
+    uint32_t sl_bitmap[TLSF_FL_COUNT];
+    block_t *heads[TLSF_FL_COUNT][TLSF_SL_COUNT];
+} tlsf_index_t;
+
 // A general node in a RAVL tree.
 // 1) coarse_provider->all_blocks RAVL tree (tree of all blocks - sorted by an address of data):
 //    key   - pointer (block_t->data) to the beginning of the block data
@@ -177,14 +279,16 @@ static bool is_same_origin(struct ravl *upstream_blocks, block_t *block1,
 //
 // coarse_ravl_add_new - allocate and add a new block to the tree
 // and link this block to the next and the previous one.
-static block_t *coarse_ravl_add_new(struct ravl *rtree, unsigned char *data,
-                                    size_t size, ravl_node_t **node) {
+static block_t *coarse_ravl_add_new(struct ravl *rtree,
+                                    umf_ba_pool_t *block_pool,
+                                    unsigned char *data, size_t size,
+                                    ravl_node_t **node) {
     assert(rtree);
     assert(data);
     assert(size);
 
     // TODO add valgrind annotations
-    block_t *block = umf_ba_global_alloc(sizeof(*block));
+    block_t *block = umf_ba_alloc(block_pool);
     if (block == NULL) {
         return NULL;
     }
@@ -192,12 +296,20 @@ static block_t *coarse_ravl_add_new(struct ravl *rtree, unsigned char *data,
     block->data = data;
     block->size = size;
     block->free_list_ptr = NULL;
+    block->free_next = NULL;
+    block->free_prev = NULL;
+    block->in_free_index = false;
+    block->purge_state = BLOCK_NOT_PURGED;
+    block->decay_next = NULL;
+    block->decay_prev = NULL;
+    block->in_decay_queue = false;
+    block->free_since = 0;
 
     ravl_data_t rdata = {(uintptr_t)block->data, block};
     assert(NULL == ravl_find(rtree, &data, RAVL_PREDICATE_EQUAL));
     int ret = ravl_emplace_copy(rtree, &rdata);
     if (ret) {
-        umf_ba_global_free(block);
+        umf_ba_free(block_pool, block);
         return NULL;
     }
 
@@ -240,11 +352,12 @@ static block_t *coarse_ravl_rm(struct ravl *rtree, void *ptr) {
 //
 // node_list_add - add a free block to the list of free blocks of the same size
 static ravl_free_blocks_elem_t *
-node_list_add(ravl_free_blocks_head_t *head_node, struct block_t *block) {
+node_list_add(umf_ba_pool_t *list_pool, ravl_free_blocks_head_t *head_node,
+              struct block_t *block) {
     assert(head_node);
     assert(block);
 
-    ravl_free_blocks_elem_t *node = umf_ba_global_alloc(sizeof(*node));
+    ravl_free_blocks_elem_t *node = umf_ba_alloc(list_pool);
     if (node == NULL) {
         return NULL;
     }
@@ -262,7 +375,8 @@ node_list_add(ravl_free_blocks_head_t *head_node, struct block_t *block) {
 }
 
 // node_list_rm - remove the given free block from the list of free blocks of the same size
-static block_t *node_list_rm(ravl_free_blocks_head_t *head_node,
+static block_t *node_list_rm(umf_ba_pool_t *list_pool,
+                             ravl_free_blocks_head_t *head_node,
                              ravl_free_blocks_elem_t *node) {
     assert(head_node);
     assert(node);
@@ -288,13 +402,14 @@ static block_t *node_list_rm(ravl_free_blocks_head_t *head_node,
 
     struct block_t *block = node->block;
     block->free_list_ptr = NULL;
-    umf_ba_global_free(node);
+    umf_ba_free(list_pool, node);
 
     return block;
 }
 
 // node_list_rm_first - remove the first free block from the list of free blocks of the same size only if it can be properly aligned
-static block_t *node_list_rm_first(ravl_free_blocks_head_t *head_node,
+static block_t *node_list_rm_first(umf_ba_pool_t *list_pool,
+                                   ravl_free_blocks_head_t *head_node,
                                    size_t alignment) {
     assert(head_node);
 
@@ -316,13 +431,14 @@ static block_t *node_list_rm_first(ravl_free_blocks_head_t *head_node,
 
     head_node->head = node->next;
     block->free_list_ptr = NULL;
-    umf_ba_global_free(node);
+    umf_ba_free(list_pool, node);
 
     return block;
 }
 
 // node_list_rm_with_alignment - remove the first free block with the correct alignment from the list of free blocks of the same size
-static block_t *node_list_rm_with_alignment(ravl_free_blocks_head_t *head_node,
+static block_t *node_list_rm_with_alignment(umf_ba_pool_t *list_pool,
+                                            ravl_free_blocks_head_t *head_node,
                                             size_t alignment) {
     assert(head_node);
 
@@ -335,7 +451,7 @@ static block_t *node_list_rm_with_alignment(ravl_free_blocks_head_t *head_node,
     ravl_free_blocks_elem_t *node;
     for (node = head_node->head; node != NULL; node = node->next) {
         if (IS_ALIGNED(node->block->size, alignment)) {
-            return node_list_rm(head_node, node);
+            return node_list_rm(list_pool, head_node, node);
         }
     }
 
@@ -347,7 +463,8 @@ static block_t *node_list_rm_with_alignment(ravl_free_blocks_head_t *head_node,
 // This is a tree of heads (ravl_free_blocks_head_t) of lists of free blocks of the same size.
 //
 // free_blocks_add - add a free block to the list of free blocks of the same size
-static int free_blocks_add(struct ravl *free_blocks, block_t *block) {
+static int free_blocks_add(struct ravl *free_blocks, umf_ba_pool_t *list_pool,
+                           block_t *block) {
     ravl_free_blocks_head_t *head_node = NULL;
     int rv;
 
@@ -360,7 +477,7 @@ static int free_blocks_add(struct ravl *free_blocks, block_t *block) {
         head_node = node_data->value;
         assert(head_node);
     } else { // no head_node
-        head_node = umf_ba_global_alloc(sizeof(*head_node));
+        head_node = umf_ba_alloc(list_pool);
         if (!head_node) {
             return -1;
         }
@@ -370,12 +487,12 @@ static int free_blocks_add(struct ravl *free_blocks, block_t *block) {
         ravl_data_t data = {(uintptr_t)block->size, head_node};
         rv = ravl_emplace_copy(free_blocks, &data);
         if (rv) {
-            umf_ba_global_free(head_node);
+            umf_ba_free(list_pool, head_node);
             return -1;
         }
     }
 
-    block->free_list_ptr = node_list_add(head_node, block);
+    block->free_list_ptr = node_list_add(list_pool, head_node, block);
     if (!block->free_list_ptr) {
         return -1;
     }
@@ -388,7 +505,8 @@ static int free_blocks_add(struct ravl *free_blocks, block_t *block) {
 // free_blocks_rm_ge - remove the first free block of a size greater or equal to the given size only if it can be properly aligned
 // If it was the last block, the head node is freed and removed from the tree.
 // It is used during memory allocation (looking for a free block).
-static block_t *free_blocks_rm_ge(struct ravl *free_blocks, size_t size,
+static block_t *free_blocks_rm_ge(struct ravl *free_blocks,
+                                  umf_ba_pool_t *list_pool, size_t size,
                                   size_t alignment,
                                   check_free_blocks_t check_blocks) {
     ravl_data_t data = {(uintptr_t)size, NULL};
@@ -408,10 +526,10 @@ static block_t *free_blocks_rm_ge(struct ravl *free_blocks, size_t size,
     block_t *block;
     switch (check_blocks) {
     case CHECK_ONLY_THE_FIRST_BLOCK:
-        block = node_list_rm_first(head_node, alignment);
+        block = node_list_rm_first(list_pool, head_node, alignment);
         break;
     case CHECK_ALL_BLOCKS_OF_SIZE:
-        block = node_list_rm_with_alignment(head_node, alignment);
+        block = node_list_rm_with_alignment(list_pool, head_node, alignment);
         break;
     // wrong value of check_blocks
     default:
@@ -419,7 +537,7 @@ static block_t *free_blocks_rm_ge(struct ravl *free_blocks, size_t size,
     }
 
     if (head_node->head == NULL) {
-        umf_ba_global_free(head_node);
+        umf_ba_free(list_pool, head_node);
         ravl_remove(free_blocks, node);
     }
 
@@ -430,6 +548,7 @@ static block_t *free_blocks_rm_ge(struct ravl *free_blocks, size_t size,
 // If it was the last block, the head node is freed and removed from the tree.
 // It is used during merging free blocks and destroying the coarse_provider->free_blocks tree.
 static block_t *free_blocks_rm_node(struct ravl *free_blocks,
+                                    umf_ba_pool_t *list_pool,
                                     ravl_free_blocks_elem_t *node) {
     assert(free_blocks);
     assert(node);
@@ -446,16 +565,323 @@ static block_t *free_blocks_rm_node(struct ravl *free_blocks,
     ravl_free_blocks_head_t *head_node = node_data->value;
     assert(head_node);
 
-    block_t *block = node_list_rm(head_node, node);
+    block_t *block = node_list_rm(list_pool, head_node, node);
 
     if (head_node->head == NULL) {
-        umf_ba_global_free(head_node);
+        umf_ba_free(list_pool, head_node);
         ravl_remove(free_blocks, ravl_node);
     }
 
     return block;
 }
 
+// The functions "tlsf_*" handle the coarse_provider->free_index
+// segregated-fit index of free blocks. Inserting and looking up a block
+// takes a constant time regardless of the number of free blocks.
+//
+// tlsf_mapping - get the size class of the given size
+static void tlsf_mapping(size_t size, size_t *fl, size_t *sl) {
+    if (size < TLSF_SL_COUNT) {
+        *fl = 0;
+        *sl = size;
+        return;
+    }
+
+    size_t log2 = log2Utils(size);
+    *fl = log2 - TLSF_SL_LOG2 + 1;
+    *sl = (size >> (log2 - TLSF_SL_LOG2)) - TLSF_SL_COUNT;
+}
+
+// tlsf_add - add a free block to the list of its size class
+static void tlsf_add(tlsf_index_t *index, block_t *block) {
+    assert(!block->in_free_index);
+
+    size_t fl, sl;
+    tlsf_mapping(block->size, &fl, &sl);
+
+    block_t *head = index->heads[fl][sl];
+    block->free_prev = NULL;
+    block->free_next = head;
+    if (head) {
+        head->free_prev = block;
+    }
+
+    index->heads[fl][sl] = block;
+    index->fl_bitmap |= (size_t)1 << fl;
+    index->sl_bitmap[fl] |= (uint32_t)1 << sl;
+    block->in_free_index = true;
+}
+
+// tlsf_rm - remove the given free block from the list of its size class
+static void tlsf_rm(tlsf_index_t *index, block_t *block) {
+    assert(block->in_free_index);
+
+    size_t fl, sl;
+    tlsf_mapping(block->size, &fl, &sl);
+
+    if (block->free_prev) {
+        block->free_prev->free_next = block->free_next;
+    } else {
+        assert(index->heads[fl][sl] == block);
+        index->heads[fl][sl] = block->free_next;
+    }
+
+    if (block->free_next) {
+        block->free_next->free_prev = block->free_prev;
+    }
+
+    if (index->heads[fl][sl] == NULL) {
+        index->sl_bitmap[fl] &= ~((uint32_t)1 << sl);
+        if (index->sl_bitmap[fl] == 0) {
+            index->fl_bitmap &= ~((size_t)1 << fl);
+        }
+    }
+
+    block->free_next = NULL;
+    block->free_prev = NULL;
+    block->in_free_index = false;
+}
+
+// tlsf_find_class - find the head of the first non-empty list of free blocks
+// of the given or a greater size class
+static block_t *tlsf_find_class(tlsf_index_t *index, size_t fl, size_t sl) {
+    uint32_t sl_map = 0;
+    if (sl < TLSF_SL_COUNT) {
+        sl_map = index->sl_bitmap[fl] & (~(uint32_t)0 << sl);
+    }
+
+    if (!sl_map) {
+        size_t fl_map = 0;
+        if (fl + 1 < TLSF_FL_COUNT) {
+            fl_map = index->fl_bitmap & (~(size_t)0 << (fl + 1));
+        }
+        if (!fl_map) {
+            return NULL;
+        }
+
+        fl = getRightmostSetBitPos(fl_map);
+        sl_map = index->sl_bitmap[fl];
+        assert(sl_map);
+    }
+
+    sl = getRightmostSetBitPos(sl_map);
+    assert(index->heads[fl][sl]);
+
+    return index->heads[fl][sl];
+}
+
+// tlsf_find_ge - find a free block of a size greater or equal to the given size
+static block_t *tlsf_find_ge(tlsf_index_t *index, size_t size) {
+    size_t fl, sl;
+    tlsf_mapping(size, &fl, &sl);
+
+    // Blocks of the size class of the given size may be smaller than it,
+    // but the first one is checked, because it is the best fit if it is
+    // large enough (e.g. when blocks of the same size are reused).
+    block_t *block = index->heads[fl][sl];
+    if (block && block->size >= size) {
+        return block;
+    }
+
+    // All blocks of the greater size classes are large enough.
+    block = tlsf_find_class(index, fl, sl + 1);
+    if (block) {
+        assert(block->size >= size);
+        return block;
+    }
+
+    // Look through the rest of the blocks of the size class of the given size
+    // only before getting more memory from the upstream provider.
+    for (block = index->heads[fl][sl]; block; block = block->free_next) {
+        if (block->size >= size) {
+            return block;
+        }
+    }
+
+    return NULL;
+}
+
+// tlsf_rm_ge - remove a free block of a size greater or equal to the given size
+// that can be used for an allocation of the given alignment
+static block_t *tlsf_rm_ge(tlsf_index_t *index, size_t size,
+                           size_t alignment) {
+    block_t *block;
+
+    if (alignment > 0) {
+        // First check if the first free block of the 'size' size is aligned.
+        block = tlsf_find_ge(index, size);
+        if (block && IS_ALIGNED((uintptr_t)block->data, alignment)) {
+            tlsf_rm(index, block);
+            return block;
+        }
+
+        // If not, take a block large enough to cut out the aligned part.
+        if (size > SIZE_MAX - alignment) {
+            return NULL;
+        }
+        size += alignment;
+    }
+
+    block = tlsf_find_ge(index, size);
+    if (block) {
+        tlsf_rm(index, block);
+    }
+
+    return block;
+}
+
+// The functions "decay_*" handle the decay of large free blocks:
+// free blocks of at least purge_min_size bytes wait in the FIFO queue
+// of their purge state to be purged lazily and then forcibly.
+
+// decay_append - append the block to the queue of its purge state
+static void decay_append(coarse_memory_provider_t *coarse_provider,
+                         block_t *block) {
+    block_purge_state_t state = block->purge_state;
+    assert(state < BLOCK_PURGED_FORCE);
+    assert(!block->in_decay_queue);
+
+    block->decay_next = NULL;
+    block->decay_prev = coarse_provider->decay_tail[state];
+    if (block->decay_prev) {
+        block->decay_prev->decay_next = block;
+    } else {
+        coarse_provider->decay_head[state] = block;
+    }
+
+    coarse_provider->decay_tail[state] = block;
+    block->in_decay_queue = true;
+}
+
+// decay_add - add a new free block to the decay queues if it is large enough
+static void decay_add(coarse_memory_provider_t *coarse_provider,
+                      block_t *block) {
+    if (coarse_provider->purge_min_size == 0 ||
+        block->size < coarse_provider->purge_min_size ||
+        block->purge_state == BLOCK_PURGED_FORCE) {
+        return;
+    }
+
+    block->free_since = umf_decay_clock_ms();
+    decay_append(coarse_provider, block);
+}
+
+// decay_rm - remove the given block from the decay queues if it is there
+static void decay_rm(coarse_memory_provider_t *coarse_provider,
+                     block_t *block) {
+    if (!block->in_decay_queue) {
+        return;
+    }
+
+    block_purge_state_t state = block->purge_state;
+    if (block->decay_prev) {
+        block->decay_prev->decay_next = block->decay_next;
+    } else {
+        coarse_provider->decay_head[state] = block->decay_next;
+    }
+
+    if (block->decay_next) {
+        block->decay_next->decay_prev = block->decay_prev;
+    } else {
+        coarse_provider->decay_tail[state] = block->decay_prev;
+    }
+
+    block->decay_next = NULL;
+    block->decay_prev = NULL;
+    block->in_decay_queue = false;
+}
+
+// decay_purge - purge the whole pages of the free block
+// and move it to the given purge state
+static void decay_purge(coarse_memory_provider_t *coarse_provider,
+                        block_t *block, block_purge_state_t state) {
+    assert(!block->used && !block->in_decay_queue);
+
+    size_t page_size = coarse_provider->purge_page_size;
+    uintptr_t begin = ALIGN_UP((uintptr_t)block->data, page_size);
+    uintptr_t end = ALIGN_DOWN((uintptr_t)block->data + block->size, page_size);
+
+    if (end > begin) {
+        umf_memory_provider_handle_t upstream =
+            coarse_provider->upstream_memory_provider;
+        umf_result_t umf_result =
+            (state == BLOCK_PURGED_LAZY)
+                ? umfMemoryProviderPurgeLazy(upstream, (void *)begin,
+                                             end - begin)
+                : umfMemoryProviderPurgeForce(upstream, (void *)begin,
+                                              end - begin);
+        // the block is not purged again even if it failed
+        if (umf_result != UMF_RESULT_SUCCESS) {
+            LOG_DEBUG("purging a free block failed (ptr = %p, size = %zu)",
+                      (void *)begin, end - begin);
+        }
+    }
+
+    block->purge_state = state;
+}
+
+// decay_tick - purge the free blocks that have not been used
+// for purge_lazy_delay_ms or purge_force_delay_ms
+static void decay_tick(coarse_memory_provider_t *coarse_provider) {
+    if (coarse_provider->decay_head[BLOCK_NOT_PURGED] == NULL &&
+        coarse_provider->decay_head[BLOCK_PURGED_LAZY] == NULL) {
+        return;
+    }
+
+    uint64_t now = umf_decay_clock_ms();
+    block_t *block;
+
+    while ((block = coarse_provider->decay_head[BLOCK_NOT_PURGED]) &&
+           now - block->free_since >= coarse_provider->purge_lazy_delay_ms) {
+        decay_rm(coarse_provider, block);
+        if (now - block->free_since >= coarse_provider->purge_force_delay_ms) {
+            decay_purge(coarse_provider, block, BLOCK_PURGED_FORCE);
+        } else {
+            decay_purge(coarse_provider, block, BLOCK_PURGED_LAZY);
+            decay_append(coarse_provider, block);
+        }
+    }
+
+    while ((block = coarse_provider->decay_head[BLOCK_PURGED_LAZY]) &&
+           now - block->free_since >= coarse_provider->purge_force_delay_ms) {
+        decay_rm(coarse_provider, block);
+        decay_purge(coarse_provider, block, BLOCK_PURGED_FORCE);
+    }
+}
+
+// The functions "free_index_*" handle the index of free blocks
+// of the used allocation strategy: coarse_provider->free_blocks
+// or coarse_provider->free_index.
+//
+// free_index_add - add a free block to the index
+static int free_index_add(coarse_memory_provider_t *coarse_provider,
+                          block_t *block) {
+    if (coarse_provider->free_index) {
+        tlsf_add(coarse_provider->free_index, block);
+    } else if (free_blocks_add(coarse_provider->free_blocks,
+                               coarse_provider->list_pool, block)) {
+        return -1;
+    }
+
+    decay_add(coarse_provider, block);
+
+    return 0;
+}
+
+// free_index_rm - remove the given block from the index if it is there
+static void free_index_rm(coarse_memory_provider_t *coarse_provider,
+                          block_t *block) {
+    decay_rm(coarse_provider, block);
+
+    if (block->in_free_index) {
+        tlsf_rm(coarse_provider->free_index, block);
+    } else if (block->free_list_ptr) {
+        free_blocks_rm_node(coarse_provider->free_blocks,
+                            coarse_provider->list_pool, block->free_list_ptr);
+        block->free_list_ptr = NULL;
+    }
+}
+
 // user_block_merge - merge two blocks from one of two lists of user blocks: all_blocks or free_blocks
 static umf_result_t user_block_merge(coarse_memory_provider_t *coarse_provider,
                                      ravl_node_t *node1, ravl_node_t *node2,
@@ -470,7 +896,6 @@ static umf_result_t user_block_merge(coarse_memory_provider_t *coarse_provider,
 
     struct ravl *upstream_blocks = coarse_provider->upstream_blocks;
     struct ravl *all_blocks = coarse_provider->all_blocks;
-    struct ravl *free_blocks = coarse_provider->free_blocks;
 
     block_t *block1 = get_node_block(node1);
     block_t *block2 = get_node_block(node2);
@@ -485,23 +910,21 @@ static umf_result_t user_block_merge(coarse_memory_provider_t *coarse_provider,
         return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
 
-    if (block1->free_list_ptr) {
-        free_blocks_rm_node(free_blocks, block1->free_list_ptr);
-        block1->free_list_ptr = NULL;
-    }
-
-    if (block2->free_list_ptr) {
-        free_blocks_rm_node(free_blocks, block2->free_list_ptr);
-        block2->free_list_ptr = NULL;
-    }
+    free_index_rm(coarse_provider, block1);
+    free_index_rm(coarse_provider, block2);
 
     // update the size
     block1->size += block2->size;
 
+    // the merged block is purged only as much as both of them
+    if (block2->purge_state < block1->purge_state) {
+        block1->purge_state = block2->purge_state;
+    }
+
     block_t *block_rm = coarse_ravl_rm(all_blocks, block2->data);
     assert(block_rm == block2);
     (void)block_rm; // WA for unused variable error
-    umf_ba_global_free(block2);
+    umf_ba_free(coarse_provider->block_pool, block2);
 
     *merged_node = node1;
 
@@ -595,7 +1018,14 @@ upstream_block_merge(coarse_memory_provider_t *coarse_provider,
     block_t *block_rm = coarse_ravl_rm(upstream_blocks, block2->data);
     assert(block_rm == block2);
     (void)block_rm; // WA for unused variable error
-    umf_ba_global_free(block2);
+
+    // block2 is a part of block1 now, so the beginning of block1
+    // is the only key of both of them in heap_ranges
+    if (coarse_provider->heap_ranges) {
+        critnib_remove(coarse_provider->heap_ranges, (uintptr_t)block2->data);
+    }
+
+    umf_ba_free(coarse_provider->block_pool, block2);
 
     *merged_node = node1;
 
@@ -799,17 +1229,27 @@ coarse_add_upstream_block(coarse_memory_provider_t *coarse_provider, void *addr,
                           size_t size) {
     ravl_node_t *alloc_node = NULL;
 
-    block_t *alloc = coarse_ravl_add_new(coarse_provider->upstream_blocks, addr,
+    // register the sub-heap owning this memory
+    if (coarse_provider->heap_ranges &&
+        critnib_insert(coarse_provider->heap_ranges, (uintptr_t)addr,
+                       coarse_provider, 0 /* update */)) {
+        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    block_t *alloc = coarse_ravl_add_new(coarse_provider->upstream_blocks,
+                                         coarse_provider->block_pool, addr,
                                          size, &alloc_node);
     if (alloc == NULL) {
-        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+        goto err_rm_heap_range;
     }
 
     block_t *new_block =
-        coarse_ravl_add_new(coarse_provider->all_blocks, addr, size, NULL);
+        coarse_ravl_add_new(coarse_provider->all_blocks,
+                            coarse_provider->block_pool, addr, size, NULL);
     if (new_block == NULL) {
-        coarse_ravl_rm(coarse_provider->upstream_blocks, addr);
-        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+        umf_ba_free(coarse_provider->block_pool,
+                    coarse_ravl_rm(coarse_provider->upstream_blocks, addr));
+        goto err_rm_heap_range;
     }
 
     // check if the new upstream block can be merged with its neighbours
@@ -821,6 +1261,118 @@ coarse_add_upstream_block(coarse_memory_provider_t *coarse_provider, void *addr,
     coarse_provider->used_size += size;
 
     return UMF_RESULT_SUCCESS;
+
+err_rm_heap_range:
+    if (coarse_provider->heap_ranges) {
+        critnib_remove(coarse_provider->heap_ranges, (uintptr_t)addr);
+    }
+    return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+}
+
+// coarse_get_free_upstream_block - return the free block covering
+// the entire given upstream block or NULL if there is no such block
+static block_t *
+coarse_get_free_upstream_block(coarse_memory_provider_t *coarse_provider,
+                               block_t *alloc) {
+    ravl_node_t *node =
+        coarse_ravl_find_node(coarse_provider->all_blocks, alloc->data);
+    assert(node);
+
+    block_t *block = get_node_block(node);
+    if (block->used || block->size != alloc->size) {
+        return NULL;
+    }
+
+    return block;
+}
+
+// coarse_release_upstream_block - return the upstream block
+// to the upstream provider and remove it and the free block covering it
+// from the provider
+static umf_result_t
+coarse_release_upstream_block(coarse_memory_provider_t *coarse_provider,
+                              block_t *alloc, block_t *block) {
+    void *data = alloc->data;
+    size_t size = alloc->size;
+
+    assert(block->data == data && block->size == size && !block->used);
+
+    umf_result_t umf_result = umfMemoryProviderFree(
+        coarse_provider->upstream_memory_provider, data, size);
+    if (umf_result != UMF_RESULT_SUCCESS) {
+        LOG_ERR("freeing memory of the upstream provider failed (ptr = %p, "
+                "size = %zu)",
+                data, size);
+        return umf_result;
+    }
+
+    free_index_rm(coarse_provider, block);
+    umf_ba_free(coarse_provider->block_pool,
+                coarse_ravl_rm(coarse_provider->all_blocks, data));
+    umf_ba_free(coarse_provider->block_pool,
+                coarse_ravl_rm(coarse_provider->upstream_blocks, data));
+
+    if (coarse_provider->heap_ranges) {
+        critnib_remove(coarse_provider->heap_ranges, (uintptr_t)data);
+    }
+
+    assert(coarse_provider->alloc_size >= size);
+    coarse_provider->alloc_size -= size;
+
+    LOG_DEBUG("coarse_TRIM (upstream) %zu used %zu alloc %zu", size,
+              coarse_provider->used_size, coarse_provider->alloc_size);
+
+    return UMF_RESULT_SUCCESS;
+}
+
+// coarse_auto_trim - return the upstream block to the upstream provider
+// (or purge it if its free() is not supported) if the given (just freed)
+// block covers all of it and the free memory exceeds trim_threshold.
+// At least trim_retained_size bytes are kept free.
+static void coarse_auto_trim(coarse_memory_provider_t *coarse_provider,
+                             block_t *block) {
+    if (coarse_provider->trim_threshold == 0 ||
+        coarse_provider->upstream_memory_provider == NULL) {
+        // the memory of the init buffer cannot be returned
+        return;
+    }
+
+    size_t free_size = coarse_provider->alloc_size - coarse_provider->used_size;
+    if (free_size <= coarse_provider->trim_threshold ||
+        free_size - block->size < coarse_provider->trim_retained_size) {
+        return;
+    }
+
+    ravl_node_t *alloc_node =
+        coarse_ravl_find_node(coarse_provider->upstream_blocks, block->data);
+    if (alloc_node == NULL) {
+        // the block does not begin an upstream block
+        return;
+    }
+
+    block_t *alloc = get_node_block(alloc_node);
+    if (coarse_get_free_upstream_block(coarse_provider, alloc) != block) {
+        return;
+    }
+
+    if (coarse_provider->disable_upstream_provider_free) {
+        if (block->purge_state == BLOCK_PURGED_FORCE) {
+            return;
+        }
+
+        umf_result_t umf_result = umfMemoryProviderPurgeForce(
+            coarse_provider->upstream_memory_provider, block->data,
+            block->size);
+        // the block is not purged if it failed
+        if (umf_result == UMF_RESULT_SUCCESS) {
+            decay_rm(coarse_provider, block);
+            block->purge_state = BLOCK_PURGED_FORCE;
+        }
+        return;
+    }
+
+    // the block stays in the provider if the upstream free() fails
+    (void)coarse_release_upstream_block(coarse_provider, alloc, block);
 }
 
 static umf_result_t
@@ -850,27 +1402,22 @@ coarse_memory_provider_set_name(coarse_memory_provider_t *coarse_provider) {
     return UMF_RESULT_SUCCESS;
 }
 
-// needed for coarse_memory_provider_initialize()
-static umf_result_t coarse_memory_provider_alloc(void *provider, size_t size,
-                                                 size_t alignment,
-                                                 void **resultPtr);
+// needed for coarse_heap_initialize()
+static umf_result_t coarse_heap_alloc(void *provider, size_t size,
+                                      size_t alignment, bool use_upstream,
+                                      void **resultPtr);
 
-// needed for coarse_memory_provider_initialize()
-static umf_result_t coarse_memory_provider_free(void *provider, void *ptr,
-                                                size_t bytes);
+// needed for coarse_heap_initialize()
+static umf_result_t coarse_heap_free(void *provider, void *ptr, size_t bytes);
 
-static umf_result_t coarse_memory_provider_initialize(void *params,
-                                                      void **provider) {
+// The functions "coarse_heap_*" implement the operations of a single heap.
+// The "coarse_memory_provider_*" ones select the sub-heap to use
+// if the provider consists of many heaps.
+static umf_result_t
+coarse_heap_initialize(coarse_memory_provider_params_t *coarse_params,
+                       critnib *heap_ranges, void **provider) {
     assert(provider);
 
-    if (params == NULL) {
-        LOG_ERR("coarse provider parameters are missing");
-        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
-    }
-
-    coarse_memory_provider_params_t *coarse_params =
-        (coarse_memory_provider_params_t *)params;
-
     // check params
     if (!coarse_params->upstream_memory_provider ==
         !coarse_params->init_buffer) {
@@ -902,6 +1449,26 @@ static umf_result_t coarse_memory_provider_initialize(void *params,
         return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
 
+    if (coarse_params->max_upstream_chunk_size &&
+        coarse_params->max_upstream_chunk_size <
+            coarse_params->min_upstream_chunk_size) {
+        LOG_ERR("max_upstream_chunk_size is smaller than "
+                "min_upstream_chunk_size");
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (coarse_params->trim_threshold &&
+        coarse_params->trim_retained_size >= coarse_params->trim_threshold) {
+        LOG_ERR("trim_retained_size has to be smaller than trim_threshold");
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (coarse_params->purge_force_delay_ms <
+        coarse_params->purge_lazy_delay_ms) {
+        LOG_ERR("purge_force_delay_ms is smaller than purge_lazy_delay_ms");
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
     coarse_memory_provider_t *coarse_provider =
         umf_ba_global_alloc(sizeof(*coarse_provider));
     if (!coarse_provider) {
@@ -911,6 +1478,8 @@ static umf_result_t coarse_memory_provider_initialize(void *params,
 
     memset(coarse_provider, 0, sizeof(*coarse_provider));
 
+    coarse_provider->heap_ranges = heap_ranges;
+
     coarse_provider->upstream_memory_provider =
         coarse_params->upstream_memory_provider;
     coarse_provider->destroy_upstream_memory_provider =
@@ -925,6 +1494,23 @@ static umf_result_t coarse_memory_provider_initialize(void *params,
         coarse_provider->disable_upstream_provider_free = false;
     }
 
+    // the memory of the init buffer is not purged
+    if (coarse_provider->upstream_memory_provider &&
+        coarse_params->purge_min_size) {
+        coarse_provider->purge_min_size = coarse_params->purge_min_size;
+        coarse_provider->purge_lazy_delay_ms =
+            coarse_params->purge_lazy_delay_ms;
+        coarse_provider->purge_force_delay_ms =
+            coarse_params->purge_force_delay_ms;
+
+        if (umfMemoryProviderGetMinPageSize(
+                coarse_provider->upstream_memory_provider, NULL,
+                &coarse_provider->purge_page_size) != UMF_RESULT_SUCCESS ||
+            coarse_provider->purge_page_size == 0) {
+            coarse_provider->purge_page_size = utils_get_page_size();
+        }
+    }
+
     umf_result_t umf_result = coarse_memory_provider_set_name(coarse_provider);
     if (umf_result != UMF_RESULT_SUCCESS) {
         LOG_ERR("name initialization failed");
@@ -955,27 +1541,54 @@ static umf_result_t coarse_memory_provider_initialize(void *params,
         goto err_delete_ravl_free_blocks;
     }
 
+    if (coarse_provider->allocation_strategy ==
+        UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT) {
+        coarse_provider->free_index =
+            umf_ba_global_alloc(sizeof(*coarse_provider->free_index));
+        if (coarse_provider->free_index == NULL) {
+            LOG_ERR("out of the host memory");
+            goto err_delete_ravl_all_blocks;
+        }
+
+        memset(coarse_provider->free_index, 0,
+               sizeof(*coarse_provider->free_index));
+    }
+
+    coarse_provider->block_pool = umf_ba_create(sizeof(block_t));
+    if (coarse_provider->block_pool == NULL) {
+        LOG_ERR("out of the host memory");
+        goto err_free_free_index;
+    }
+
+    // ravl_free_blocks_elem_t is the larger one of the list records
+    coarse_provider->list_pool =
+        umf_ba_create(sizeof(ravl_free_blocks_elem_t));
+    if (coarse_provider->list_pool == NULL) {
+        LOG_ERR("out of the host memory");
+        goto err_destroy_block_pool;
+    }
+
     coarse_provider->alloc_size = 0;
     coarse_provider->used_size = 0;
 
     if (utils_mutex_init(&coarse_provider->lock) == NULL) {
         LOG_ERR("lock initialization failed");
         umf_result = UMF_RESULT_ERROR_UNKNOWN;
-        goto err_delete_ravl_all_blocks;
+        goto err_destroy_list_pool;
     }
 
     if (coarse_params->upstream_memory_provider &&
         coarse_params->immediate_init_from_upstream) {
         // allocate and immediately deallocate memory using the upstream provider
         void *init_buffer = NULL;
-        coarse_memory_provider_alloc(
-            coarse_provider, coarse_params->init_buffer_size, 0, &init_buffer);
+        coarse_heap_alloc(coarse_provider, coarse_params->init_buffer_size, 0,
+                          true, &init_buffer);
         if (init_buffer == NULL) {
             goto err_destroy_mutex;
         }
 
-        coarse_memory_provider_free(coarse_provider, init_buffer,
-                                    coarse_params->init_buffer_size);
+        coarse_heap_free(coarse_provider, init_buffer,
+                         coarse_params->init_buffer_size);
 
     } else if (coarse_params->init_buffer) {
         umf_result = coarse_add_upstream_block(coarse_provider,
@@ -989,21 +1602,40 @@ static umf_result_t coarse_memory_provider_initialize(void *params,
                   coarse_params->init_buffer_size, coarse_provider->used_size,
                   coarse_provider->alloc_size);
 
-        coarse_memory_provider_free(coarse_provider,
-                                    coarse_provider->init_buffer,
-                                    coarse_params->init_buffer_size);
+        coarse_heap_free(coarse_provider, coarse_provider->init_buffer,
+                         coarse_params->init_buffer_size);
     }
 
     assert(coarse_provider->used_size == 0);
     assert(coarse_provider->alloc_size == coarse_params->init_buffer_size);
     assert(debug_check(coarse_provider));
 
+    // set after the initial buffer was allocated with its exact size
+    coarse_provider->upstream_chunk_size =
+        coarse_params->min_upstream_chunk_size;
+    coarse_provider->upstream_chunk_growth_factor =
+        coarse_params->upstream_chunk_growth_factor;
+    coarse_provider->max_upstream_chunk_size =
+        coarse_params->max_upstream_chunk_size;
+
+    // the initial buffer is not trimmed right after it was freed above
+    if (coarse_provider->upstream_memory_provider) {
+        coarse_provider->trim_threshold = coarse_params->trim_threshold;
+        coarse_provider->trim_retained_size = coarse_params->trim_retained_size;
+    }
+
     *provider = coarse_provider;
 
     return UMF_RESULT_SUCCESS;
 
 err_destroy_mutex:
     utils_mutex_destroy_not_free(&coarse_provider->lock);
+err_destroy_list_pool:
+    umf_ba_destroy(coarse_provider->list_pool);
+err_destroy_block_pool:
+    umf_ba_destroy(coarse_provider->block_pool);
+err_free_free_index:
+    umf_ba_global_free(coarse_provider->free_index);
 err_delete_ravl_all_blocks:
     ravl_delete(coarse_provider->all_blocks);
 err_delete_ravl_free_blocks:
@@ -1037,7 +1669,7 @@ static void coarse_ravl_cb_rm_upstream_blocks_node(void *data, void *arg) {
     assert(coarse_provider->alloc_size >= alloc->size);
     coarse_provider->alloc_size -= alloc->size;
 
-    umf_ba_global_free(alloc);
+    umf_ba_free(coarse_provider->block_pool, alloc);
 }
 
 static void coarse_ravl_cb_rm_all_blocks_node(void *data, void *arg) {
@@ -1055,14 +1687,12 @@ static void coarse_ravl_cb_rm_all_blocks_node(void *data, void *arg) {
         coarse_provider->used_size -= block->size;
     }
 
-    if (block->free_list_ptr) {
-        free_blocks_rm_node(coarse_provider->free_blocks, block->free_list_ptr);
-    }
+    free_index_rm(coarse_provider, block);
 
-    umf_ba_global_free(block);
+    umf_ba_free(coarse_provider->block_pool, block);
 }
 
-static void coarse_memory_provider_finalize(void *provider) {
+static void coarse_heap_finalize(void *provider) {
     coarse_memory_provider_t *coarse_provider =
         (struct coarse_memory_provider_t *)provider;
 
@@ -1079,6 +1709,9 @@ static void coarse_memory_provider_finalize(void *provider) {
     ravl_delete(coarse_provider->upstream_blocks);
     ravl_delete(coarse_provider->all_blocks);
     ravl_delete(coarse_provider->free_blocks);
+    umf_ba_global_free(coarse_provider->free_index);
+    umf_ba_destroy(coarse_provider->list_pool);
+    umf_ba_destroy(coarse_provider->block_pool);
 
     umf_ba_global_free(coarse_provider->name);
 
@@ -1104,16 +1737,17 @@ create_aligned_block(coarse_memory_provider_t *coarse_provider,
     size_t padding = aligned_data - orig_data;
     if (alignment > 0 && padding > 0) {
         block_t *aligned_block = coarse_ravl_add_new(
-            coarse_provider->all_blocks, curr->data + padding,
-            curr->size - padding, NULL);
+            coarse_provider->all_blocks, coarse_provider->block_pool,
+            curr->data + padding, curr->size - padding, NULL);
         if (aligned_block == NULL) {
             return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
         }
 
+        aligned_block->purge_state = curr->purge_state;
         curr->used = false;
         curr->size = padding;
 
-        rv = free_blocks_add(coarse_provider->free_blocks, curr);
+        rv = free_index_add(coarse_provider, curr);
         if (rv) {
             return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
         }
@@ -1133,16 +1767,17 @@ split_current_block(coarse_memory_provider_t *coarse_provider, block_t *curr,
     ravl_node_t *new_node = NULL;
 
     block_t *new_block =
-        coarse_ravl_add_new(coarse_provider->all_blocks, curr->data + size,
+        coarse_ravl_add_new(coarse_provider->all_blocks,
+                            coarse_provider->block_pool, curr->data + size,
                             curr->size - size, &new_node);
     if (new_block == NULL) {
         return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
     }
 
     new_block->used = false;
+    new_block->purge_state = curr->purge_state;
 
-    int rv =
-        free_blocks_add(coarse_provider->free_blocks, get_node_block(new_node));
+    int rv = free_index_add(coarse_provider, get_node_block(new_node));
     if (rv) {
         return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
     }
@@ -1150,34 +1785,132 @@ split_current_block(coarse_memory_provider_t *coarse_provider, block_t *curr,
     return UMF_RESULT_SUCCESS;
 }
 
+// coarse_grow_upstream_chunk - compute the size of the next upstream chunk
+static void
+coarse_grow_upstream_chunk(coarse_memory_provider_t *coarse_provider) {
+    size_t factor = coarse_provider->upstream_chunk_growth_factor;
+    size_t max_size = coarse_provider->max_upstream_chunk_size;
+    size_t chunk_size = coarse_provider->upstream_chunk_size;
+
+    if (factor <= 1 || (max_size && chunk_size >= max_size)) {
+        return;
+    }
+
+    if (chunk_size > SIZE_MAX / factor) {
+        chunk_size = SIZE_MAX;
+    } else {
+        chunk_size *= factor;
+    }
+
+    if (max_size && chunk_size > max_size) {
+        chunk_size = max_size;
+    }
+
+    coarse_provider->upstream_chunk_size = chunk_size;
+}
+
+// coarse_free_chunk_rest - leave only the first 'size' bytes
+// of a new upstream chunk used and add the rest of it to the free blocks
+static umf_result_t
+coarse_free_chunk_rest(coarse_memory_provider_t *coarse_provider, void *chunk,
+                       size_t size) {
+    ravl_node_t *node =
+        coarse_ravl_find_node(coarse_provider->all_blocks, chunk);
+    assert(node);
+
+    block_t *block = get_node_block(node);
+    assert(block->used && block->size > size);
+
+    ravl_node_t *rest_node = NULL;
+    block_t *rest =
+        coarse_ravl_add_new(coarse_provider->all_blocks,
+                            coarse_provider->block_pool, block->data + size,
+                            block->size - size, &rest_node);
+    if (rest == NULL) {
+        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    rest->used = false;
+    coarse_provider->used_size -= rest->size;
+    block->size = size;
+
+    // the rest may be followed by a free block of the same upstream block
+    rest_node = free_block_merge_with_next(coarse_provider, rest_node);
+
+    if (free_index_add(coarse_provider, get_node_block(rest_node))) {
+        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    return UMF_RESULT_SUCCESS;
+}
+
+// coarse_undo_upstream_chunk - give up a new upstream chunk whose rest could
+// not be freed: return it to the upstream provider if it is still a separate
+// upstream block, otherwise keep it in the provider as free memory
+static void coarse_undo_upstream_chunk(coarse_memory_provider_t *coarse_provider,
+                                       void *chunk) {
+    ravl_node_t *node =
+        coarse_ravl_find_node(coarse_provider->all_blocks, chunk);
+    assert(node);
+
+    block_t *block = get_node_block(node);
+    assert(block->used);
+
+    // the rest, if split off, is merged back below
+    assert(coarse_provider->used_size >= block->size);
+    coarse_provider->used_size -= block->size;
+    block->used = false;
+
+    node = free_block_merge_with_prev(coarse_provider, node);
+    node = free_block_merge_with_next(coarse_provider, node);
+    block = get_node_block(node);
+
+    ravl_node_t *alloc_node =
+        coarse_ravl_find_node(coarse_provider->upstream_blocks, block->data);
+    if (alloc_node && !coarse_provider->disable_upstream_provider_free) {
+        block_t *alloc = get_node_block(alloc_node);
+        if (coarse_get_free_upstream_block(coarse_provider, alloc) == block &&
+            coarse_release_upstream_block(coarse_provider, alloc, block) ==
+                UMF_RESULT_SUCCESS) {
+            return;
+        }
+    }
+
+    if (free_index_add(coarse_provider, block)) {
+        LOG_ERR("adding the upstream chunk to the free blocks failed");
+    }
+}
+
 static block_t *
-find_free_block(struct ravl *free_blocks, size_t size, size_t alignment,
-                coarse_memory_provider_strategy_t allocation_strategy) {
+find_free_block_by_strategy(coarse_memory_provider_t *coarse_provider,
+                            size_t size, size_t alignment) {
+    struct ravl *free_blocks = coarse_provider->free_blocks;
+    umf_ba_pool_t *list_pool = coarse_provider->list_pool;
     block_t *block;
 
-    switch (allocation_strategy) {
+    switch (coarse_provider->allocation_strategy) {
     case UMF_COARSE_MEMORY_STRATEGY_FASTEST:
         // Always allocate a free block of the (size + alignment) size
         // and later cut out the properly aligned part leaving two remaining parts.
-        return free_blocks_rm_ge(free_blocks, size + alignment, 0,
-                                 CHECK_ONLY_THE_FIRST_BLOCK);
+        return free_blocks_rm_ge(free_blocks, list_pool, size + alignment,
+                                 0, CHECK_ONLY_THE_FIRST_BLOCK);
 
     case UMF_COARSE_MEMORY_STRATEGY_FASTEST_BUT_ONE:
         // First check if the first free block of the 'size' size has the correct alignment.
-        block = free_blocks_rm_ge(free_blocks, size, alignment,
+        block = free_blocks_rm_ge(free_blocks, list_pool, size, alignment,
                                   CHECK_ONLY_THE_FIRST_BLOCK);
         if (block) {
             return block;
         }
 
         // If not, use the `UMF_COARSE_MEMORY_STRATEGY_FASTEST` strategy.
-        return free_blocks_rm_ge(free_blocks, size + alignment, 0,
-                                 CHECK_ONLY_THE_FIRST_BLOCK);
+        return free_blocks_rm_ge(free_blocks, list_pool, size + alignment,
+                                 0, CHECK_ONLY_THE_FIRST_BLOCK);
 
     case UMF_COARSE_MEMORY_STRATEGY_CHECK_ALL_SIZE:
         // First look through all free blocks of the 'size' size
         // and choose the first one with the correct alignment.
-        block = free_blocks_rm_ge(free_blocks, size, alignment,
+        block = free_blocks_rm_ge(free_blocks, list_pool, size, alignment,
                                   CHECK_ALL_BLOCKS_OF_SIZE);
         if (block) {
             return block;
@@ -1185,8 +1918,13 @@ find_free_block(struct ravl *free_blocks, size_t size, size_t alignment,
 
         // If none of them had the correct alignment,
         // use the `UMF_COARSE_MEMORY_STRATEGY_FASTEST` strategy.
-        return free_blocks_rm_ge(free_blocks, size + alignment, 0,
-                                 CHECK_ONLY_THE_FIRST_BLOCK);
+        return free_blocks_rm_ge(free_blocks, list_pool, size + alignment,
+                                 0, CHECK_ONLY_THE_FIRST_BLOCK);
+
+    case UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT:
+        // Take the first free block of the smallest size class
+        // that fits the requested size.
+        return tlsf_rm_ge(coarse_provider->free_index, size, alignment);
 
     // unknown memory allocation strategy
     default:
@@ -1194,9 +1932,23 @@ find_free_block(struct ravl *free_blocks, size_t size, size_t alignment,
     }
 }
 
-static umf_result_t coarse_memory_provider_alloc(void *provider, size_t size,
-                                                 size_t alignment,
-                                                 void **resultPtr) {
+// find_free_block - remove a free block of a size greater or equal
+// to the given size from the index of free blocks and from the decay queues
+static block_t *find_free_block(coarse_memory_provider_t *coarse_provider,
+                                size_t size, size_t alignment) {
+    block_t *block =
+        find_free_block_by_strategy(coarse_provider, size, alignment);
+    if (block) {
+        // the block must not be purged after it is used again
+        decay_rm(coarse_provider, block);
+    }
+
+    return block;
+}
+
+static umf_result_t coarse_heap_alloc(void *provider, size_t size,
+                                      size_t alignment, bool use_upstream,
+                                      void **resultPtr) {
     umf_result_t umf_result = UMF_RESULT_ERROR_UNKNOWN;
 
     if (resultPtr == NULL) {
@@ -1214,9 +1966,7 @@ static umf_result_t coarse_memory_provider_alloc(void *provider, size_t size,
     assert(debug_check(coarse_provider));
 
     // Find a block with greater or equal size using the given memory allocation strategy
-    block_t *curr =
-        find_free_block(coarse_provider->free_blocks, size, alignment,
-                        coarse_provider->allocation_strategy);
+    block_t *curr = find_free_block(coarse_provider, size, alignment);
 
     // If the block that we want to reuse has a greater size, split it.
     // Try to merge the split part with the successor if it is not used.
@@ -1241,7 +1991,9 @@ static umf_result_t coarse_memory_provider_alloc(void *provider, size_t size,
             }
         }
 
-        if (action == ACTION_SPLIT) {
+        // The aligned block may be of the exact size
+        // even if the found one was greater.
+        if (curr->size > size) {
             // Split the current block and put the new block after the one that we use.
             umf_result = split_current_block(coarse_provider, curr, size);
             if (umf_result != UMF_RESULT_SUCCESS) {
@@ -1254,15 +2006,18 @@ static umf_result_t coarse_memory_provider_alloc(void *provider, size_t size,
             LOG_DEBUG("coarse_ALLOC (split_block) %zu used %zu alloc %zu", size,
                       coarse_provider->used_size, coarse_provider->alloc_size);
 
-        } else { // action == ACTION_USE
+        } else { // the block is of the exact size
             LOG_DEBUG("coarse_ALLOC (same_block) %zu used %zu alloc %zu", size,
                       coarse_provider->used_size, coarse_provider->alloc_size);
         }
 
         curr->used = true;
+        curr->purge_state = BLOCK_NOT_PURGED;
         *resultPtr = curr->data;
         coarse_provider->used_size += size;
 
+        decay_tick(coarse_provider);
+
         assert(debug_check(coarse_provider));
         utils_mutex_unlock(&coarse_provider->lock);
 
@@ -1272,13 +2027,34 @@ static umf_result_t coarse_memory_provider_alloc(void *provider, size_t size,
     // no suitable block found - try to get more memory from the upstream provider
     umf_result = UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
 
+    if (!use_upstream) {
+        goto err_unlock;
+    }
+
     if (coarse_provider->upstream_memory_provider == NULL) {
         LOG_ERR("out of memory - no upstream memory provider given");
         goto err_unlock;
     }
 
-    umfMemoryProviderAlloc(coarse_provider->upstream_memory_provider, size,
-                           alignment, resultPtr);
+    // Small allocations are carved out of a larger upstream chunk.
+    size_t upstream_size = size;
+    size_t chunk_size = coarse_provider->upstream_chunk_size;
+    if (size < chunk_size && alignment < chunk_size - size) {
+        upstream_size = chunk_size;
+    }
+
+    *resultPtr = NULL;
+    coarse_provider->num_upstream_calls++;
+    umfMemoryProviderAlloc(coarse_provider->upstream_memory_provider,
+                           upstream_size, alignment, resultPtr);
+    if (*resultPtr == NULL && upstream_size > size) {
+        // try again with the exact size
+        upstream_size = size;
+        coarse_provider->num_upstream_calls++;
+        umfMemoryProviderAlloc(coarse_provider->upstream_memory_provider, size,
+                               alignment, resultPtr);
+    }
+
     if (*resultPtr == NULL) {
         LOG_ERR("out of memory - upstream memory provider allocation failed");
         goto err_unlock;
@@ -1286,29 +2062,43 @@ static umf_result_t coarse_memory_provider_alloc(void *provider, size_t size,
 
     ASSERT_IS_ALIGNED(((uintptr_t)(*resultPtr)), alignment);
 
-    umf_result = coarse_add_upstream_block(coarse_provider, *resultPtr, size);
+    umf_result =
+        coarse_add_upstream_block(coarse_provider, *resultPtr, upstream_size);
     if (umf_result != UMF_RESULT_SUCCESS) {
         if (!coarse_provider->disable_upstream_provider_free) {
             umfMemoryProviderFree(coarse_provider->upstream_memory_provider,
-                                  *resultPtr, size);
+                                  *resultPtr, upstream_size);
         }
         goto err_unlock;
     }
 
+    if (upstream_size > size) {
+        coarse_grow_upstream_chunk(coarse_provider);
+
+        // Put the rest of the chunk to the free blocks.
+        umf_result = coarse_free_chunk_rest(coarse_provider, *resultPtr, size);
+        if (umf_result != UMF_RESULT_SUCCESS) {
+            coarse_undo_upstream_chunk(coarse_provider, *resultPtr);
+            *resultPtr = NULL;
+            goto err_unlock;
+        }
+    }
+
     LOG_DEBUG("coarse_ALLOC (upstream) %zu used %zu alloc %zu", size,
               coarse_provider->used_size, coarse_provider->alloc_size);
 
     umf_result = UMF_RESULT_SUCCESS;
 
 err_unlock:
+    decay_tick(coarse_provider);
+
     assert(debug_check(coarse_provider));
     utils_mutex_unlock(&coarse_provider->lock);
 
     return umf_result;
 }
 
-static umf_result_t coarse_memory_provider_free(void *provider, void *ptr,
-                                                size_t bytes) {
+static umf_result_t coarse_heap_free(void *provider, void *ptr, size_t bytes) {
     coarse_memory_provider_t *coarse_provider =
         (struct coarse_memory_provider_t *)provider;
 
@@ -1355,13 +2145,15 @@ static umf_result_t coarse_memory_provider_free(void *provider, void *ptr,
     node = free_block_merge_with_prev(coarse_provider, node);
     node = free_block_merge_with_next(coarse_provider, node);
 
-    int rv =
-        free_blocks_add(coarse_provider->free_blocks, get_node_block(node));
+    int rv = free_index_add(coarse_provider, get_node_block(node));
     if (rv) {
         utils_mutex_unlock(&coarse_provider->lock);
         return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
     }
 
+    coarse_auto_trim(coarse_provider, get_node_block(node));
+    decay_tick(coarse_provider);
+
     assert(debug_check(coarse_provider));
     utils_mutex_unlock(&coarse_provider->lock);
 
@@ -1449,6 +2241,20 @@ static void ravl_cb_count_free(void *data, void *arg) {
     }
 }
 
+static size_t tlsf_count(tlsf_index_t *index) {
+    size_t num_free_blocks = 0;
+    for (size_t fl = 0; fl < TLSF_FL_COUNT; fl++) {
+        for (size_t sl = 0; sl < TLSF_SL_COUNT; sl++) {
+            for (block_t *block = index->heads[fl][sl]; block;
+                 block = block->free_next) {
+                num_free_blocks++;
+            }
+        }
+    }
+
+    return num_free_blocks;
+}
+
 static umf_result_t
 coarse_memory_provider_get_stats(void *provider,
                                  coarse_memory_provider_stats_t *stats) {
@@ -1464,14 +2270,19 @@ coarse_memory_provider_get_stats(void *provider,
     ravl_foreach(coarse_provider->all_blocks, ravl_cb_count, &num_all_blocks);
 
     size_t num_free_blocks = 0;
-    ravl_foreach(coarse_provider->free_blocks, ravl_cb_count_free,
-                 &num_free_blocks);
+    if (coarse_provider->free_index) {
+        num_free_blocks = tlsf_count(coarse_provider->free_index);
+    } else {
+        ravl_foreach(coarse_provider->free_blocks, ravl_cb_count_free,
+                     &num_free_blocks);
+    }
 
     stats->alloc_size = coarse_provider->alloc_size;
     stats->used_size = coarse_provider->used_size;
     stats->num_upstream_blocks = num_upstream_blocks;
     stats->num_all_blocks = num_all_blocks;
     stats->num_free_blocks = num_free_blocks;
+    stats->num_upstream_calls = coarse_provider->num_upstream_calls;
 
     return UMF_RESULT_SUCCESS;
 }
@@ -1510,10 +2321,9 @@ static umf_result_t coarse_memory_provider_purge_force(void *provider,
         coarse_provider->upstream_memory_provider, ptr, size);
 }
 
-static umf_result_t coarse_memory_provider_allocation_split(void *provider,
-                                                            void *ptr,
-                                                            size_t totalSize,
-                                                            size_t firstSize) {
+static umf_result_t coarse_heap_allocation_split(void *provider, void *ptr,
+                                                 size_t totalSize,
+                                                 size_t firstSize) {
     if (provider == NULL || ptr == NULL || (firstSize >= totalSize) ||
         firstSize == 0) {
         return UMF_RESULT_ERROR_INVALID_ARGUMENT;
@@ -1552,9 +2362,9 @@ static umf_result_t coarse_memory_provider_allocation_split(void *provider,
         goto err_mutex_unlock;
     }
 
-    block_t *new_block = coarse_ravl_add_new(coarse_provider->all_blocks,
-                                             block->data + firstSize,
-                                             block->size - firstSize, NULL);
+    block_t *new_block = coarse_ravl_add_new(
+        coarse_provider->all_blocks, coarse_provider->block_pool,
+        block->data + firstSize, block->size - firstSize, NULL);
     if (new_block == NULL) {
         umf_result = UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
         goto err_mutex_unlock;
@@ -1574,10 +2384,9 @@ err_mutex_unlock:
     return umf_result;
 }
 
-static umf_result_t coarse_memory_provider_allocation_merge(void *provider,
-                                                            void *lowPtr,
-                                                            void *highPtr,
-                                                            size_t totalSize) {
+static umf_result_t coarse_heap_allocation_merge(void *provider, void *lowPtr,
+                                                 void *highPtr,
+                                                 size_t totalSize) {
     if (provider == NULL || lowPtr == NULL || highPtr == NULL ||
         ((uintptr_t)highPtr <= (uintptr_t)lowPtr) ||
         ((uintptr_t)highPtr - (uintptr_t)lowPtr >= totalSize)) {
@@ -1671,6 +2480,228 @@ err_mutex_unlock:
     return umf_result;
 }
 
+// The sub-heap used by the calling thread has the index
+// (TLS_heap_id - 1) modulo the number of sub-heaps.
+static __TLS uint64_t TLS_heap_id;
+static uint64_t Last_heap_id;
+
+static size_t
+coarse_get_thread_heap_idx(coarse_memory_provider_t *coarse_provider) {
+    if (TLS_heap_id == 0) {
+        TLS_heap_id = utils_atomic_increment(&Last_heap_id);
+    }
+
+    return (size_t)((TLS_heap_id - 1) % coarse_provider->num_heaps);
+}
+
+// coarse_find_heap - find the sub-heap owning the given memory
+static coarse_memory_provider_t *
+coarse_find_heap(coarse_memory_provider_t *coarse_provider, void *ptr) {
+    if (!coarse_provider->heaps) {
+        return coarse_provider;
+    }
+
+    uintptr_t key = 0;
+    void *heap = NULL;
+    if (!critnib_find(coarse_provider->heap_ranges, (uintptr_t)ptr, FIND_LE,
+                      &key, &heap) ||
+        !heap) {
+        // the heap of the provider reports the error
+        return coarse_provider;
+    }
+
+    return (coarse_memory_provider_t *)heap;
+}
+
+static umf_result_t coarse_memory_provider_initialize(void *params,
+                                                      void **provider) {
+    assert(provider);
+
+    if (params == NULL) {
+        LOG_ERR("coarse provider parameters are missing");
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    coarse_memory_provider_params_t *coarse_params =
+        (coarse_memory_provider_params_t *)params;
+
+    size_t num_heaps = coarse_params->num_heaps;
+    if (num_heaps <= 1) {
+        return coarse_heap_initialize(coarse_params, NULL, provider);
+    }
+
+    // The initial buffer is split evenly between the sub-heaps.
+    size_t heap_init_size = ALIGN_DOWN(
+        coarse_params->init_buffer_size / num_heaps, utils_get_page_size());
+    if (coarse_params->init_buffer_size && heap_init_size == 0) {
+        LOG_ERR("init_buffer_size is too small to be split into %zu heaps",
+                num_heaps);
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    coarse_memory_provider_t **heaps =
+        umf_ba_global_alloc(num_heaps * sizeof(*heaps));
+    if (!heaps) {
+        LOG_ERR("out of the host memory");
+        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    critnib *heap_ranges = critnib_new();
+    if (!heap_ranges) {
+        LOG_ERR("out of the host memory");
+        umf_ba_global_free(heaps);
+        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+    }
+
+    umf_result_t umf_result = UMF_RESULT_SUCCESS;
+    size_t i;
+    for (i = 0; i < num_heaps; i++) {
+        coarse_memory_provider_params_t heap_params = *coarse_params;
+        heap_params.num_heaps = 1;
+
+        // only the first heap destroys the upstream provider
+        // and it is finalized as the last one
+        if (i > 0) {
+            heap_params.destroy_upstream_memory_provider = false;
+        }
+
+        if (i < num_heaps - 1) {
+            heap_params.init_buffer_size = heap_init_size;
+        } else {
+            heap_params.init_buffer_size =
+                coarse_params->init_buffer_size - i * heap_init_size;
+        }
+
+        if (coarse_params->init_buffer) {
+            heap_params.init_buffer =
+                (char *)coarse_params->init_buffer + i * heap_init_size;
+        }
+
+        umf_result = coarse_heap_initialize(&heap_params, heap_ranges,
+                                            (void **)&heaps[i]);
+        if (umf_result != UMF_RESULT_SUCCESS) {
+            break;
+        }
+    }
+
+    if (umf_result != UMF_RESULT_SUCCESS) {
+        if (i > 0) {
+            // the upstream provider is owned by the caller on error
+            heaps[0]->destroy_upstream_memory_provider = false;
+        }
+        while (i-- > 0) {
+            coarse_heap_finalize(heaps[i]);
+        }
+        critnib_delete(heap_ranges);
+        umf_ba_global_free(heaps);
+        return umf_result;
+    }
+
+    coarse_memory_provider_t *coarse_provider = heaps[0];
+    coarse_provider->heaps = heaps;
+    coarse_provider->num_heaps = num_heaps;
+
+    *provider = coarse_provider;
+
+    return UMF_RESULT_SUCCESS;
+}
+
+static void coarse_memory_provider_finalize(void *provider) {
+    coarse_memory_provider_t *coarse_provider =
+        (struct coarse_memory_provider_t *)provider;
+
+    coarse_memory_provider_t **heaps = coarse_provider->heaps;
+    if (!heaps) {
+        coarse_heap_finalize(coarse_provider);
+        return;
+    }
+
+    critnib *heap_ranges = coarse_provider->heap_ranges;
+
+    // the first heap (the provider itself) may destroy
+    // the upstream provider, so it is finalized as the last one
+    for (size_t i = coarse_provider->num_heaps; i-- > 0;) {
+        coarse_heap_finalize(heaps[i]);
+    }
+
+    critnib_delete(heap_ranges);
+    umf_ba_global_free(heaps);
+}
+
+static umf_result_t coarse_memory_provider_alloc(void *provider, size_t size,
+                                                 size_t alignment,
+                                                 void **resultPtr) {
+    coarse_memory_provider_t *coarse_provider =
+        (struct coarse_memory_provider_t *)provider;
+
+    if (!coarse_provider->heaps) {
+        return coarse_heap_alloc(coarse_provider, size, alignment, true,
+                                 resultPtr);
+    }
+
+    // Look for a free block in the heap of this thread first,
+    // then steal it from the other heaps.
+    size_t num_heaps = coarse_provider->num_heaps;
+    size_t heap_idx = coarse_get_thread_heap_idx(coarse_provider);
+    for (size_t i = 0; i < num_heaps; i++) {
+        coarse_memory_provider_t *heap =
+            coarse_provider->heaps[(heap_idx + i) % num_heaps];
+        umf_result_t umf_result =
+            coarse_heap_alloc(heap, size, alignment, false, resultPtr);
+        if (umf_result != UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY) {
+            return umf_result;
+        }
+    }
+
+    // None of the heaps has a suitable free block,
+    // get more memory to the heap of this thread.
+    return coarse_heap_alloc(coarse_provider->heaps[heap_idx], size, alignment,
+                             true, resultPtr);
+}
+
+static umf_result_t coarse_memory_provider_free(void *provider, void *ptr,
+                                                size_t bytes) {
+    coarse_memory_provider_t *heap =
+        coarse_find_heap((struct coarse_memory_provider_t *)provider, ptr);
+
+    return coarse_heap_free(heap, ptr, bytes);
+}
+
+static umf_result_t coarse_memory_provider_allocation_split(void *provider,
+                                                            void *ptr,
+                                                            size_t totalSize,
+                                                            size_t firstSize) {
+    if (provider == NULL) {
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    coarse_memory_provider_t *heap =
+        coarse_find_heap((struct coarse_memory_provider_t *)provider, ptr);
+
+    return coarse_heap_allocation_split(heap, ptr, totalSize, firstSize);
+}
+
+static umf_result_t coarse_memory_provider_allocation_merge(void *provider,
+                                                            void *lowPtr,
+                                                            void *highPtr,
+                                                            size_t totalSize) {
+    if (provider == NULL) {
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    coarse_memory_provider_t *heap =
+        coarse_find_heap((struct coarse_memory_provider_t *)provider, lowPtr);
+
+    // memory of different heaps cannot be merged
+    if (heap != coarse_find_heap((struct coarse_memory_provider_t *)provider,
+                                 highPtr)) {
+        LOG_ERR("given pointers cannot be merged");
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    return coarse_heap_allocation_merge(heap, lowPtr, highPtr, totalSize);
+}
+
 umf_memory_provider_ops_t UMF_COARSE_MEMORY_PROVIDER_OPS = {
     .version = UMF_VERSION_CURRENT,
     .initialize = coarse_memory_provider_initialize,
@@ -1713,14 +2744,121 @@ umfCoarseMemoryProviderGetStats(umf_memory_provider_handle_t provider) {
     coarse_memory_provider_t *coarse_provider =
         (struct coarse_memory_provider_t *)priv;
 
+    // sum up the stats of all sub-heaps
+    size_t num_heaps = coarse_provider->heaps ? coarse_provider->num_heaps : 1;
+    for (size_t i = 0; i < num_heaps; i++) {
+        coarse_memory_provider_t *heap = coarse_provider->heaps
+                                             ? coarse_provider->heaps[i]
+                                             : coarse_provider;
+        coarse_memory_provider_stats_t heap_stats = {0};
+
+        if (utils_mutex_lock(&heap->lock) != 0) {
+            LOG_ERR("locking the lock failed");
+            return stats;
+        }
+
+        coarse_memory_provider_get_stats(heap, &heap_stats);
+
+        utils_mutex_unlock(&heap->lock);
+
+        stats.alloc_size += heap_stats.alloc_size;
+        stats.used_size += heap_stats.used_size;
+        stats.num_upstream_blocks += heap_stats.num_upstream_blocks;
+        stats.num_all_blocks += heap_stats.num_all_blocks;
+        stats.num_free_blocks += heap_stats.num_free_blocks;
+        stats.num_upstream_calls += heap_stats.num_upstream_calls;
+    }
+
+    return stats;
+}
+
+// coarse_heap_trim - return entirely free upstream blocks of the sub-heap
+// to the upstream provider (or purge them if its free() is not supported)
+// keeping at least retained_size bytes of free memory
+static umf_result_t coarse_heap_trim(coarse_memory_provider_t *coarse_provider,
+                                     size_t retained_size) {
+    if (coarse_provider->upstream_memory_provider == NULL) {
+        // the memory of the init buffer cannot be returned
+        return UMF_RESULT_SUCCESS;
+    }
+
     if (utils_mutex_lock(&coarse_provider->lock) != 0) {
         LOG_ERR("locking the lock failed");
-        return stats;
+        return UMF_RESULT_ERROR_UNKNOWN;
     }
 
-    coarse_memory_provider_get_stats(priv, &stats);
+    assert(debug_check(coarse_provider));
+
+    umf_result_t umf_result = UMF_RESULT_SUCCESS;
+    size_t free_size = coarse_provider->alloc_size - coarse_provider->used_size;
+
+    ravl_node_t *node = ravl_first(coarse_provider->upstream_blocks);
+    while (node && free_size > retained_size) {
+        block_t *alloc = get_node_block(node);
+        ravl_data_t data = {(uintptr_t)alloc->data, NULL};
+        size_t size = alloc->size;
+
+        block_t *block = coarse_get_free_upstream_block(coarse_provider, alloc);
+        if (block && free_size - retained_size >= size) {
+            if (coarse_provider->disable_upstream_provider_free) {
+                if (block->purge_state != BLOCK_PURGED_FORCE) {
+                    umf_result = umfMemoryProviderPurgeForce(
+                        coarse_provider->upstream_memory_provider, block->data,
+                        size);
+                    if (umf_result == UMF_RESULT_SUCCESS) {
+                        decay_rm(coarse_provider, block);
+                        block->purge_state = BLOCK_PURGED_FORCE;
+                    }
+                }
+            } else {
+                // it removes the node
+                umf_result = coarse_release_upstream_block(coarse_provider,
+                                                           alloc, block);
+            }
 
+            if (umf_result != UMF_RESULT_SUCCESS) {
+                break;
+            }
+
+            free_size -= size;
+        }
+
+        node = ravl_find(coarse_provider->upstream_blocks, &data,
+                         RAVL_PREDICATE_GREATER);
+    }
+
+    decay_tick(coarse_provider);
+
+    assert(debug_check(coarse_provider));
     utils_mutex_unlock(&coarse_provider->lock);
 
-    return stats;
+    return umf_result;
+}
+
+umf_result_t umfCoarseMemoryProviderTrim(umf_memory_provider_handle_t provider,
+                                         size_t retained_size) {
+    if (provider == NULL) {
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    void *priv = umfMemoryProviderGetPriv(provider);
+
+    coarse_memory_provider_t *coarse_provider =
+        (struct coarse_memory_provider_t *)priv;
+
+    if (coarse_provider->heaps == NULL) {
+        return coarse_heap_trim(coarse_provider, retained_size);
+    }
+
+    // the retained memory is split evenly between the sub-heaps
+    size_t num_heaps = coarse_provider->num_heaps;
+    for (size_t i = 0; i < num_heaps; i++) {
+        umf_result_t umf_result = coarse_heap_trim(coarse_provider->heaps[i],
+                                                   retained_size / num_heaps);
+        if (umf_result != UMF_RESULT_SUCCESS) {
+            return umf_result;
+        }
+    }
+
+    return UMF_RESULT_SUCCESS;
 }
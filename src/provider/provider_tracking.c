@@ -28,23 +28,175 @@
 typedef struct tracker_value_t {
     umf_memory_pool_handle_t pool;
     size_t size;
+
+    // the entries of one pool are linked in its tracker_pool_index_t
+    uintptr_t key;
+    struct tracker_value_t *next;
+    // set (to 1) when the value is deleted, it is freed only when
+    // it is pruned from the index
+    uint64_t removed;
 } tracker_value_t;
 
+// Per-pool index of the tracker's entries. All entries of the pool
+// are linked in a list, so that they can be found (when the pool is destroyed)
+// without scanning the entries of all the other pools in the tracker's map.
+//
+// The index takes no lock: new values are pushed at the head of the list
+// with a compare-and-swap and deleted values are only marked as removed.
+// The removed values are unlinked and freed by one thread at a time
+// (the 'pruning' flag) when they outnumber the values still in use,
+// and by the pool's finalize. Only the pruning thread changes the 'next'
+// links of the values already in the list and pushing reads only the head,
+// so both can run concurrently.
+typedef struct tracker_pool_index_t {
+    umf_memory_pool_handle_t pool;
+    tracker_value_t *head;
+    uint64_t n_linked;  // number of values in the list
+    uint64_t n_removed; // number of values in the list marked as removed
+    uint64_t pruning;   // 1 while a thread prunes the list
+} tracker_pool_index_t;
+
+// the index is pruned only if it has at least this many removed values
+#define TRACKER_INDEX_PRUNE_MIN 64
+
+static tracker_value_t *tracker_index_load_head(tracker_pool_index_t *index) {
+    void *src = &index->head;
+    tracker_value_t *head;
+    void *dst = &head;
+    utils_atomic_load_acquire((uintptr_t *)src, (uintptr_t *)dst);
+    return head;
+}
+
+static void tracker_index_link(tracker_pool_index_t *index,
+                               tracker_value_t *value) {
+    value->removed = 0;
+    utils_atomic_increment(&index->n_linked);
+
+    tracker_value_t *head = tracker_index_load_head(index);
+    do {
+        value->next = head;
+    } while (!utils_compare_exchange(&index->head, &head, value));
+}
+
+// Unlinks and frees the removed values of the index.
+// It does nothing if another thread is already pruning it.
+static void tracker_index_prune(umf_memory_tracker_handle_t hTracker,
+                                tracker_pool_index_t *index) {
+    uint64_t not_pruning = 0;
+    if (!utils_compare_exchange(&index->pruning, &not_pruning, 1)) {
+        return;
+    }
+
+    tracker_value_t *head = tracker_index_load_head(index);
+
+    uint64_t n_pruned = 0;
+    uint64_t removed;
+
+    // the head can be replaced by concurrent pushes, so it is pruned last
+    tracker_value_t *prev = head;
+    tracker_value_t *value = head ? head->next : NULL;
+    while (value) {
+        tracker_value_t *next = value->next;
+        utils_atomic_load_acquire(&value->removed, &removed);
+        if (removed) {
+            prev->next = next;
+            umf_ba_free(hTracker->tracker_allocator, value);
+            n_pruned++;
+        } else {
+            prev = value;
+        }
+        value = next;
+    }
+
+    if (head) {
+        utils_atomic_load_acquire(&head->removed, &removed);
+        tracker_value_t *expected = head;
+        if (removed &&
+            utils_compare_exchange(&index->head, &expected, head->next)) {
+            umf_ba_free(hTracker->tracker_allocator, head);
+            n_pruned++;
+        }
+    }
+
+    utils_fetch_and_add64(&index->n_removed, -(int64_t)n_pruned);
+    utils_fetch_and_add64(&index->n_linked, -(int64_t)n_pruned);
+
+    utils_atomic_store_release(&index->pruning, 0);
+}
+
+// Marks the value as removed. The value is freed when the index is pruned,
+// so it must not be used after this call.
+static void tracker_index_unlink(umf_memory_tracker_handle_t hTracker,
+                                 tracker_pool_index_t *index,
+                                 tracker_value_t *value) {
+    utils_atomic_store_release(&value->removed, 1);
+
+    uint64_t n_removed = utils_atomic_increment(&index->n_removed);
+    uint64_t n_linked;
+    utils_atomic_load_acquire(&index->n_linked, &n_linked);
+    if (n_removed >= TRACKER_INDEX_PRUNE_MIN && 2 * n_removed > n_linked) {
+        tracker_index_prune(hTracker, index);
+    }
+}
+
+// Allocates a new value of the entry 'key' of the pool of 'index'
+// and links it in the index.
+static tracker_value_t *tracker_value_new(umf_memory_tracker_handle_t hTracker,
+                                          tracker_pool_index_t *index,
+                                          uintptr_t key, size_t size) {
+    tracker_value_t *value = umf_ba_alloc(hTracker->tracker_allocator);
+    if (value == NULL) {
+        return NULL;
+    }
+
+    value->pool = index->pool;
+    value->size = size;
+    value->key = key;
+    tracker_index_link(index, value);
+
+    return value;
+}
+
+// Marks the value as removed from the index, which frees it later.
+// It has to be removed from (or replaced in) the tracker's map before.
+static void tracker_value_delete(umf_memory_tracker_handle_t hTracker,
+                                 tracker_pool_index_t *index,
+                                 tracker_value_t *value) {
+    tracker_index_unlink(hTracker, index, value);
+}
+
+// Per-thread cache of the regions recently found in the tracker.
+// All entries are valid only as long as the change counter of the tracker's
+// map is the same as it was before they were looked up (nothing was removed
+// or replaced since then) and the tracker is the same one.
+#define TRACKER_CACHE_SIZE 4
+
+typedef struct tracker_cache_t {
+    uint64_t tracker_id;
+    uint64_t change_count;
+    unsigned next; // the next entry to be replaced
+    umf_alloc_info_t entries[TRACKER_CACHE_SIZE];
+} tracker_cache_t;
+
+static __TLS tracker_cache_t Tracker_cache;
+
+// the last id given to a tracker (0 is never used)
+static uint64_t Last_tracker_id;
+
 static umf_result_t umfMemoryTrackerAdd(umf_memory_tracker_handle_t hTracker,
-                                        umf_memory_pool_handle_t pool,
+                                        tracker_pool_index_t *index,
                                         const void *ptr, size_t size) {
     assert(ptr);
 
-    tracker_value_t *value = umf_ba_alloc(hTracker->tracker_allocator);
+    umf_memory_pool_handle_t pool = index->pool;
+    tracker_value_t *value =
+        tracker_value_new(hTracker, index, (uintptr_t)ptr, size);
     if (value == NULL) {
         LOG_ERR("failed to allocate tracker value, ptr=%p, size=%zu", ptr,
                 size);
         return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
     }
 
-    value->pool = pool;
-    value->size = size;
-
     int ret = critnib_insert(hTracker->map, (uintptr_t)ptr, value, 0);
 
     if (ret == 0) {
@@ -57,7 +209,7 @@ static umf_result_t umfMemoryTrackerAdd(umf_memory_tracker_handle_t hTracker,
     LOG_ERR("failed to insert tracker value, ret=%d, ptr=%p, pool=%p, size=%zu",
             ret, ptr, (void *)pool, size);
 
-    umf_ba_free(hTracker->tracker_allocator, value);
+    tracker_value_delete(hTracker, index, value);
 
     if (ret == ENOMEM) {
         return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
@@ -66,29 +218,161 @@ static umf_result_t umfMemoryTrackerAdd(umf_memory_tracker_handle_t hTracker,
     return UMF_RESULT_ERROR_UNKNOWN;
 }
 
-static umf_result_t umfMemoryTrackerRemove(umf_memory_tracker_handle_t hTracker,
-                                           const void *ptr) {
-    assert(ptr);
+// Replaces 'value' of an existing entry with 'new_value' of the same key.
+// It cannot fail (there is nothing to allocate). The update bumps the change
+// counter of the map, so no stale copy of the old value can be returned
+// from the lookup cache.
+static void tracker_replace_value(umf_memory_tracker_handle_t hTracker,
+                                  tracker_pool_index_t *index,
+                                  tracker_value_t *value,
+                                  tracker_value_t *new_value) {
+    assert(new_value->key == value->key);
+
+    int ret =
+        critnib_insert(hTracker->map, value->key, new_value, 1 /* update */);
+    // this cannot fail since we know the element exists (nothing to allocate)
+    assert(ret == 0);
+    (void)ret;
 
-    // TODO: there is no support for removing partial ranges (or multiple entries
-    // in a single remove call) yet.
-    // Every umfMemoryTrackerAdd(..., ptr, ...) should have a corresponding
-    // umfMemoryTrackerRemove call with the same ptr value.
+    tracker_value_delete(hTracker, index, value);
+}
 
-    void *value = critnib_remove(hTracker->map, (uintptr_t)ptr);
-    if (!value) {
-        LOG_ERR("pointer %p not found in the map", ptr);
+// Removes the range [ptr, ptr + size) from the tracker. The range can cover
+// any number of entries, and the entries overlapping it only partially
+// are trimmed (the part left below 'ptr' keeps its key and the part left
+// above the range is added as a new entry).
+// All entries overlapping the range are checked and everything that can fail
+// is done before the first entry is changed, so on failure the tracker
+// is left unchanged. The caller owns the whole range, so no other thread
+// can modify the entries overlapping it concurrently.
+static umf_result_t
+umfMemoryTrackerRemoveRange(umf_memory_tracker_handle_t hTracker,
+                            tracker_pool_index_t *index, const void *ptr,
+                            size_t size) {
+    uintptr_t start = (uintptr_t)ptr;
+    uintptr_t end = start + size;
+    uintptr_t rkey;
+    tracker_value_t *rvalue;
+    size_t n_items = 0;
+    umf_result_t ret;
+
+    // the entry starting below the range and overlapping it
+    tracker_value_t *head = NULL;
+    // the end of the entry overlapping the end of the range
+    uintptr_t tail_end = 0;
+
+    if (critnib_find(hTracker->map, start, FIND_L, &rkey, (void **)&rvalue) &&
+        rkey + rvalue->size > start) {
+        if (rvalue->pool != index->pool) {
+            goto err_pool_mismatch;
+        }
+
+        head = rvalue;
+        tail_end = rkey + rvalue->size;
+        n_items++;
+    }
+
+    // check the entries starting inside the range
+    enum find_dir_t dir = FIND_GE;
+    uintptr_t key = start;
+    while (critnib_find(hTracker->map, key, dir, &rkey, (void **)&rvalue) &&
+           rkey < end) {
+        if (rvalue->pool != index->pool) {
+            goto err_pool_mismatch;
+        }
+
+        tail_end = rkey + rvalue->size;
+        n_items++;
+        key = rkey;
+        dir = FIND_G;
+    }
+
+    if (n_items == 0) {
+        LOG_ERR("range %p-%p not found in the map", ptr, (void *)end);
         return UMF_RESULT_ERROR_UNKNOWN;
     }
 
-    tracker_value_t *v = value;
+    tracker_value_t *new_head = NULL;
+    if (head) {
+        new_head = tracker_value_new(hTracker, index, head->key,
+                                     start - head->key);
+        if (!new_head) {
+            return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+        }
+    }
 
-    LOG_DEBUG("memory region removed: tracker=%p, ptr=%p, size=%zu",
-              (void *)hTracker, ptr, v->size);
+    if (tail_end > end) {
+        // keep the part of the entry above the range
+        ret = umfMemoryTrackerAdd(hTracker, index, (void *)end,
+                                  tail_end - end);
+        if (ret != UMF_RESULT_SUCCESS) {
+            if (new_head) {
+                tracker_value_delete(hTracker, index, new_head);
+            }
+            return ret;
+        }
+    }
+
+    // nothing below can fail
+    if (head) {
+        tracker_replace_value(hTracker, index, head, new_head);
+    }
 
-    umf_ba_free(hTracker->tracker_allocator, value);
+    key = start;
+    while (critnib_find(hTracker->map, key, FIND_GE, &rkey,
+                        (void **)&rvalue) &&
+           rkey < end) {
+        void *removed_value = critnib_remove(hTracker->map, rkey);
+        assert(removed_value == rvalue);
+        tracker_value_delete(hTracker, index, removed_value);
+        key = rkey;
+    }
+
+    LOG_DEBUG("memory range removed: tracker=%p, ptr=%p, size=%zu, "
+              "entries=%zu",
+              (void *)hTracker, ptr, size, n_items);
 
     return UMF_RESULT_SUCCESS;
+
+err_pool_mismatch:
+    LOG_ERR("memory region %p belongs to pool %p, not %p", (void *)rkey,
+            (void *)rvalue->pool, (void *)index->pool);
+    return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+}
+
+// Removes the range [ptr, ptr + size) from the tracker.
+// If size is 0, the whole entry starting at ptr is removed.
+static umf_result_t umfMemoryTrackerRemove(umf_memory_tracker_handle_t hTracker,
+                                           tracker_pool_index_t *index,
+                                           const void *ptr, size_t size) {
+    assert(ptr);
+
+    tracker_value_t *v = critnib_get(hTracker->map, (uintptr_t)ptr);
+    if (v && v->pool != index->pool) {
+        LOG_ERR("memory region %p belongs to pool %p, not %p", ptr,
+                (void *)v->pool, (void *)index->pool);
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    if (v && (size == 0 || v->size == size)) {
+        // the most common case - the exact entry is removed
+        void *value = critnib_remove(hTracker->map, (uintptr_t)ptr);
+        assert(value == v);
+
+        LOG_DEBUG("memory region removed: tracker=%p, ptr=%p, size=%zu",
+                  (void *)hTracker, ptr, v->size);
+
+        tracker_value_delete(hTracker, index, value);
+
+        return UMF_RESULT_SUCCESS;
+    }
+
+    if (size == 0) {
+        LOG_ERR("pointer %p not found in the map", ptr);
+        return UMF_RESULT_ERROR_UNKNOWN;
+    }
+
+    return umfMemoryTrackerRemoveRange(hTracker, index, ptr, size);
 }
 
 umf_memory_pool_handle_t umfMemoryTrackerGetPool(const void *ptr) {
@@ -116,6 +400,24 @@ umf_result_t umfMemoryTrackerGetAllocInfo(const void *ptr,
         return UMF_RESULT_ERROR_NOT_SUPPORTED;
     }
 
+    tracker_cache_t *cache = &Tracker_cache;
+    uint64_t change_count = critnib_change_count(TRACKER->map);
+    if (cache->tracker_id == TRACKER->id &&
+        cache->change_count == change_count) {
+        for (unsigned i = 0; i < TRACKER_CACHE_SIZE; i++) {
+            umf_alloc_info_t *entry = &cache->entries[i];
+            if ((uintptr_t)ptr - (uintptr_t)entry->base < entry->baseSize) {
+                *pAllocInfo = *entry;
+                return UMF_RESULT_SUCCESS;
+            }
+        }
+    } else {
+        // the cached regions may be stale
+        memset(cache, 0, sizeof(*cache));
+        cache->tracker_id = TRACKER->id;
+        cache->change_count = change_count;
+    }
+
     uintptr_t rkey;
     tracker_value_t *rvalue;
     int found = critnib_find(TRACKER->map, (uintptr_t)ptr, FIND_LE,
@@ -131,6 +433,14 @@ umf_result_t umfMemoryTrackerGetAllocInfo(const void *ptr,
     pAllocInfo->baseSize = rvalue->size;
     pAllocInfo->pool = rvalue->pool;
 
+    // The change counter is incremented only after an entry is removed
+    // or replaced. If it was changed during the lookup, the found entry
+    // may be being removed, so it is not cached.
+    if (critnib_change_count(TRACKER->map) == change_count) {
+        cache->entries[cache->next] = *pAllocInfo;
+        cache->next = (cache->next + 1) % TRACKER_CACHE_SIZE;
+    }
+
     return UMF_RESULT_SUCCESS;
 }
 
@@ -148,6 +458,9 @@ typedef struct umf_tracking_memory_provider_t {
     umf_memory_pool_handle_t pool;
     critnib *ipcCache;
 
+    // the tracker's entries of this pool
+    tracker_pool_index_t index;
+
     // the upstream provider does not support the free() operation
     bool upstreamDoesNotFree;
 } umf_tracking_memory_provider_t;
@@ -167,7 +480,7 @@ static umf_result_t trackingAlloc(void *hProvider, size_t size,
         return ret;
     }
 
-    umf_result_t ret2 = umfMemoryTrackerAdd(p->hTracker, p->pool, *ptr, size);
+    umf_result_t ret2 = umfMemoryTrackerAdd(p->hTracker, &p->index, *ptr, size);
     if (ret2 != UMF_RESULT_SUCCESS) {
         LOG_ERR("failed to add allocated region to the tracker, ptr = %p, size "
                 "= %zu, ret = %d",
@@ -183,75 +496,71 @@ static umf_result_t trackingAllocationSplit(void *hProvider, void *ptr,
     umf_result_t ret = UMF_RESULT_ERROR_UNKNOWN;
     umf_tracking_memory_provider_t *provider =
         (umf_tracking_memory_provider_t *)hProvider;
+    umf_memory_tracker_handle_t hTracker = provider->hTracker;
 
-    tracker_value_t *splitValue =
-        umf_ba_alloc(provider->hTracker->tracker_allocator);
-    if (!splitValue) {
-        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
-    }
-
-    splitValue->pool = provider->pool;
-    splitValue->size = firstSize;
-
-    int r = utils_mutex_lock(&provider->hTracker->splitMergeMutex);
-    if (r) {
-        goto err_lock;
-    }
-
+    // The caller owns the whole region, so no other thread can modify
+    // the entries of this region concurrently and each of the steps below
+    // is a single (atomic) operation on the tracker's map.
     tracker_value_t *value =
-        (tracker_value_t *)critnib_get(provider->hTracker->map, (uintptr_t)ptr);
+        (tracker_value_t *)critnib_get(hTracker->map, (uintptr_t)ptr);
     if (!value) {
         LOG_ERR("region for split is not found in the tracker");
-        ret = UMF_RESULT_ERROR_INVALID_ARGUMENT;
-        goto err;
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+    if (value->pool != provider->pool) {
+        LOG_ERR("region for split belongs to another pool");
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
     if (value->size != totalSize) {
         LOG_ERR("tracked size %zu does not match requested size to split: %zu",
                 value->size, totalSize);
-        ret = UMF_RESULT_ERROR_INVALID_ARGUMENT;
-        goto err;
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
 
-    ret = umfMemoryProviderAllocationSplit(provider->hUpstream, ptr, totalSize,
-                                           firstSize);
-    if (ret != UMF_RESULT_SUCCESS) {
-        LOG_ERR("upstream provider failed to split the region");
-        goto err;
+    tracker_value_t *splitValue = tracker_value_new(
+        hTracker, &provider->index, (uintptr_t)ptr, firstSize);
+    if (!splitValue) {
+        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
     }
 
     void *highPtr = (void *)(((uintptr_t)ptr) + firstSize);
     size_t secondSize = totalSize - firstSize;
 
-    // We'll have a duplicate entry for the range [highPtr, highValue->size] but this is fine,
-    // the value is the same anyway and we forbid removing that range concurrently
-    ret = umfMemoryTrackerAdd(provider->hTracker, provider->pool, highPtr,
-                              secondSize);
+    // Add the high entry before splitting the region in the upstream provider,
+    // so that nothing has to be allocated after the split is done.
+    // We'll have a duplicate entry for the range [highPtr, highValue->size]
+    // but this is fine, the value is the same anyway.
+    ret = umfMemoryTrackerAdd(hTracker, &provider->index, highPtr, secondSize);
     if (ret != UMF_RESULT_SUCCESS) {
         LOG_ERR("failed to add split region to the tracker, ptr = %p, size "
                 "= %zu, ret = %d",
                 highPtr, secondSize, ret);
-        // TODO: what now? should we rollback the split? This can only happen due to ENOMEM
-        // so it's unlikely but probably the best solution would be to try to preallocate everything
-        // (value and critnib nodes) before calling umfMemoryProviderAllocationSplit.
-        goto err;
+        goto err_free_split_value;
     }
 
-    int cret = critnib_insert(provider->hTracker->map, (uintptr_t)ptr,
+    ret = umfMemoryProviderAllocationSplit(provider->hUpstream, ptr, totalSize,
+                                           firstSize);
+    if (ret != UMF_RESULT_SUCCESS) {
+        LOG_ERR("upstream provider failed to split the region");
+        goto err_remove_high;
+    }
+
+    int cret = critnib_insert(hTracker->map, (uintptr_t)ptr,
                               (void *)splitValue, 1 /* update */);
     // this cannot fail since we know the element exists (nothing to allocate)
     assert(cret == 0);
     (void)cret;
 
     // free the original value
-    umf_ba_free(provider->hTracker->tracker_allocator, value);
-    utils_mutex_unlock(&provider->hTracker->splitMergeMutex);
+    tracker_value_delete(hTracker, &provider->index, value);
 
     return UMF_RESULT_SUCCESS;
 
-err:
-    utils_mutex_unlock(&provider->hTracker->splitMergeMutex);
-err_lock:
-    umf_ba_free(provider->hTracker->tracker_allocator, splitValue);
+err_remove_high:
+    tracker_value_delete(hTracker, &provider->index,
+                         critnib_remove(hTracker->map, (uintptr_t)highPtr));
+err_free_split_value:
+    tracker_value_delete(hTracker, &provider->index, splitValue);
     return ret;
 }
 
@@ -260,84 +569,62 @@ static umf_result_t trackingAllocationMerge(void *hProvider, void *lowPtr,
     umf_result_t ret = UMF_RESULT_ERROR_UNKNOWN;
     umf_tracking_memory_provider_t *provider =
         (umf_tracking_memory_provider_t *)hProvider;
+    umf_memory_tracker_handle_t hTracker = provider->hTracker;
 
-    tracker_value_t *mergedValue =
-        umf_ba_alloc(provider->hTracker->tracker_allocator);
-
-    if (!mergedValue) {
-        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
-    }
-
-    mergedValue->pool = provider->pool;
-    mergedValue->size = totalSize;
-
-    int r = utils_mutex_lock(&provider->hTracker->splitMergeMutex);
-    if (r) {
-        goto err_lock;
-    }
-
-    tracker_value_t *lowValue = (tracker_value_t *)critnib_get(
-        provider->hTracker->map, (uintptr_t)lowPtr);
+    // The caller owns both regions (see trackingAllocationSplit()).
+    tracker_value_t *lowValue =
+        (tracker_value_t *)critnib_get(hTracker->map, (uintptr_t)lowPtr);
     if (!lowValue) {
         LOG_ERR("no left value");
-        ret = UMF_RESULT_ERROR_INVALID_ARGUMENT;
-        goto err;
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
-    tracker_value_t *highValue = (tracker_value_t *)critnib_get(
-        provider->hTracker->map, (uintptr_t)highPtr);
+    tracker_value_t *highValue =
+        (tracker_value_t *)critnib_get(hTracker->map, (uintptr_t)highPtr);
     if (!highValue) {
         LOG_ERR("no right value");
-        ret = UMF_RESULT_ERROR_INVALID_ARGUMENT;
-        goto err;
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
-    if (lowValue->pool != highValue->pool) {
+    if (lowValue->pool != provider->pool ||
+        highValue->pool != provider->pool) {
         LOG_ERR("pool mismatch");
-        ret = UMF_RESULT_ERROR_INVALID_ARGUMENT;
-        goto err;
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
     if (lowValue->size + highValue->size != totalSize) {
         LOG_ERR("lowValue->size + highValue->size != totalSize");
-        ret = UMF_RESULT_ERROR_INVALID_ARGUMENT;
-        goto err;
+        return UMF_RESULT_ERROR_INVALID_ARGUMENT;
+    }
+
+    tracker_value_t *mergedValue = tracker_value_new(
+        hTracker, &provider->index, (uintptr_t)lowPtr, totalSize);
+    if (!mergedValue) {
+        return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
     }
 
     ret = umfMemoryProviderAllocationMerge(provider->hUpstream, lowPtr, highPtr,
                                            totalSize);
     if (ret != UMF_RESULT_SUCCESS) {
         LOG_WARN("upstream provider failed to merge regions");
-        goto not_merged;
+        tracker_value_delete(hTracker, &provider->index, mergedValue);
+        return ret;
     }
 
-    // We'll have a duplicate entry for the range [highPtr, highValue->size] but this is fine,
-    // the value is the same anyway and we forbid removing that range concurrently
-    int cret = critnib_insert(provider->hTracker->map, (uintptr_t)lowPtr,
+    // We'll have a duplicate entry for the range [highPtr, highValue->size]
+    // until it is removed below, but this is fine, the value is the same.
+    int cret = critnib_insert(hTracker->map, (uintptr_t)lowPtr,
                               (void *)mergedValue, 1 /* update */);
     // this cannot fail since we know the element exists (nothing to allocate)
     assert(cret == 0);
     (void)cret;
 
     // free old value that we just replaced with mergedValue
-    umf_ba_free(provider->hTracker->tracker_allocator, lowValue);
+    tracker_value_delete(hTracker, &provider->index, lowValue);
 
-    void *erasedhighValue =
-        critnib_remove(provider->hTracker->map, (uintptr_t)highPtr);
+    void *erasedhighValue = critnib_remove(hTracker->map, (uintptr_t)highPtr);
     assert(erasedhighValue == highValue);
 
-    umf_ba_free(provider->hTracker->tracker_allocator, erasedhighValue);
-
-    utils_mutex_unlock(&provider->hTracker->splitMergeMutex);
+    tracker_value_delete(hTracker, &provider->index, erasedhighValue);
 
     return UMF_RESULT_SUCCESS;
-
-err:
-    assert(0);
-
-not_merged:
-    utils_mutex_unlock(&provider->hTracker->splitMergeMutex);
-
-err_lock:
-    umf_ba_free(provider->hTracker->tracker_allocator, mergedValue);
-    return ret;
 }
 
 static umf_result_t trackingFree(void *hProvider, void *ptr, size_t size) {
@@ -351,7 +638,7 @@ static umf_result_t trackingFree(void *hProvider, void *ptr, size_t size) {
     // could allocate the memory at address `ptr` before a call to umfMemoryTrackerRemove
     // resulting in inconsistent state.
     if (ptr) {
-        ret_remove = umfMemoryTrackerRemove(p->hTracker, ptr);
+        ret_remove = umfMemoryTrackerRemove(p->hTracker, &p->index, ptr, size);
         if (ret_remove != UMF_RESULT_SUCCESS) {
             // DO NOT return an error here, because the tracking provider
             // cannot change behaviour of the upstream provider.
@@ -383,7 +670,7 @@ static umf_result_t trackingFree(void *hProvider, void *ptr, size_t size) {
             return ret;
         }
 
-        if (umfMemoryTrackerAdd(p->hTracker, p->pool, ptr, size) !=
+        if (umfMemoryTrackerAdd(p->hTracker, &p->index, ptr, size) !=
             UMF_RESULT_SUCCESS) {
             LOG_ERR(
                 "cannot add memory back to the tracker, ptr = %p, size = %zu",
@@ -408,15 +695,73 @@ static umf_result_t trackingInitialize(void *params, void **ret) {
         return UMF_RESULT_ERROR_INVALID_ARGUMENT;
     }
 
+    provider->index.pool = provider->pool;
+    provider->index.head = NULL;
+    provider->index.n_linked = 0;
+    provider->index.n_removed = 0;
+    provider->index.pruning = 0;
+
     *ret = provider;
     return UMF_RESULT_SUCCESS;
 }
 
+static void report_items_left(umf_memory_pool_handle_t pool, size_t n_items,
+                              bool upstreamDoesNotFree) {
+#ifndef NDEBUG
+    // print error messages only if provider supports the free() operation
+    if (n_items && !upstreamDoesNotFree) {
+        if (pool) {
+            LOG_ERR(
+                "tracking provider of pool %p is not empty! (%zu items left)",
+                (void *)pool, n_items);
+        } else {
+            LOG_ERR("tracking provider is not empty! (%zu items left)",
+                    n_items);
+        }
+    }
+#else  /* DEBUG */
+    (void)pool;                // unused in DEBUG build
+    (void)upstreamDoesNotFree; // unused in DEBUG build
+    (void)n_items;             // unused in DEBUG build
+#endif /* DEBUG */
+}
+
 // TODO clearing the tracker is a temporary solution and should be removed.
 // The tracker should be cleared using the provider's free() operation.
+// Only the entries of the pool (linked in its index) are visited,
+// so it does not depend on the number of entries of other pools.
+// The values already marked as removed are only freed.
+// No other thread can use the pool at this point.
 static void clear_tracker_for_the_pool(umf_memory_tracker_handle_t hTracker,
-                                       umf_memory_pool_handle_t pool,
+                                       tracker_pool_index_t *index,
                                        bool upstreamDoesNotFree) {
+    size_t n_items = 0;
+
+    tracker_value_t *value = index->head;
+    while (value) {
+        tracker_value_t *next = value->next;
+
+        if (!value->removed) {
+            void *removed_value = critnib_remove(hTracker->map, value->key);
+            assert(removed_value == value);
+            (void)removed_value;
+            n_items++;
+        }
+        umf_ba_free(hTracker->tracker_allocator, value);
+
+        value = next;
+    }
+
+    index->head = NULL;
+    index->n_linked = 0;
+    index->n_removed = 0;
+
+    report_items_left(index->pool, n_items, upstreamDoesNotFree);
+}
+
+// Removes all entries of all pools. The indexes of the pools are not updated,
+// so none of the pools can be used anymore.
+static void clear_tracker(umf_memory_tracker_handle_t hTracker) {
     uintptr_t rkey;
     void *rvalue;
     size_t n_items = 0;
@@ -424,12 +769,6 @@ static void clear_tracker_for_the_pool(umf_memory_tracker_handle_t hTracker,
 
     while (1 == critnib_find((critnib *)hTracker->map, last_key, FIND_G, &rkey,
                              &rvalue)) {
-        tracker_value_t *value = (tracker_value_t *)rvalue;
-        if (value->pool != pool && pool != NULL) {
-            last_key = rkey;
-            continue;
-        }
-
         n_items++;
 
         void *removed_value = critnib_remove(hTracker->map, rkey);
@@ -439,26 +778,7 @@ static void clear_tracker_for_the_pool(umf_memory_tracker_handle_t hTracker,
         last_key = rkey;
     }
 
-#ifndef NDEBUG
-    // print error messages only if provider supports the free() operation
-    if (n_items && !upstreamDoesNotFree) {
-        if (pool) {
-            LOG_ERR(
-                "tracking provider of pool %p is not empty! (%zu items left)",
-                (void *)pool, n_items);
-        } else {
-            LOG_ERR("tracking provider is not empty! (%zu items left)",
-                    n_items);
-        }
-    }
-#else  /* DEBUG */
-    (void)upstreamDoesNotFree; // unused in DEBUG build
-    (void)n_items;             // unused in DEBUG build
-#endif /* DEBUG */
-}
-
-static void clear_tracker(umf_memory_tracker_handle_t hTracker) {
-    clear_tracker_for_the_pool(hTracker, NULL, false);
+    report_items_left(NULL, n_items, false);
 }
 
 static void trackingFinalize(void *provider) {
@@ -471,7 +791,7 @@ static void trackingFinalize(void *provider) {
     // because it may need those resources till
     // the very end of exiting the application.
     if (!utils_is_running_in_proxy_lib()) {
-        clear_tracker_for_the_pool(p->hTracker, p->pool,
+        clear_tracker_for_the_pool(p->hTracker, &p->index,
                                    p->upstreamDoesNotFree);
     }
 
@@ -641,7 +961,7 @@ static umf_result_t trackingOpenIpcHandle(void *provider, void *providerIpcData,
         return ret;
     }
     size_t bufferSize = getDataSizeFromIpcHandle(providerIpcData);
-    ret = umfMemoryTrackerAdd(p->hTracker, p->pool, *ptr, bufferSize);
+    ret = umfMemoryTrackerAdd(p->hTracker, &p->index, *ptr, bufferSize);
     if (ret != UMF_RESULT_SUCCESS) {
         LOG_ERR("failed to add IPC region to the tracker, ptr=%p, size=%zu, "
                 "ret = %d",
@@ -665,7 +985,8 @@ static umf_result_t trackingCloseIpcHandle(void *provider, void *ptr,
     // could allocate the memory at address `ptr` before a call to umfMemoryTrackerRemove
     // resulting in inconsistent state.
     if (ptr) {
-        umf_result_t ret = umfMemoryTrackerRemove(p->hTracker, ptr);
+        umf_result_t ret =
+            umfMemoryTrackerRemove(p->hTracker, &p->index, ptr, size);
         if (ret != UMF_RESULT_SUCCESS) {
             // DO NOT return an error here, because the tracking provider
             // cannot change behaviour of the upstream provider.
@@ -749,23 +1070,18 @@ umf_memory_tracker_handle_t umfMemoryTrackerCreate(void) {
 
     handle->tracker_allocator = tracker_allocator;
 
-    void *mutex_ptr = utils_mutex_init(&handle->splitMergeMutex);
-    if (!mutex_ptr) {
+    handle->map = critnib_new_wide();
+    if (!handle->map) {
         goto err_destroy_tracker_allocator;
     }
 
-    handle->map = critnib_new();
-    if (!handle->map) {
-        goto err_destroy_mutex;
-    }
+    handle->id = utils_atomic_increment(&Last_tracker_id);
 
     LOG_DEBUG("tracker created, handle=%p, segment map=%p", (void *)handle,
               (void *)handle->map);
 
     return handle;
 
-err_destroy_mutex:
-    utils_mutex_destroy_not_free(&handle->splitMergeMutex);
 err_destroy_tracker_allocator:
     umf_ba_destroy(tracker_allocator);
 err_free_handle:
@@ -792,7 +1108,6 @@ void umfMemoryTrackerDestroy(umf_memory_tracker_handle_t handle) {
     // and used in many places.
     critnib_delete(handle->map);
     handle->map = NULL;
-    utils_mutex_destroy_not_free(&handle->splitMergeMutex);
     umf_ba_destroy(handle->tracker_allocator);
     handle->tracker_allocator = NULL;
     umf_ba_global_free(handle);
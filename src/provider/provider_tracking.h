@@ -29,7 +29,7 @@ extern "C" {
 struct umf_memory_tracker_t {
     umf_ba_pool_t *tracker_allocator;
     critnib *map;
-    utils_mutex_t splitMergeMutex;
+    uint64_t id; // unique id of the tracker (see the tracker lookup cache)
 };
 
 typedef struct umf_memory_tracker_t *umf_memory_tracker_handle_t;
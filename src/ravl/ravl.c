@@ -16,6 +16,7 @@
 #include "../src/utils/utils_common.h"
 #include "../src/utils/utils_concurrency.h"
 #include "assert.h"
+#include "base_alloc.h"
 #include "base_alloc_global.h"
 
 #include <errno.h>
@@ -46,6 +47,7 @@ struct ravl {
     struct ravl_node *root;
     ravl_compare *compare;
     size_t data_size;
+    umf_ba_pool_t *node_pool; /* all nodes of the tree have the same size */
 };
 
 /*
@@ -57,6 +59,12 @@ struct ravl *ravl_new_sized(ravl_compare *compare, size_t data_size) {
         return NULL;
     }
 
+    r->node_pool = umf_ba_create(sizeof(struct ravl_node) + data_size);
+    if (r->node_pool == NULL) {
+        umf_ba_global_free(r);
+        return NULL;
+    }
+
     r->compare = compare;
     r->root = NULL;
     r->data_size = data_size;
@@ -75,20 +83,20 @@ struct ravl *ravl_new(ravl_compare *compare) {
  * ravl_clear_node -- (internal) recursively clears the given subtree,
  *	calls callback in an in-order fashion. Optionally frees the given node.
  */
-static void ravl_foreach_node(struct ravl_node *n, ravl_cb cb, void *arg,
-                              int free_node) {
+static void ravl_foreach_node(struct ravl *ravl, struct ravl_node *n,
+                              ravl_cb cb, void *arg, int free_node) {
     if (n == NULL) {
         return;
     }
 
-    ravl_foreach_node(n->slots[RAVL_LEFT], cb, arg, free_node);
+    ravl_foreach_node(ravl, n->slots[RAVL_LEFT], cb, arg, free_node);
     if (cb) {
         cb((void *)n->data, arg);
     }
-    ravl_foreach_node(n->slots[RAVL_RIGHT], cb, arg, free_node);
+    ravl_foreach_node(ravl, n->slots[RAVL_RIGHT], cb, arg, free_node);
 
     if (free_node) {
-        umf_ba_global_free(n);
+        umf_ba_free(ravl->node_pool, n);
     }
 }
 
@@ -96,7 +104,7 @@ static void ravl_foreach_node(struct ravl_node *n, ravl_cb cb, void *arg,
  * ravl_clear -- clears the entire tree, starting from the root
  */
 void ravl_clear(struct ravl *ravl) {
-    ravl_foreach_node(ravl->root, NULL, NULL, 1);
+    ravl_foreach_node(ravl, ravl->root, NULL, NULL, 1);
     ravl->root = NULL;
 }
 
@@ -104,7 +112,8 @@ void ravl_clear(struct ravl *ravl) {
  * ravl_delete_cb -- clears and deletes the given ravl instance, calls callback
  */
 void ravl_delete_cb(struct ravl *ravl, ravl_cb cb, void *arg) {
-    ravl_foreach_node(ravl->root, cb, arg, 1);
+    ravl_foreach_node(ravl, ravl->root, cb, arg, 1);
+    umf_ba_destroy(ravl->node_pool);
     umf_ba_global_free(ravl);
 }
 
@@ -117,7 +126,7 @@ void ravl_delete(struct ravl *ravl) { ravl_delete_cb(ravl, NULL, NULL); }
  * ravl_foreach -- traverses the entire tree, calling callback for every node
  */
 void ravl_foreach(struct ravl *ravl, ravl_cb cb, void *arg) {
-    ravl_foreach_node(ravl->root, cb, arg, 0);
+    ravl_foreach_node(ravl, ravl->root, cb, arg, 0);
 }
 
 /*
@@ -150,7 +159,7 @@ static void ravl_node_copy_constructor(void *data, size_t data_size,
  */
 static struct ravl_node *ravl_new_node(struct ravl *ravl, ravl_constr constr,
                                        const void *arg) {
-    struct ravl_node *n = umf_ba_global_alloc(sizeof(*n) + ravl->data_size);
+    struct ravl_node *n = umf_ba_alloc(ravl->node_pool);
     if (n == NULL) {
         return NULL;
     }
@@ -384,7 +393,7 @@ int ravl_emplace(struct ravl *ravl, ravl_constr constr, const void *arg) {
 
 error_duplicate:
     errno = EEXIST;
-    umf_ba_global_free(n);
+    umf_ba_free(ravl->node_pool, n);
     return -1;
 }
 
@@ -517,7 +526,7 @@ void ravl_remove(struct ravl *ravl, struct ravl_node *n) {
         }
 
         *ravl_node_ref(ravl, n) = r;
-        umf_ba_global_free(n);
+        umf_ba_free(ravl->node_pool, n);
     }
 }
 
@@ -94,6 +94,9 @@ int utils_getpid(void);
 // get the current thread ID
 int utils_gettid(void);
 
+// get the time of a monotonic clock in milliseconds
+uint64_t utils_get_time_ms(void);
+
 // close file descriptor
 int utils_close_fd(int fd);
 
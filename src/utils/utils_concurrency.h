@@ -10,6 +10,7 @@
 #ifndef UMF_UTILS_CONCURRENCY_H
 #define UMF_UTILS_CONCURRENCY_H 1
 
+#include <stdbool.h>
 #include <stdio.h>
 
 #ifdef _WIN32
@@ -84,6 +85,26 @@ static __inline unsigned char utils_mssb_index(long long value) {
     InterlockedIncrement64((LONG64 volatile *)object)
 #define utils_fetch_and_add64(ptr, value)                                      \
     InterlockedExchangeAdd64((LONG64 *)(ptr), value)
+
+// Stores 'desired' in '*object' if it equals '*expected' and returns true.
+// Otherwise loads the current value of '*object' to '*expected'
+// and returns false.
+static __inline bool utils_compare_exchange_64(LONG64 volatile *object,
+                                               LONG64 *expected,
+                                               LONG64 desired) {
+    LONG64 old = InterlockedCompareExchange64(object, desired, *expected);
+    if (old == *expected) {
+        return true;
+    }
+    *expected = old;
+    return false;
+}
+#define utils_compare_exchange(object, expected, desired)                      \
+    utils_compare_exchange_64((LONG64 volatile *)(object),                    \
+                              (LONG64 *)(expected), (LONG64)(desired))
+
+// full (sequentially consistent) memory barrier
+#define utils_atomic_fence() MemoryBarrier()
 #else
 #define utils_lssb_index(x) ((unsigned char)__builtin_ctzll(x))
 #define utils_mssb_index(x) ((unsigned char)(63 - __builtin_clzll(x)))
@@ -102,6 +123,16 @@ static __inline unsigned char utils_mssb_index(long long value) {
 #define utils_atomic_increment(object)                                         \
     __atomic_add_fetch(object, 1, __ATOMIC_ACQ_REL)
 #define utils_fetch_and_add64 __sync_fetch_and_add
+
+// Stores 'desired' in '*object' if it equals '*expected' and returns true.
+// Otherwise loads the current value of '*object' to '*expected'
+// and returns false.
+#define utils_compare_exchange(object, expected, desired)                      \
+    __atomic_compare_exchange_n(object, expected, desired, false /* strong */, \
+                                __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+
+// full (sequentially consistent) memory barrier
+#define utils_atomic_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
 #endif
 
 #ifdef __cplusplus
@@ -12,6 +12,11 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#include "utils_windows_intrin.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -19,6 +24,22 @@ extern "C" {
 
 size_t getLeftmostSetBitPos(size_t num);
 
+// Retrieves the position of the rightmost set bit.
+// The position of the bit is counted from 0
+// e.g. for 01000011110 the position equals 1.
+// Defined inline, because it is used on allocation fast paths.
+static inline size_t getRightmostSetBitPos(uint64_t num) {
+    assert(num != 0 &&
+           "Finding rightmost set bit when number equals zero is undefined");
+#ifdef _WIN32
+    unsigned long index = 0;
+    _BitScanForward64(&index, (unsigned __int64)num);
+    return (size_t)index;
+#else
+    return (size_t)__builtin_ctzll(num);
+#endif
+}
+
 // Logarithm is an index of the most significant non-zero bit.
 static inline size_t log2Utils(size_t num) { return getLeftmostSetBitPos(num); }
 
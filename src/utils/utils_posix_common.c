@@ -16,6 +16,7 @@
 #include <sys/stat.h>
 #include <sys/syscall.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 
 #include "utils_common.h"
@@ -61,6 +62,12 @@ int utils_gettid(void) {
 #endif
 }
 
+uint64_t utils_get_time_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+}
+
 int utils_close_fd(int fd) { return close(fd); }
 
 #ifndef __APPLE__
@@ -40,6 +40,8 @@ int utils_getpid(void) { return GetCurrentProcessId(); }
 
 int utils_gettid(void) { return GetCurrentThreadId(); }
 
+uint64_t utils_get_time_ms(void) { return GetTickCount64(); }
+
 int utils_close_fd(int fd) {
     (void)fd; // unused
     return -1;
@@ -36,7 +36,8 @@ INSTANTIATE_TEST_SUITE_P(
     CoarseWithMemoryStrategyTest, CoarseWithMemoryStrategyTest,
     ::testing::Values(UMF_COARSE_MEMORY_STRATEGY_FASTEST,
                       UMF_COARSE_MEMORY_STRATEGY_FASTEST_BUT_ONE,
-                      UMF_COARSE_MEMORY_STRATEGY_CHECK_ALL_SIZE));
+                      UMF_COARSE_MEMORY_STRATEGY_CHECK_ALL_SIZE,
+                      UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT));
 
 TEST_P(CoarseWithMemoryStrategyTest, disjointCoarseMallocPool_basic) {
     umf_memory_provider_handle_t malloc_memory_provider;
@@ -11,6 +11,10 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
 #include "malloc_compliance_tests.hpp"
 #include "test_helpers.h"
 #include "umf/memory_pool.h"
@@ -25,6 +29,7 @@ using umf_test::test;
 //------------------------------------------------------------------------
 
 #define MAX_ALLOC_SIZE (1024 * 1024) // 1 MB
+#define MAX_ALIGNED_ALLOC_SIZE (64 * 1024) // 64 KB
 #define ITERATIONS 100
 #define SRAND_INIT_VALUE 0
 
@@ -34,6 +39,14 @@ using umf_test::test;
 
 static inline size_t rand_alloc_size(int max) { return rand() % max; }
 
+static inline size_t get_page_size(void) {
+#ifdef _WIN32
+    return 4096;
+#else
+    return (size_t)sysconf(_SC_PAGESIZE);
+#endif
+}
+
 static inline void free_memory(umf_memory_pool_handle_t hPool,
                                void *ptr[ITERATIONS]) {
     for (int i = 0; i < ITERATIONS; i++) {
@@ -147,3 +160,36 @@ void free_compliance_test(umf_memory_pool_handle_t hPool) {
     }
     ASSERT_EQ(errno, 0) << "Error was found by a free call with NULL parameter";
 }
+
+// ISO/IEC 9899:2011 7.22.3.1
+void aligned_malloc_compliance_test(umf_memory_pool_handle_t hPool) {
+    srand(SRAND_INIT_VALUE);
+    void *alloc_ptr[ITERATIONS];
+    size_t alloc_ptr_size[ITERATIONS];
+
+    // Every power of 2 alignment up to the page size shall be supported
+    for (size_t alignment = 1; alignment <= get_page_size(); alignment <<= 1) {
+        for (int i = 0; i < ITERATIONS; i++) {
+            // Mix allocations smaller than the alignment with larger ones
+            alloc_ptr_size[i] = 1 + rand_alloc_size(
+                                        i % 2 ? MAX_ALIGNED_ALLOC_SIZE
+                                              : (int)alignment * 2);
+            alloc_ptr[i] =
+                umfPoolAlignedMalloc(hPool, alloc_ptr_size[i], alignment);
+            ASSERT_NE(alloc_ptr[i], nullptr)
+                << "aligned malloc returned NULL for alignment " << alignment;
+            ASSERT_NE(addressIsAligned(alloc_ptr[i], alignment), 0)
+                << "Aligned malloc should return pointer aligned to "
+                << alignment;
+            memset(alloc_ptr[i], i % 0xFF, alloc_ptr_size[i]);
+        }
+        for (int i = 0; i < ITERATIONS; i++) {
+            ASSERT_NE(bufferIsFilledWithChar(alloc_ptr[i], alloc_ptr_size[i],
+                                             i % 0xFF),
+                      0)
+                << "Object returned by aligned malloc is not disjoined from "
+                   "others";
+        }
+        free_memory(hPool, alloc_ptr);
+    }
+}
@@ -11,5 +11,6 @@ void malloc_compliance_test(umf_memory_pool_handle_t hPool);
 void calloc_compliance_test(umf_memory_pool_handle_t hPool);
 void realloc_compliance_test(umf_memory_pool_handle_t hPool);
 void free_compliance_test(umf_memory_pool_handle_t hPool);
+void aligned_malloc_compliance_test(umf_memory_pool_handle_t hPool);
 
 #endif /* UMF_TEST_MALLOC_COMPLIANCE_TESTS_H */
@@ -24,6 +24,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <variant>
+#include <vector>
 
 using umf_test::test;
 using namespace umf_test;
@@ -178,6 +179,287 @@ TEST_F(test, BasicPoolByPtrTest) {
     ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
 }
 
+TEST_F(test, PoolByPtrAfterFreeTest) {
+    constexpr size_t SIZE = 4096 * 1024;
+
+    umf_memory_provider_handle_t provider;
+    umf_result_t ret =
+        umfMemoryProviderCreate(&BA_GLOBAL_PROVIDER_OPS, NULL, &provider);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    auto pool =
+        wrapPoolUnique(createPoolChecked(umfProxyPoolOps(), provider, nullptr,
+                                         UMF_POOL_CREATE_FLAG_OWN_PROVIDER));
+    auto expected_pool = pool.get();
+    char *ptr1 = (char *)umfPoolMalloc(expected_pool, SIZE);
+    ASSERT_NE(ptr1, nullptr);
+    char *ptr2 = (char *)umfPoolMalloc(expected_pool, SIZE);
+    ASSERT_NE(ptr2, nullptr);
+
+    // repeated lookups of the same regions
+    for (int i = 0; i < 3; i++) {
+        EXPECT_EQ(umfPoolByPtr(ptr1), expected_pool);
+        EXPECT_EQ(umfPoolByPtr(ptr2 + SIZE / 2), expected_pool);
+    }
+
+    // a region found before is not returned after it was freed
+    ret = umfFree(ptr1);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    EXPECT_EQ(umfPoolByPtr(ptr1), nullptr);
+    EXPECT_EQ(umfPoolByPtr(ptr2), expected_pool);
+
+    ret = umfFree(ptr2);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    EXPECT_EQ(umfPoolByPtr(ptr2 + SIZE / 2), nullptr);
+}
+
+TEST_F(test, PoolByPtrAfterPartialFreeTest) {
+    static constexpr size_t CHUNK = 4096;
+    static char buffer[4 * CHUNK];
+    static umf_memory_provider_handle_t trackingProvider = nullptr;
+
+    // the buffer can be freed in parts
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            *ptr = (size <= sizeof(buffer)) ? buffer : nullptr;
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *, size_t) noexcept {
+            return UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    // the pool gets the tracking provider of the pool
+    struct memory_pool : public umf_test::pool_base_t {
+        umf_result_t
+        initialize(umf_memory_provider_handle_t provider) noexcept {
+            trackingProvider = provider;
+            return UMF_RESULT_SUCCESS;
+        }
+        void *malloc(size_t size) noexcept {
+            void *ptr = nullptr;
+            umfMemoryProviderAlloc(trackingProvider, size, 0, &ptr);
+            return ptr;
+        }
+    };
+    umf_memory_pool_ops_t pool_ops =
+        umf::poolMakeCOps<memory_pool, void>();
+
+    auto provider =
+        wrapProviderUnique(createProviderChecked(&provider_ops, nullptr));
+    auto pool =
+        wrapPoolUnique(createPoolChecked(&pool_ops, provider.get(), nullptr));
+    auto expected_pool = pool.get();
+
+    char *ptr = (char *)umfPoolMalloc(expected_pool, 4 * CHUNK);
+    ASSERT_EQ(ptr, buffer);
+
+    // free the tail of the allocation
+    umf_result_t ret =
+        umfMemoryProviderFree(trackingProvider, ptr + 3 * CHUNK, CHUNK);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    EXPECT_EQ(umfPoolByPtr(ptr + 3 * CHUNK), nullptr);
+    EXPECT_EQ(umfPoolByPtr(ptr + 3 * CHUNK - 1), expected_pool);
+
+    // free the middle of the allocation
+    ret = umfMemoryProviderFree(trackingProvider, ptr + CHUNK, CHUNK);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    EXPECT_EQ(umfPoolByPtr(ptr), expected_pool);
+    EXPECT_EQ(umfPoolByPtr(ptr + CHUNK), nullptr);
+    EXPECT_EQ(umfPoolByPtr(ptr + 2 * CHUNK), expected_pool);
+
+    // free both remaining parts at once
+    ret = umfMemoryProviderFree(trackingProvider, ptr, 3 * CHUNK);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    EXPECT_EQ(umfPoolByPtr(ptr), nullptr);
+    EXPECT_EQ(umfPoolByPtr(ptr + 2 * CHUNK), nullptr);
+}
+
+TEST_F(test, PoolByPtrAfterFailedRangeFreeTest) {
+    static constexpr size_t CHUNK = 4096;
+    static char buffer[3 * CHUNK];
+    static size_t used = 0;
+    static umf_memory_provider_handle_t trackingProviders[2];
+    static size_t numPools = 0;
+
+    // every allocation gets the next chunk of the buffer
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            if (size != CHUNK || used == sizeof(buffer)) {
+                *ptr = nullptr;
+                return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+            }
+            *ptr = buffer + used;
+            used += CHUNK;
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *, size_t) noexcept {
+            return UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    // the pool gets the tracking provider of the pool
+    struct memory_pool : public umf_test::pool_base_t {
+        umf_memory_provider_handle_t trackingProvider = nullptr;
+        umf_result_t
+        initialize(umf_memory_provider_handle_t provider) noexcept {
+            trackingProvider = provider;
+            trackingProviders[numPools++] = provider;
+            return UMF_RESULT_SUCCESS;
+        }
+        void *malloc(size_t size) noexcept {
+            void *ptr = nullptr;
+            umfMemoryProviderAlloc(trackingProvider, size, 0, &ptr);
+            return ptr;
+        }
+    };
+    umf_memory_pool_ops_t pool_ops =
+        umf::poolMakeCOps<memory_pool, void>();
+
+    auto provider =
+        wrapProviderUnique(createProviderChecked(&provider_ops, nullptr));
+    auto pool1 =
+        wrapPoolUnique(createPoolChecked(&pool_ops, provider.get(), nullptr));
+    auto pool2 =
+        wrapPoolUnique(createPoolChecked(&pool_ops, provider.get(), nullptr));
+    ASSERT_EQ(numPools, 2U);
+
+    // the chunk in the middle belongs to the other pool
+    char *ptr1 = (char *)umfPoolMalloc(pool1.get(), CHUNK);
+    ASSERT_EQ(ptr1, buffer);
+    char *ptr2 = (char *)umfPoolMalloc(pool2.get(), CHUNK);
+    ASSERT_EQ(ptr2, buffer + CHUNK);
+    char *ptr3 = (char *)umfPoolMalloc(pool1.get(), CHUNK);
+    ASSERT_EQ(ptr3, buffer + 2 * CHUNK);
+
+    // a range overlapping a region of another pool is not removed at all,
+    // not even in part
+    umfMemoryProviderFree(trackingProviders[0], ptr1 + CHUNK / 2, 2 * CHUNK);
+    EXPECT_EQ(umfPoolByPtr(ptr1 + CHUNK - 1), pool1.get());
+    EXPECT_EQ(umfPoolByPtr(ptr2), pool2.get());
+    EXPECT_EQ(umfPoolByPtr(ptr3 + CHUNK - 1), pool1.get());
+
+    umf_result_t ret = umfMemoryProviderFree(trackingProviders[0], ptr1, CHUNK);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    ret = umfMemoryProviderFree(trackingProviders[1], ptr2, CHUNK);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    ret = umfMemoryProviderFree(trackingProviders[0], ptr3, CHUNK);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    EXPECT_EQ(umfPoolByPtr(ptr1), nullptr);
+    EXPECT_EQ(umfPoolByPtr(ptr2), nullptr);
+    EXPECT_EQ(umfPoolByPtr(ptr3), nullptr);
+}
+
+TEST_F(test, PoolByPtrAfterPoolDestroyTest) {
+    static constexpr size_t CHUNK = 4096;
+    static constexpr size_t N_CHUNKS = 8;
+    static char buffer[2 * N_CHUNKS * CHUNK];
+    static size_t used = 0;
+
+    // the memory is not freed, so the pool can be destroyed with leftovers
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            if (size > CHUNK || used == sizeof(buffer)) {
+                *ptr = nullptr;
+                return UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY;
+            }
+            *ptr = buffer + used;
+            used += CHUNK;
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *, size_t) noexcept {
+            return UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    auto provider =
+        wrapProviderUnique(createProviderChecked(&provider_ops, nullptr));
+    auto pool1 = wrapPoolUnique(
+        createPoolChecked(umfProxyPoolOps(), provider.get(), nullptr));
+    auto pool2 = wrapPoolUnique(
+        createPoolChecked(umfProxyPoolOps(), provider.get(), nullptr));
+
+    // interleave the regions of both pools
+    std::vector<char *> ptrs1, ptrs2;
+    for (size_t i = 0; i < N_CHUNKS; i++) {
+        ptrs1.push_back((char *)umfPoolMalloc(pool1.get(), CHUNK));
+        ASSERT_NE(ptrs1.back(), nullptr);
+        ptrs2.push_back((char *)umfPoolMalloc(pool2.get(), CHUNK));
+        ASSERT_NE(ptrs2.back(), nullptr);
+    }
+
+    // free some of the regions of the first pool and leave the rest
+    for (size_t i = 0; i < N_CHUNKS; i += 2) {
+        ASSERT_EQ(umfPoolFree(pool1.get(), ptrs1[i]), UMF_RESULT_SUCCESS);
+    }
+
+    // destroying the first pool removes only its own regions
+    pool1.reset();
+    for (size_t i = 0; i < N_CHUNKS; i++) {
+        EXPECT_EQ(umfPoolByPtr(ptrs1[i]), nullptr);
+        EXPECT_EQ(umfPoolByPtr(ptrs2[i] + CHUNK - 1), pool2.get());
+    }
+
+    for (size_t i = 0; i < N_CHUNKS; i++) {
+        ASSERT_EQ(umfPoolFree(pool2.get(), ptrs2[i]), UMF_RESULT_SUCCESS);
+        EXPECT_EQ(umfPoolByPtr(ptrs2[i]), nullptr);
+    }
+}
+
+TEST_F(test, PoolByPtrMtChurnTest) {
+    static constexpr size_t SIZE = 64;
+    static constexpr size_t N_THREADS = 4;
+    static constexpr size_t N_ITERATIONS = 1000;
+    static constexpr size_t N_BATCH = 8;
+
+    auto provider = wrapProviderUnique(
+        createProviderChecked(&BA_GLOBAL_PROVIDER_OPS, nullptr));
+    auto pool = wrapPoolUnique(
+        createPoolChecked(umfProxyPoolOps(), provider.get(), nullptr));
+
+    // the regions allocated before the churn stay in the tracker,
+    // while many of the other ones are removed around them
+    std::vector<void *> kept(N_THREADS);
+    for (auto &ptr : kept) {
+        ptr = umfPoolMalloc(pool.get(), SIZE);
+        ASSERT_NE(ptr, nullptr);
+    }
+
+    std::vector<size_t> numErrors(N_THREADS);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < N_THREADS; t++) {
+        threads.emplace_back([&, t, hPool = pool.get()] {
+            void *ptrs[N_BATCH];
+            for (size_t i = 0; i < N_ITERATIONS; i++) {
+                for (auto &ptr : ptrs) {
+                    ptr = umfPoolMalloc(hPool, SIZE);
+                    if (umfPoolByPtr(ptr) != hPool) {
+                        numErrors[t]++;
+                    }
+                }
+                for (auto ptr : ptrs) {
+                    umfPoolFree(hPool, ptr);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (size_t t = 0; t < N_THREADS; t++) {
+        EXPECT_EQ(numErrors[t], 0U);
+        EXPECT_EQ(umfPoolByPtr(kept[t]), pool.get());
+        ASSERT_EQ(umfPoolFree(pool.get(), kept[t]), UMF_RESULT_SUCCESS);
+        EXPECT_EQ(umfPoolByPtr(kept[t]), nullptr);
+    }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     mallocPoolTest, umfPoolTest,
     ::testing::Values(poolCreateExtParams{&MALLOC_POOL_OPS, nullptr,
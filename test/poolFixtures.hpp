@@ -451,4 +451,12 @@ TEST_P(umfPoolTest, realloc_compliance) {
 
 TEST_P(umfPoolTest, free_compliance) { free_compliance_test(pool.get()); }
 
+TEST_P(umfPoolTest, aligned_malloc_compliance) {
+    if (!umf_test::isAlignedAllocSupported(pool.get())) {
+        GTEST_SKIP();
+    }
+
+    aligned_malloc_compliance_test(pool.get());
+}
+
 #endif /* UMF_TEST_POOL_FIXTURES_HPP */
@@ -2,6 +2,8 @@
 // Under the Apache License v2.0 with LLVM Exceptions. See LICENSE.TXT.
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#include "decay_clock.h"
+#include "multithread_helpers.hpp"
 #include "pool.hpp"
 #include "poolFixtures.hpp"
 #include "pool_disjoint.h"
@@ -9,6 +11,9 @@
 #include "provider_null.h"
 #include "provider_trace.h"
 
+#include <umf/pools/pool_proxy.h>
+#include <umf/providers/provider_os_memory.h>
+
 umf_disjoint_pool_params_t poolConfig() {
     umf_disjoint_pool_params_t config{};
     config.SlabMinSize = 4096;
@@ -144,12 +149,1387 @@ TEST_F(test, sharedLimits) {
     EXPECT_EQ(MaxSize / SlabMinSize * 2, numFrees);
 }
 
-auto defaultPoolConfig = poolConfig();
-INSTANTIATE_TEST_SUITE_P(disjointPoolTests, umfPoolTest,
-                         ::testing::Values(poolCreateExtParams{
-                             umfDisjointPoolOps(), (void *)&defaultPoolConfig,
-                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr}));
+TEST_F(test, threadCacheFlushOnThreadExit) {
+    static size_t numAllocs = 0;
+    static size_t numFrees = 0;
+
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            *ptr = malloc(size);
+            numAllocs++;
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *ptr, [[maybe_unused]] size_t size) noexcept {
+            ::free(ptr);
+            numFrees++;
+            return UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    // no slab can be kept in the pool, so a slab goes back to the provider
+    // as soon as all of its chunks are returned to the bucket
+    auto limits =
+        std::unique_ptr<umf_disjoint_pool_shared_limits_t,
+                        decltype(&umfDisjointPoolSharedLimitsDestroy)>(
+            umfDisjointPoolSharedLimitsCreate(0),
+            &umfDisjointPoolSharedLimitsDestroy);
+
+    auto config = poolConfig();
+    config.SharedLimits = limits.get();
+    config.ThreadCacheCapacity = 16;
+
+    auto provider =
+        wrapProviderUnique(createProviderChecked(&provider_ops, nullptr));
+
+    umf_memory_pool_handle_t pool = NULL;
+    auto ret = umfPoolCreate(umfDisjointPoolOps(), provider.get(),
+                             (void *)&config, 0, &pool);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    auto poolHandle = umf_test::wrapPoolUnique(pool);
+
+    std::thread worker([pool] {
+        std::vector<void *> ptrs;
+        for (size_t i = 0; i < 8; i++) {
+            ptrs.push_back(umfPoolMalloc(pool, 64));
+            ASSERT_NE(ptrs.back(), nullptr);
+        }
+        for (auto ptr : ptrs) {
+            ASSERT_EQ(umfPoolFree(pool, ptr), UMF_RESULT_SUCCESS);
+        }
+
+        // freed chunks are held in the thread cache
+        EXPECT_EQ(numFrees, 0);
+    });
+    worker.join();
+
+    // thread exit returned the cached chunks and the empty slab was freed
+    EXPECT_EQ(numAllocs, 1);
+    EXPECT_EQ(numFrees, 1);
+}
+
+TEST_F(test, threadCachePoolDestroyedFirst) {
+    auto config = poolConfig();
+    config.ThreadCacheCapacity = 16;
+
+    for (int i = 0; i < 3; i++) {
+        auto pool = poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                                         &BA_GLOBAL_PROVIDER_OPS, nullptr,
+                                         nullptr});
+
+        // leave chunks in the cache of this thread and destroy the pool
+        // while the thread is still alive
+        void *ptr = umfPoolMalloc(pool.get(), 64);
+        ASSERT_NE(ptr, nullptr);
+        ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    }
+}
+
+TEST_F(test, slabChunksFillAndReuse) {
+    static size_t numAllocs = 0;
+
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            *ptr = malloc(size);
+            numAllocs++;
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *ptr, [[maybe_unused]] size_t size) noexcept {
+            ::free(ptr);
+            return UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    // 8-byte chunks of a 64 KiB slab span 128 bitmap words
+    static constexpr size_t SlabMinSize = 64 * 1024;
+    static constexpr size_t ChunkSize = 8;
+    static constexpr size_t NumChunks = SlabMinSize / ChunkSize;
+
+    auto config = poolConfig();
+    config.SlabMinSize = SlabMinSize;
+    config.MinBucketSize = ChunkSize;
+
+    auto provider =
+        wrapProviderUnique(createProviderChecked(&provider_ops, nullptr));
+
+    umf_memory_pool_handle_t pool = NULL;
+    auto ret = umfPoolCreate(umfDisjointPoolOps(), provider.get(),
+                             (void *)&config, 0, &pool);
+    ASSERT_EQ(ret, UMF_RESULT_SUCCESS);
+    auto poolHandle = umf_test::wrapPoolUnique(pool);
+
+    std::vector<void *> ptrs;
+    for (size_t i = 0; i < NumChunks; i++) {
+        ptrs.push_back(umfPoolMalloc(pool, ChunkSize));
+        ASSERT_NE(ptrs.back(), nullptr);
+    }
+    EXPECT_EQ(numAllocs, 1);
+
+    // chunks are handed out in address order
+    std::vector<void *> sorted(ptrs);
+    std::sort(sorted.begin(), sorted.end());
+    EXPECT_EQ(sorted, ptrs);
+
+    // free every third chunk and check that exactly those are reused
+    std::vector<void *> freed;
+    for (size_t i = 0; i < NumChunks; i += 3) {
+        ASSERT_EQ(umfPoolFree(pool, ptrs[i]), UMF_RESULT_SUCCESS);
+        freed.push_back(ptrs[i]);
+    }
+    for (auto expected : freed) {
+        EXPECT_EQ(umfPoolMalloc(pool, ChunkSize), expected);
+    }
+    EXPECT_EQ(numAllocs, 1);
+
+    // the slab is full again, so the next chunk comes from a new slab
+    void *extra = umfPoolMalloc(pool, ChunkSize);
+    ASSERT_NE(extra, nullptr);
+    EXPECT_EQ(numAllocs, 2);
+
+    ASSERT_EQ(umfPoolFree(pool, extra), UMF_RESULT_SUCCESS);
+    for (auto ptr : ptrs) {
+        ASSERT_EQ(umfPoolFree(pool, ptr), UMF_RESULT_SUCCESS);
+    }
+}
+
+TEST_F(test, crossThreadFreeWithSlabChurn) {
+    static constexpr size_t numThreads = 4;
+    static constexpr size_t numRounds = 50;
+    static constexpr size_t allocSizes[] = {8, 64, 200, 1024, 4096, 8192};
+
+    // no slab can be kept in the pool, so slabs are created and destroyed
+    // all the time while other threads look them up on free
+    auto limits =
+        std::unique_ptr<umf_disjoint_pool_shared_limits_t,
+                        decltype(&umfDisjointPoolSharedLimitsDestroy)>(
+            umfDisjointPoolSharedLimitsCreate(0),
+            &umfDisjointPoolSharedLimitsDestroy);
+
+    auto config = poolConfig();
+    config.SharedLimits = limits.get();
+
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    std::vector<std::vector<void *>> allocs(numThreads);
+    umf_test::syncthreads_barrier syncthreads(numThreads);
+
+    umf_test::parallel_exec(numThreads, [&](size_t id) {
+        for (size_t round = 0; round < numRounds; round++) {
+            for (size_t i = 0; i < 64; i++) {
+                size_t size = allocSizes[(i + id) % std::size(allocSizes)];
+                void *ptr = umfPoolMalloc(pool.get(), size);
+                ASSERT_NE(ptr, nullptr);
+                std::memset(ptr, (int)id, size);
+                allocs[id].push_back(ptr);
+            }
+
+            syncthreads();
+
+            // free the allocations of the neighbouring thread
+            auto &victim = allocs[(id + 1) % numThreads];
+            for (auto ptr : victim) {
+                ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+            }
+            victim.clear();
+
+            syncthreads();
+        }
+    });
+}
+
+TEST_F(test, reallocWithinChunk) {
+    auto config = poolConfig();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    // 100 bytes are served from the 128-byte bucket
+    char *ptr = (char *)umfPoolMalloc(pool.get(), 100);
+    ASSERT_NE(ptr, nullptr);
+    std::memset(ptr, 0xAB, 100);
+
+    EXPECT_EQ(umfPoolRealloc(pool.get(), ptr, 128), ptr);
+    EXPECT_EQ(umfPoolRealloc(pool.get(), ptr, 100), ptr);
+
+    // growing past the chunk moves the data
+    char *newPtr = (char *)umfPoolRealloc(pool.get(), ptr, 1000);
+    ASSERT_NE(newPtr, nullptr);
+    EXPECT_NE(newPtr, ptr);
+    for (size_t i = 0; i < 100; i++) {
+        ASSERT_EQ(newPtr[i], (char)0xAB);
+    }
+
+    EXPECT_EQ(umfPoolRealloc(pool.get(), newPtr, 0), nullptr);
+}
+
+TEST_F(test, reallocShrinks) {
+    auto config = poolConfig();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    // shrinking into a smaller bucket moves the data out of the chunk
+    char *ptr = (char *)umfPoolMalloc(pool.get(), config.MaxPoolableSize);
+    ASSERT_NE(ptr, nullptr);
+    std::memset(ptr, 0xAB, config.MaxPoolableSize);
+
+    char *newPtr = (char *)umfPoolRealloc(pool.get(), ptr, 16);
+    ASSERT_NE(newPtr, nullptr);
+    EXPECT_NE(newPtr, ptr);
+    EXPECT_LT(umfPoolMallocUsableSize(pool.get(), newPtr),
+              config.MaxPoolableSize);
+    for (size_t i = 0; i < 16; i++) {
+        ASSERT_EQ(newPtr[i], (char)0xAB);
+    }
+    ASSERT_EQ(umfPoolFree(pool.get(), newPtr), UMF_RESULT_SUCCESS);
+
+    // a large allocation stays in place while at most half of it is unused
+    size_t size = 8 * config.MaxPoolableSize;
+    ptr = (char *)umfPoolMalloc(pool.get(), size);
+    ASSERT_NE(ptr, nullptr);
+    std::memset(ptr, 0xCD, size);
+
+    EXPECT_EQ(umfPoolRealloc(pool.get(), ptr, size / 2 + 1), ptr);
+
+    newPtr = (char *)umfPoolRealloc(pool.get(), ptr, 16);
+    ASSERT_NE(newPtr, nullptr);
+    EXPECT_NE(newPtr, ptr);
+    EXPECT_LE(umfPoolMallocUsableSize(pool.get(), newPtr),
+              config.MaxPoolableSize);
+    for (size_t i = 0; i < 16; i++) {
+        ASSERT_EQ(newPtr[i], (char)0xCD);
+    }
+    ASSERT_EQ(umfPoolFree(pool.get(), newPtr), UMF_RESULT_SUCCESS);
+}
+
+TEST_F(test, reallocLargeBacksOffGrowInPlace) {
+    static size_t numAllocs = 0;
+
+    // malloc() does not return the memory right after a live allocation,
+    // so growing in place always fails
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            numAllocs++;
+            *ptr = ::malloc(size);
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *ptr, [[maybe_unused]] size_t size) noexcept {
+            ::free(ptr);
+            return UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    auto config = poolConfig();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &provider_ops, nullptr, nullptr});
+
+    static constexpr size_t numReallocs = 256;
+    size_t size = 2 * config.MaxPoolableSize;
+    char *ptr = (char *)umfPoolMalloc(pool.get(), size);
+    ASSERT_NE(ptr, nullptr);
+    std::memset(ptr, 0xAB, size);
+
+    numAllocs = 0;
+    for (size_t i = 0; i < numReallocs; i++) {
+        char *newPtr = (char *)umfPoolRealloc(pool.get(), ptr, size + 4096);
+        ASSERT_NE(newPtr, nullptr);
+        ASSERT_EQ(newPtr[size - 1], (char)0xAB);
+        ptr = newPtr;
+        std::memset(ptr + size, 0xAB, 4096);
+        size += 4096;
+    }
+
+    // every realloc moves the allocation, but only a few of them first try
+    // (and fail) to grow it in place
+    EXPECT_GE(numAllocs, numReallocs);
+    EXPECT_LT(numAllocs, numReallocs + 16);
+
+    EXPECT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+}
+
+TEST_F(test, reallocSurvivesFreeError) {
+    static umf_result_t freeResult = UMF_RESULT_SUCCESS;
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            *ptr = ::malloc(size);
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *ptr, [[maybe_unused]] size_t size) noexcept {
+            ::free(ptr);
+            return freeResult;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    auto config = poolConfig();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &provider_ops, nullptr, nullptr});
+
+    size_t size = 2 * config.MaxPoolableSize;
+    char *ptr = (char *)umfPoolMalloc(pool.get(), size);
+    ASSERT_NE(ptr, nullptr);
+    std::memset(ptr, 0xAB, size);
+
+    // the data is already copied when freeing the old block fails,
+    // so the realloc still succeeds
+    freeResult = UMF_RESULT_ERROR_MEMORY_PROVIDER_SPECIFIC;
+    char *newPtr = (char *)umfPoolRealloc(pool.get(), ptr, 2 * size);
+    freeResult = UMF_RESULT_SUCCESS;
+    ASSERT_NE(newPtr, nullptr);
+    for (size_t i = 0; i < size; i++) {
+        ASSERT_EQ(newPtr[i], (char)0xAB);
+    }
+
+    EXPECT_EQ(umfPoolFree(pool.get(), newPtr), UMF_RESULT_SUCCESS);
+}
+
+TEST_F(test, mallocUsableSize) {
+    auto config = poolConfig();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    EXPECT_EQ(umfPoolMallocUsableSize(pool.get(), nullptr), 0);
+
+    // sizes are rounded up to the 64, 96, 128, 192, ... buckets;
+    // 3000 bytes take a whole 4096-byte slab
+    static constexpr std::pair<size_t, size_t> sizes[] = {
+        {1, 64}, {65, 96}, {100, 128}, {129, 192}, {1500, 1536}, {3000, 4096}};
+
+    for (auto [size, usable] : sizes) {
+        void *ptr = umfPoolMalloc(pool.get(), size);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(umfPoolMallocUsableSize(pool.get(), ptr), usable);
+        std::memset(ptr, 0, usable);
+        ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    }
+
+    // allocations above MaxPoolableSize come straight from the provider
+    void *ptr = umfPoolMalloc(pool.get(), 3 * config.MaxPoolableSize);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_GE(umfPoolMallocUsableSize(pool.get(), ptr),
+              3 * config.MaxPoolableSize);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+}
+
+TEST_F(test, callocReusedChunkWithZeroingProvider) {
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            *ptr = ::calloc(1, size);
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *ptr, [[maybe_unused]] size_t size) noexcept {
+            ::free(ptr);
+            return UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    static constexpr size_t size = 64;
+
+    auto config = poolConfig();
+    config.ProviderZeroesMemory = 1;
+
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &provider_ops, nullptr, nullptr});
+
+    // fresh chunks come straight from the zero-filled slab
+    std::vector<char *> ptrs;
+    for (size_t i = 0; i < 8; i++) {
+        char *ptr = (char *)umfPoolCalloc(pool.get(), 1, size);
+        ASSERT_NE(ptr, nullptr);
+        for (size_t j = 0; j < size; j++) {
+            ASSERT_EQ(ptr[j], 0);
+        }
+        std::memset(ptr, 0xFF, size);
+        ptrs.push_back(ptr);
+    }
+
+    // reused chunks are dirty and have to be cleared
+    for (auto ptr : ptrs) {
+        ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    }
+    for (size_t i = 0; i < ptrs.size(); i++) {
+        char *ptr = (char *)umfPoolCalloc(pool.get(), 1, size);
+        ASSERT_NE(ptr, nullptr);
+        for (size_t j = 0; j < size; j++) {
+            ASSERT_EQ(ptr[j], 0);
+        }
+        ptrs[i] = ptr;
+    }
+
+    for (auto ptr : ptrs) {
+        ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    }
+}
+
+static void
+expectUsableSizes(umf_disjoint_pool_params_t &config,
+                  const std::vector<std::pair<size_t, size_t>> &sizes) {
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    for (auto [size, usable] : sizes) {
+        void *ptr = umfPoolMalloc(pool.get(), size);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ(umfPoolMallocUsableSize(pool.get(), ptr), usable)
+            << "size: " << size;
+        ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    }
+}
+
+TEST_F(test, sizeClassesPerDoubling) {
+    auto config = poolConfig();
+
+    config.SizeClassesPerDoubling = 4;
+    expectUsableSizes(config,
+                      {{1, 64}, {65, 80}, {100, 112}, {130, 160}, {170, 192}});
+
+    config.SizeClassesPerDoubling = 8;
+    expectUsableSizes(config, {{1, 64}, {65, 72}, {130, 144}, {150, 160},
+                               {170, 176}, {1000, 1024}, {1025, 1152}});
+}
+
+TEST_F(test, explicitBucketSizes) {
+    static const size_t bucketSizes[] = {136, 152, 168, 184};
+
+    auto config = poolConfig();
+    config.BucketSizes = bucketSizes;
+    config.NumBucketSizes = std::size(bucketSizes);
+
+    // sizes above the last explicit bucket use the default buckets
+    expectUsableSizes(config, {{1, 136},
+                               {130, 136},
+                               {137, 152},
+                               {150, 152},
+                               {180, 184},
+                               {185, 192},
+                               {200, 256},
+                               {1500, 1536}});
+}
+
+TEST_F(test, invalidSizeClasses) {
+    static const size_t unsortedSizes[] = {128, 64};
+
+    auto config = poolConfig();
+    config.SizeClassesPerDoubling = 3;
+
+    umf_memory_pool_handle_t pool = NULL;
+    auto provider = wrapProviderUnique(
+        createProviderChecked(&BA_GLOBAL_PROVIDER_OPS, nullptr));
+    auto ret = umfPoolCreate(umfDisjointPoolOps(), provider.get(),
+                             (void *)&config, 0, &pool);
+    EXPECT_EQ(ret, UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    config.SizeClassesPerDoubling = 0;
+    config.BucketSizes = unsortedSizes;
+    config.NumBucketSizes = std::size(unsortedSizes);
+    ret = umfPoolCreate(umfDisjointPoolOps(), provider.get(), (void *)&config,
+                        0, &pool);
+    EXPECT_EQ(ret, UMF_RESULT_ERROR_INVALID_ARGUMENT);
+}
+
+// Provider that tracks purges and the free of the first allocated block
+struct decay_memory_provider : public umf_test::provider_base_t {
+    static inline void *firstPtr = nullptr;
+    static inline bool firstAllocated = false;
+    static inline std::atomic<size_t> lazyPurges = 0;
+    static inline std::atomic<size_t> forcePurges = 0;
+    static inline std::atomic<size_t> firstFreed = 0;
+
+    static void reset() {
+        firstPtr = nullptr;
+        firstAllocated = false;
+        lazyPurges = forcePurges = firstFreed = 0;
+    }
+
+    umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+        *ptr = malloc(size);
+        if (!firstAllocated) {
+            firstPtr = *ptr;
+            firstAllocated = true;
+        }
+        return UMF_RESULT_SUCCESS;
+    }
+    umf_result_t free(void *ptr, [[maybe_unused]] size_t size) noexcept {
+        if (ptr == firstPtr) {
+            // the address may be reused by later allocations
+            firstFreed++;
+            firstPtr = nullptr;
+        }
+        ::free(ptr);
+        return UMF_RESULT_SUCCESS;
+    }
+    umf_result_t purge_lazy(void *ptr, [[maybe_unused]] size_t size) noexcept {
+        if (ptr == firstPtr) {
+            lazyPurges++;
+        }
+        return UMF_RESULT_SUCCESS;
+    }
+    umf_result_t purge_force(void *ptr,
+                             [[maybe_unused]] size_t size) noexcept {
+        if (ptr == firstPtr) {
+            forcePurges++;
+        }
+        return UMF_RESULT_SUCCESS;
+    }
+};
+
+// Sets the time of the decay clock by hand while alive
+struct manual_decay_clock {
+    int64_t nowMs = 1000;
+
+    manual_decay_clock() { umf_decay_clock_set_ms(nowMs); }
+    ~manual_decay_clock() { umf_decay_clock_set_ms(-1); }
+
+    void advance(std::chrono::milliseconds time) {
+        nowMs += time.count();
+        umf_decay_clock_set_ms(nowMs);
+    }
+};
 
+TEST_F(test, decayPooledSlabsOnAllocations) {
+    using namespace std::chrono_literals;
+    static constexpr auto decay = 100ms;
+
+    manual_decay_clock clock;
+    decay_memory_provider::reset();
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<decay_memory_provider, void>();
+
+    auto config = poolConfig();
+    config.DecayMs = decay.count();
+
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &provider_ops, nullptr, nullptr});
+
+    // allocations above MaxPoolableSize do not touch the pooled slab,
+    // but still drive the aging
+    auto tick = [&] {
+        for (size_t i = 0; i < 256; i++) {
+            void *ptr = umfPoolMalloc(pool.get(), 2 * config.MaxPoolableSize);
+            ASSERT_NE(ptr, nullptr);
+            ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+        }
+    };
+
+    // the whole slab allocation is kept in the pool after free
+    void *ptr = umfPoolMalloc(pool.get(), config.SlabMinSize);
+    ASSERT_EQ(ptr, decay_memory_provider::firstPtr);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+
+    tick();
+    EXPECT_EQ(decay_memory_provider::lazyPurges, 0);
+
+    clock.advance(decay * 3 / 2);
+    tick();
+    EXPECT_EQ(decay_memory_provider::lazyPurges, 1);
+    EXPECT_EQ(decay_memory_provider::forcePurges, 0);
+
+    clock.advance(decay);
+    tick();
+    EXPECT_EQ(decay_memory_provider::lazyPurges, 1);
+    EXPECT_EQ(decay_memory_provider::forcePurges, 1);
+    EXPECT_EQ(decay_memory_provider::firstFreed, 0);
+
+    clock.advance(decay);
+    tick();
+    EXPECT_EQ(decay_memory_provider::firstFreed, 1);
+}
+
+TEST_F(test, callocAfterForcedPurgeOfPooledSlab) {
+    using namespace std::chrono_literals;
+    static constexpr auto decay = 100ms;
+    static constexpr size_t size = 64;
+
+    static std::atomic<size_t> forcePurges;
+    forcePurges = 0;
+
+    // purging releases the pages, but the old contents may come back
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            *ptr = ::calloc(1, size);
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *ptr, [[maybe_unused]] size_t size) noexcept {
+            ::free(ptr);
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t purge_lazy(void *, size_t) noexcept {
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t purge_force(void *, size_t) noexcept {
+            forcePurges++;
+            return UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    manual_decay_clock clock;
+
+    auto config = poolConfig();
+    config.DecayMs = decay.count();
+    config.ProviderZeroesMemory = 1;
+
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &provider_ops, nullptr, nullptr});
+
+    // dirty a chunk, the empty slab then stays in the pool
+    char *ptr = (char *)umfPoolCalloc(pool.get(), 1, size);
+    ASSERT_NE(ptr, nullptr);
+    std::memset(ptr, 0xFF, size);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+
+    clock.advance(decay * 5 / 2);
+    for (size_t i = 0; i < 256; i++) {
+        void *large = umfPoolMalloc(pool.get(), 2 * config.MaxPoolableSize);
+        ASSERT_NE(large, nullptr);
+        ASSERT_EQ(umfPoolFree(pool.get(), large), UMF_RESULT_SUCCESS);
+    }
+    ASSERT_GT(forcePurges, 0);
+
+    ptr = (char *)umfPoolCalloc(pool.get(), 1, size);
+    ASSERT_NE(ptr, nullptr);
+    for (size_t j = 0; j < size; j++) {
+        ASSERT_EQ(ptr[j], 0);
+    }
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+}
+
+TEST_F(test, decayPooledSlabsInBackground) {
+    using namespace std::chrono_literals;
+    static constexpr auto decay = 50ms;
+
+    decay_memory_provider::reset();
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<decay_memory_provider, void>();
+
+    auto config = poolConfig();
+    config.DecayMs = decay.count();
+    config.DecayBackgroundThread = 1;
+
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &provider_ops, nullptr, nullptr});
+
+    // an empty slab of a chunked bucket stays in the pool
+    void *ptr = umfPoolMalloc(pool.get(), 64);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    EXPECT_EQ(decay_memory_provider::firstFreed, 0);
+
+    for (int i = 0; i < 100 && !decay_memory_provider::firstFreed; i++) {
+        std::this_thread::sleep_for(decay);
+    }
+    EXPECT_EQ(decay_memory_provider::firstFreed, 1);
+    EXPECT_LE(decay_memory_provider::lazyPurges, 1);
+    EXPECT_LE(decay_memory_provider::forcePurges, 1);
+
+    // the bucket still works after its pooled slab was released
+    ptr = umfPoolMalloc(pool.get(), 64);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+}
+
+static std::vector<umf_disjoint_pool_bucket_stats_t>
+getBucketStats(umf_memory_pool_handle_t pool) {
+    size_t numBuckets = 0;
+    EXPECT_EQ(umfDisjointPoolGetStats(pool, nullptr, &numBuckets),
+              UMF_RESULT_SUCCESS);
+    EXPECT_GT(numBuckets, 0);
+
+    std::vector<umf_disjoint_pool_bucket_stats_t> stats(numBuckets);
+    EXPECT_EQ(umfDisjointPoolGetStats(pool, stats.data(), &numBuckets),
+              UMF_RESULT_SUCCESS);
+    EXPECT_EQ(numBuckets, stats.size());
+    return stats;
+}
+
+static umf_disjoint_pool_bucket_stats_t
+findBucketStats(const std::vector<umf_disjoint_pool_bucket_stats_t> &stats,
+                size_t bucketSize) {
+    for (auto &bucketStats : stats) {
+        if (bucketStats.BucketSize == bucketSize) {
+            return bucketStats;
+        }
+    }
+    ADD_FAILURE() << "no bucket of size " << bucketSize;
+    return {};
+}
+
+static void checkStats(umf_disjoint_pool_params_t &config) {
+    static constexpr size_t numAllocs = 100;
+
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    std::vector<void *> ptrs;
+    for (size_t i = 0; i < numAllocs; i++) {
+        ptrs.push_back(umfPoolMalloc(pool.get(), 64));
+        ASSERT_NE(ptrs.back(), nullptr);
+    }
+    void *slabPtr = umfPoolMalloc(pool.get(), config.SlabMinSize);
+    ASSERT_NE(slabPtr, nullptr);
+
+    auto stats = getBucketStats(pool.get());
+    auto chunkStats = findBucketStats(stats, 64);
+    EXPECT_EQ(chunkStats.AllocCount, numAllocs);
+    EXPECT_EQ(chunkStats.FreeCount, 0);
+    EXPECT_EQ(chunkStats.CurSlabsInUse, 2); // 64 chunks per slab
+    EXPECT_EQ(chunkStats.SlabSize, config.SlabMinSize);
+
+    auto slabStats = findBucketStats(stats, config.SlabMinSize);
+    EXPECT_EQ(slabStats.AllocCount, 1);
+    EXPECT_EQ(slabStats.AllocPoolCount, 0);
+    EXPECT_EQ(slabStats.CurSlabsInUse, 1);
+
+    // the freed slab is kept in the pool and reused
+    ASSERT_EQ(umfPoolFree(pool.get(), slabPtr), UMF_RESULT_SUCCESS);
+    slabStats = findBucketStats(getBucketStats(pool.get()), config.SlabMinSize);
+    EXPECT_EQ(slabStats.FreeCount, 1);
+    EXPECT_EQ(slabStats.CurSlabsInUse, 0);
+    EXPECT_EQ(slabStats.CurSlabsInPool, 1);
+
+    slabPtr = umfPoolMalloc(pool.get(), config.SlabMinSize);
+    ASSERT_NE(slabPtr, nullptr);
+    slabStats = findBucketStats(getBucketStats(pool.get()), config.SlabMinSize);
+    EXPECT_EQ(slabStats.AllocCount, 2);
+    EXPECT_EQ(slabStats.AllocPoolCount, 1);
+    EXPECT_EQ(slabStats.CurSlabsInPool, 0);
+    EXPECT_EQ(slabStats.MaxSlabsInPool, 1);
+    ASSERT_EQ(umfPoolFree(pool.get(), slabPtr), UMF_RESULT_SUCCESS);
+
+    for (auto ptr : ptrs) {
+        ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    }
+    chunkStats = findBucketStats(getBucketStats(pool.get()), 64);
+    EXPECT_EQ(chunkStats.FreeCount, numAllocs);
+    EXPECT_EQ(chunkStats.MaxSlabsInUse, 2);
+
+    // a shorter array gets the first buckets only
+    size_t numBuckets = 1;
+    umf_disjoint_pool_bucket_stats_t first = {};
+    ASSERT_EQ(umfDisjointPoolGetStats(pool.get(), &first, &numBuckets),
+              UMF_RESULT_SUCCESS);
+    EXPECT_GT(numBuckets, 1);
+    EXPECT_EQ(first.BucketSize, getBucketStats(pool.get())[0].BucketSize);
+}
+
+TEST_F(test, getStats) {
+    auto config = poolConfig();
+    checkStats(config);
+}
+
+TEST_F(test, getStatsWithThreadCache) {
+    auto config = poolConfig();
+    config.ThreadCacheCapacity = 16;
+    checkStats(config);
+}
+
+TEST_F(test, getStatsInvalidArgs) {
+    size_t numBuckets = 0;
+    EXPECT_EQ(umfDisjointPoolGetStats(nullptr, nullptr, &numBuckets),
+              UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    auto config = poolConfig();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+    EXPECT_EQ(umfDisjointPoolGetStats(pool.get(), nullptr, nullptr),
+              UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    auto proxyPool =
+        poolCreateExtUnique({umfProxyPoolOps(), nullptr,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+    EXPECT_EQ(umfDisjointPoolGetStats(proxyPool.get(), nullptr, &numBuckets),
+              UMF_RESULT_ERROR_INVALID_ARGUMENT);
+}
+
+TEST_F(test, alignedAllocExactBucket) {
+    static const size_t bucketSizes[] = {136, 152, 168, 184};
+
+    auto config = poolConfig();
+    config.BucketSizes = bucketSizes;
+    config.NumBucketSizes = std::size(bucketSizes);
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    // {size, alignment, expected bucket}
+    static const size_t cases[][3] = {
+        {130, 8, 136},      // the exact bucket is aligned enough
+        {130, 16, 192},     // no explicit bucket is a multiple of 16
+        {256, 256, 256},    // no padding for power of 2 sizes
+        {64, 512, 512},     // the first bucket aligned by construction
+        {100, 4096, 3072}}; // whole slabs are aligned
+    for (auto &c : cases) {
+        void *ptr = umfPoolAlignedMalloc(pool.get(), c[0], c[1]);
+        ASSERT_NE(ptr, nullptr);
+        EXPECT_EQ((uintptr_t)ptr % c[1], 0);
+        EXPECT_GE(umfPoolMallocUsableSize(pool.get(), ptr), c[2]);
+
+        auto stats = findBucketStats(getBucketStats(pool.get()), c[2]);
+        EXPECT_EQ(stats.AllocCount, 1) << "size " << c[0] << " alignment "
+                                       << c[1];
+        ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    }
+}
+
+TEST_F(test, numaShards) {
+    auto config = poolConfig();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+    auto unsharded = getBucketStats(pool.get());
+
+    config.NumaShards = 1;
+    config.ThreadCacheCapacity = 16;
+    auto shardedPool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+    auto sharded = getBucketStats(shardedPool.get());
+
+    // every shard has the same buckets, listed shard by shard
+    ASSERT_EQ(sharded.size() % unsharded.size(), 0);
+    for (size_t i = 0; i < sharded.size(); i++) {
+        EXPECT_EQ(sharded[i].BucketSize,
+                  unsharded[i % unsharded.size()].BucketSize);
+        EXPECT_EQ(sharded[i].Shard, i / unsharded.size());
+    }
+
+    // memory allocated by one thread and freed by another goes back to the
+    // shard it came from
+    static constexpr size_t numAllocs = 1000;
+    std::vector<void *> ptrs(numAllocs);
+    std::thread allocator([&] {
+        for (auto &ptr : ptrs) {
+            ptr = umfPoolMalloc(shardedPool.get(), 64);
+            ASSERT_NE(ptr, nullptr);
+        }
+    });
+    allocator.join();
+
+    std::thread freer([&] {
+        for (auto ptr : ptrs) {
+            ASSERT_EQ(umfPoolFree(shardedPool.get(), ptr), UMF_RESULT_SUCCESS);
+        }
+    });
+    freer.join();
+
+    size_t allocCount = 0, freeCount = 0, slabsInUse = 0;
+    for (auto &bucketStats : getBucketStats(shardedPool.get())) {
+        allocCount += bucketStats.AllocCount;
+        freeCount += bucketStats.FreeCount;
+        slabsInUse += bucketStats.CurSlabsInUse;
+    }
+    EXPECT_EQ(allocCount, numAllocs);
+    EXPECT_EQ(freeCount, numAllocs);
+    EXPECT_EQ(slabsInUse, 0);
+}
+
+TEST_F(test, remoteFrees) {
+    static constexpr size_t numAllocs = 200; // several slabs of 64 chunks
+
+    auto config = poolConfig();
+    config.RemoteFrees = 1;
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    std::vector<void *> ptrs;
+    for (size_t i = 0; i < numAllocs; i++) {
+        ptrs.push_back(umfPoolMalloc(pool.get(), 64));
+        ASSERT_NE(ptrs.back(), nullptr);
+    }
+
+    std::thread freer([&] {
+        for (auto ptr : ptrs) {
+            ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+        }
+    });
+    freer.join();
+
+    // the chunks are queued until the next allocation from the bucket
+    auto stats = findBucketStats(getBucketStats(pool.get()), 64);
+    EXPECT_EQ(stats.FreeCount, numAllocs);
+    EXPECT_EQ(stats.CurSlabsInUse, 4);
+
+    void *ptr = umfPoolMalloc(pool.get(), 64);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_NE(std::find(ptrs.begin(), ptrs.end(), ptr), ptrs.end());
+
+    stats = findBucketStats(getBucketStats(pool.get()), 64);
+    EXPECT_EQ(stats.CurSlabsInUse, 1);
+    EXPECT_EQ(stats.CurSlabsInPool, 0);
+
+    // frees of the owner take the bucket lock as usual
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    stats = findBucketStats(getBucketStats(pool.get()), 64);
+    EXPECT_EQ(stats.CurSlabsInUse, 0);
+    EXPECT_EQ(stats.CurSlabsInPool, 1);
+}
+
+TEST_F(test, remoteFreesProducerConsumer) {
+    static constexpr size_t numMessages = 100000;
+    static constexpr size_t queueSize = 256;
+
+    auto config = poolConfig();
+    config.RemoteFrees = 1;
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    std::array<std::atomic<void *>, queueSize> queue{};
+    std::thread producer([&] {
+        for (size_t i = 0; i < numMessages; i++) {
+            void *ptr = umfPoolMalloc(pool.get(), 64 + (i % 4) * 64);
+            ASSERT_NE(ptr, nullptr);
+            *static_cast<size_t *>(ptr) = i;
+            while (queue[i % queueSize].load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            queue[i % queueSize].store(ptr, std::memory_order_release);
+        }
+    });
+
+    std::thread consumer([&] {
+        for (size_t i = 0; i < numMessages; i++) {
+            void *ptr;
+            while (!(ptr = queue[i % queueSize].load(
+                         std::memory_order_acquire))) {
+                std::this_thread::yield();
+            }
+            queue[i % queueSize].store(nullptr, std::memory_order_release);
+            ASSERT_EQ(*static_cast<size_t *>(ptr), i);
+            ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    size_t allocCount = 0, freeCount = 0;
+    for (auto &bucketStats : getBucketStats(pool.get())) {
+        allocCount += bucketStats.AllocCount;
+        freeCount += bucketStats.FreeCount;
+    }
+    EXPECT_EQ(allocCount, numMessages);
+    EXPECT_EQ(freeCount, numMessages);
+}
+
+TEST_F(test, adaptiveSlabSizes) {
+    static constexpr size_t numAllocs = 200;
+
+    auto config = poolConfig();
+    config.SlabMaxSize = 8 * config.SlabMinSize;
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    std::vector<void *> ptrs;
+    for (size_t i = 0; i < numAllocs; i++) {
+        for (size_t size : {64, 1024}) {
+            void *ptr = umfPoolMalloc(pool.get(), size);
+            ASSERT_NE(ptr, nullptr);
+            // the slab is found whatever its size
+            ASSERT_EQ(umfPoolMallocUsableSize(pool.get(), ptr), size);
+            memset(ptr, 0xab, size);
+            ptrs.push_back(ptr);
+        }
+    }
+
+    // the slabs of the 1024 byte bucket grow up to SlabMaxSize, the slabs
+    // of the smallest bucket are already full of chunks at SlabMinSize
+    auto stats = getBucketStats(pool.get());
+    EXPECT_EQ(findBucketStats(stats, 1024).SlabSize, config.SlabMaxSize);
+    EXPECT_LT(findBucketStats(stats, 1024).CurSlabsInUse,
+              numAllocs * 1024 / config.SlabMinSize);
+    EXPECT_EQ(findBucketStats(stats, 64).SlabSize, config.SlabMinSize);
+
+    for (auto ptr : ptrs) {
+        ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    }
+
+    stats = getBucketStats(pool.get());
+    EXPECT_EQ(findBucketStats(stats, 1024).CurSlabsInUse, 0);
+    EXPECT_EQ(findBucketStats(stats, 64).CurSlabsInUse, 0);
+}
+
+TEST_F(test, freeIntoGrownSlabsWithSlabChurn) {
+    static constexpr size_t numThreads = 4;
+    static constexpr size_t numRounds = 20;
+    static constexpr size_t numAllocs = 256;
+    static constexpr size_t allocSize = 1024;
+
+    // most chunks lie past SlabMinSize in their grown slabs, and the slabs
+    // are destroyed all the time while other threads look them up on free
+    auto limits =
+        std::unique_ptr<umf_disjoint_pool_shared_limits_t,
+                        decltype(&umfDisjointPoolSharedLimitsDestroy)>(
+            umfDisjointPoolSharedLimitsCreate(0),
+            &umfDisjointPoolSharedLimitsDestroy);
+
+    auto config = poolConfig();
+    config.SlabMaxSize = 16 * config.SlabMinSize;
+    config.SharedLimits = limits.get();
+
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    std::vector<std::vector<void *>> allocs(numThreads);
+    umf_test::syncthreads_barrier syncthreads(numThreads);
+
+    umf_test::parallel_exec(numThreads, [&](size_t id) {
+        for (size_t round = 0; round < numRounds; round++) {
+            for (size_t i = 0; i < numAllocs; i++) {
+                void *ptr = umfPoolMalloc(pool.get(), allocSize);
+                ASSERT_NE(ptr, nullptr);
+                std::memset(ptr, (int)id, allocSize);
+                allocs[id].push_back(ptr);
+            }
+
+            syncthreads();
+
+            // free the allocations of the neighbouring thread
+            auto &victim = allocs[(id + 1) % numThreads];
+            for (auto ptr : victim) {
+                ASSERT_EQ(umfPoolMallocUsableSize(pool.get(), ptr),
+                          allocSize);
+                ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+            }
+            victim.clear();
+
+            syncthreads();
+        }
+    });
+
+    auto stats = getBucketStats(pool.get());
+    EXPECT_GT(findBucketStats(stats, allocSize).SlabSize, config.SlabMinSize);
+    EXPECT_EQ(findBucketStats(stats, allocSize).CurSlabsInUse, 0);
+}
+
+static umf_disjoint_pool_large_cache_stats_t
+getLargeCacheStats(umf_memory_pool_handle_t pool) {
+    umf_disjoint_pool_large_cache_stats_t stats = {};
+    EXPECT_EQ(umfDisjointPoolGetLargeCacheStats(pool, &stats),
+              UMF_RESULT_SUCCESS);
+    return stats;
+}
+
+TEST_F(test, largeCacheReuse) {
+    static constexpr size_t MB = 1024 * 1024;
+
+    auto config = poolConfig();
+    config.LargeCacheSize = 8 * MB;
+    auto osParams = umfOsMemoryProviderParamsDefault();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             umfOsMemoryProviderOps(), &osParams, nullptr});
+
+    void *ptr = umfPoolMalloc(pool.get(), MB);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+
+    auto stats = getLargeCacheStats(pool.get());
+    EXPECT_EQ(stats.Hits, 0);
+    EXPECT_EQ(stats.Misses, 1);
+    EXPECT_EQ(stats.CachedBytes, MB);
+    EXPECT_EQ(stats.CachedExtents, 1);
+
+    // the freed extent is reused as a whole
+    void *ptr2 = umfPoolMalloc(pool.get(), MB);
+    EXPECT_EQ(ptr2, ptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr2), UMF_RESULT_SUCCESS);
+
+    // or split, with its tail staying cached
+    void *head = umfPoolMalloc(pool.get(), MB / 4);
+    EXPECT_EQ(head, ptr);
+    EXPECT_EQ(umfPoolMallocUsableSize(pool.get(), head), MB / 4);
+    void *tail = umfPoolMalloc(pool.get(), MB / 2);
+    EXPECT_EQ(tail, static_cast<char *>(ptr) + MB / 4);
+    stats = getLargeCacheStats(pool.get());
+    EXPECT_EQ(stats.Hits, 3);
+    EXPECT_EQ(stats.CachedBytes, MB / 4);
+    EXPECT_EQ(stats.CachedExtents, 1);
+    memset(head, 0, MB / 4);
+    memset(tail, 0, MB / 2);
+    ASSERT_EQ(umfPoolFree(pool.get(), head), UMF_RESULT_SUCCESS);
+    ASSERT_EQ(umfPoolFree(pool.get(), tail), UMF_RESULT_SUCCESS);
+
+    // the least recently freed extents are released above the cap
+    void *big = umfPoolMalloc(pool.get(), 7 * MB);
+    ASSERT_NE(big, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), big), UMF_RESULT_SUCCESS);
+    stats = getLargeCacheStats(pool.get());
+    EXPECT_LE(stats.CachedBytes, config.LargeCacheSize);
+    EXPECT_EQ(stats.ReleasedBytes + stats.CachedBytes, 8 * MB);
+
+    // extents over the cap are not cached
+    big = umfPoolMalloc(pool.get(), 9 * MB);
+    ASSERT_NE(big, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), big), UMF_RESULT_SUCCESS);
+    EXPECT_EQ(getLargeCacheStats(pool.get()).CachedBytes, stats.CachedBytes);
+}
+
+TEST_F(test, largeCacheBestFitEvictsOldest) {
+    static constexpr size_t MB = 1024 * 1024;
+
+    auto config = poolConfig();
+    config.LargeCacheSize = 4 * MB;
+    auto osParams = umfOsMemoryProviderParamsDefault();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             umfOsMemoryProviderOps(), &osParams, nullptr});
+
+    void *big = umfPoolMalloc(pool.get(), 2 * MB);
+    void *small1 = umfPoolMalloc(pool.get(), MB);
+    void *small2 = umfPoolMalloc(pool.get(), MB);
+    ASSERT_NE(big, nullptr);
+    ASSERT_NE(small1, nullptr);
+    ASSERT_NE(small2, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), big), UMF_RESULT_SUCCESS);
+    ASSERT_EQ(umfPoolFree(pool.get(), small1), UMF_RESULT_SUCCESS);
+    ASSERT_EQ(umfPoolFree(pool.get(), small2), UMF_RESULT_SUCCESS);
+    EXPECT_EQ(getLargeCacheStats(pool.get()).CachedBytes, 4 * MB);
+
+    // the smallest extent large enough is reused, not the oldest one
+    void *ptr = umfPoolMalloc(pool.get(), MB);
+    EXPECT_TRUE(ptr == small1 || ptr == small2);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+
+    // the least recently freed extents go first above the cap
+    ptr = umfPoolMalloc(pool.get(), 2 * MB);
+    EXPECT_EQ(ptr, big);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    void *fresh = umfPoolMalloc(pool.get(), 3 * MB);
+    ASSERT_NE(fresh, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), fresh), UMF_RESULT_SUCCESS);
+
+    auto stats = getLargeCacheStats(pool.get());
+    EXPECT_EQ(stats.CachedBytes, 3 * MB);
+    EXPECT_EQ(stats.CachedExtents, 1);
+    EXPECT_EQ(stats.ReleasedBytes, 4 * MB);
+    ptr = umfPoolMalloc(pool.get(), 3 * MB);
+    EXPECT_EQ(ptr, fresh);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+}
+
+TEST_F(test, largeCacheCalloc) {
+    static constexpr size_t size = 1024 * 1024;
+
+    auto config = poolConfig();
+    config.LargeCacheSize = 2 * size;
+    config.ProviderZeroesMemory = 1;
+    auto osParams = umfOsMemoryProviderParamsDefault();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             umfOsMemoryProviderOps(), &osParams, nullptr});
+
+    void *ptr = umfPoolMalloc(pool.get(), size);
+    ASSERT_NE(ptr, nullptr);
+    memset(ptr, 0xab, size);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+
+    // reused memory is not known to be zeroed
+    auto *zeroed = static_cast<char *>(umfPoolCalloc(pool.get(), 1, size));
+    ASSERT_EQ(zeroed, ptr);
+    for (size_t i = 0; i < size; i++) {
+        ASSERT_EQ(zeroed[i], 0);
+    }
+    ASSERT_EQ(umfPoolFree(pool.get(), zeroed), UMF_RESULT_SUCCESS);
+}
+
+TEST_F(test, largeCacheDecay) {
+    using namespace std::chrono_literals;
+    static constexpr auto decay = 20ms;
+
+    // extents age without the decay of pooled slabs
+    manual_decay_clock clock;
+    auto config = poolConfig();
+    config.LargeCacheSize = 1024 * 1024;
+    config.LargeCacheDecayMs = decay.count();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    void *ptr = umfPoolMalloc(pool.get(), 64 * 1024);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    EXPECT_EQ(getLargeCacheStats(pool.get()).CachedExtents, 1);
+
+    // the next large free releases the aged extent and caches its own
+    clock.advance(decay / 2);
+    ptr = umfPoolMalloc(pool.get(), 128 * 1024);
+    ASSERT_NE(ptr, nullptr);
+    clock.advance(decay / 2);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+
+    auto stats = getLargeCacheStats(pool.get());
+    EXPECT_EQ(stats.CachedExtents, 1);
+    EXPECT_EQ(stats.CachedBytes, 128 * 1024);
+    EXPECT_EQ(stats.ReleasedBytes, 64 * 1024);
+}
+
+TEST_F(test, largeCacheDecayInBackground) {
+    auto config = poolConfig();
+    config.LargeCacheSize = 1024 * 1024;
+    config.LargeCacheDecayMs = 20;
+    config.DecayMs = 20;
+    config.DecayBackgroundThread = 1;
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+
+    void *ptr = umfPoolMalloc(pool.get(), 64 * 1024);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptr), UMF_RESULT_SUCCESS);
+    EXPECT_EQ(getLargeCacheStats(pool.get()).CachedExtents, 1);
+
+    for (int i = 0; i < 100 && getLargeCacheStats(pool.get()).CachedExtents;
+         i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    auto stats = getLargeCacheStats(pool.get());
+    EXPECT_EQ(stats.CachedExtents, 0);
+    EXPECT_EQ(stats.ReleasedBytes, 64 * 1024);
+}
+
+TEST_F(test, largeCacheEvictionErrorDoesNotFailFree) {
+    static constexpr size_t size = 64 * 1024;
+    static void *failingPtr;
+    failingPtr = nullptr;
+
+    struct memory_provider : public umf_test::provider_base_t {
+        umf_result_t alloc(size_t size, size_t, void **ptr) noexcept {
+            *ptr = ::malloc(size);
+            return UMF_RESULT_SUCCESS;
+        }
+        umf_result_t free(void *ptr, [[maybe_unused]] size_t size) noexcept {
+            ::free(ptr);
+            return ptr == failingPtr ? UMF_RESULT_ERROR_UNKNOWN
+                                     : UMF_RESULT_SUCCESS;
+        }
+    };
+    umf_memory_provider_ops_t provider_ops =
+        umf::providerMakeCOps<memory_provider, void>();
+
+    auto config = poolConfig();
+    config.LargeCacheSize = 2 * size;
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &provider_ops, nullptr, nullptr});
+
+    void *ptrs[3];
+    for (auto &ptr : ptrs) {
+        ptr = umfPoolMalloc(pool.get(), size);
+        ASSERT_NE(ptr, nullptr);
+    }
+    ASSERT_EQ(umfPoolFree(pool.get(), ptrs[0]), UMF_RESULT_SUCCESS);
+    ASSERT_EQ(umfPoolFree(pool.get(), ptrs[1]), UMF_RESULT_SUCCESS);
+
+    // the oldest extent cannot be returned to the provider, but the free
+    // which evicts it succeeds and the cache stays within the cap
+    failingPtr = ptrs[0];
+    EXPECT_EQ(umfPoolFree(pool.get(), ptrs[2]), UMF_RESULT_SUCCESS);
+
+    auto stats = getLargeCacheStats(pool.get());
+    EXPECT_EQ(stats.CachedBytes, 2 * size);
+    EXPECT_EQ(stats.CachedExtents, 2);
+    EXPECT_EQ(stats.ReleasedBytes, size);
+}
+
+TEST_F(test, largeCacheStatsInvalidArgs) {
+    umf_disjoint_pool_large_cache_stats_t stats;
+    EXPECT_EQ(umfDisjointPoolGetLargeCacheStats(nullptr, &stats),
+              UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    auto config = poolConfig();
+    auto pool =
+        poolCreateExtUnique({umfDisjointPoolOps(), (void *)&config,
+                             &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr});
+    EXPECT_EQ(umfDisjointPoolGetLargeCacheStats(pool.get(), nullptr),
+              UMF_RESULT_ERROR_INVALID_ARGUMENT);
+}
+
+// The configurations run through the generic pool tests: the default one
+// and one for each optional feature of the pool
+struct poolConfigVariant {
+    std::string name;
+    umf_disjoint_pool_params_t config;
+};
+
+static const size_t messageBucketSizes[] = {136, 152, 168, 184};
+
+std::vector<poolConfigVariant> makePoolConfigVariants() {
+    auto variant = [](const char *name, auto setUp) {
+        poolConfigVariant v{name, poolConfig()};
+        setUp(v.config);
+        return v;
+    };
+
+    return {
+        variant("Default", [](auto &) {}),
+        variant("ThreadCache",
+                [](auto &config) { config.ThreadCacheCapacity = 16; }),
+        variant("SizeClass",
+                [](auto &config) {
+                    config.SizeClassesPerDoubling = 8;
+                    config.BucketSizes = messageBucketSizes;
+                    config.NumBucketSizes = std::size(messageBucketSizes);
+                }),
+        variant("NumaShards",
+                [](auto &config) {
+                    config.NumaShards = 1;
+                    config.ThreadCacheCapacity = 16;
+                }),
+        variant("RemoteFrees", [](auto &config) { config.RemoteFrees = 1; }),
+        variant("AdaptiveSlabs",
+                [](auto &config) {
+                    config.SlabMaxSize = 16 * config.SlabMinSize;
+                }),
+        variant("LargeCache",
+                [](auto &config) { config.LargeCacheSize = 16 * 1024 * 1024; }),
+    };
+}
+
+// the tests keep pointers to the configurations
+auto poolConfigVariants = makePoolConfigVariants();
+
+std::vector<poolCreateExtParams> poolConfigVariantsParams() {
+    std::vector<poolCreateExtParams> params;
+    for (auto &variant : poolConfigVariants) {
+        params.emplace_back(umfDisjointPoolOps(), (void *)&variant.config,
+                            &BA_GLOBAL_PROVIDER_OPS, nullptr, nullptr);
+    }
+    return params;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    disjointPoolTests, umfPoolTest,
+    ::testing::ValuesIn(poolConfigVariantsParams()),
+    [](const ::testing::TestParamInfo<poolCreateExtParams> &info) {
+        return poolConfigVariants[info.index].name;
+    });
+
+auto defaultPoolConfig = poolConfig();
 INSTANTIATE_TEST_SUITE_P(
     disjointPoolTests, umfMemTest,
     ::testing::Values(std::make_tuple(
@@ -15,4 +15,14 @@ using namespace umf_test;
 
 #define FILE_PATH ((char *)"tmp_file_provider")
 
+// Number of sub-heaps of the coarse provider in the sharded variants
+#define COARSE_NUM_HEAPS 4
+
+static inline coarse_memory_provider_params_t
+coarseParamsWithHeaps(size_t numHeaps) {
+    auto params = umfCoarseMemoryProviderParamsDefault();
+    params.num_heaps = numHeaps;
+    return params;
+}
+
 #endif /* UMF_TEST_POOL_COARSE_HPP */
@@ -8,6 +8,7 @@
 #include "pool_coarse.hpp"
 
 auto coarseParams = umfCoarseMemoryProviderParamsDefault();
+auto coarseHeapsParams = coarseParamsWithHeaps(COARSE_NUM_HEAPS);
 auto devdaxParams = umfDevDaxMemoryProviderParamsDefault(
     getenv("UMF_TESTS_DEVDAX_PATH"), getenv("UMF_TESTS_DEVDAX_SIZE")
                                          ? atol(getenv("UMF_TESTS_DEVDAX_SIZE"))
@@ -18,3 +19,10 @@ INSTANTIATE_TEST_SUITE_P(scalableCoarseDevDaxTest, umfPoolTest,
                              umfScalablePoolOps(), nullptr,
                              umfDevDaxMemoryProviderOps(), &devdaxParams,
                              &coarseParams}));
+
+// the coarse provider split into independently locked sub-heaps
+INSTANTIATE_TEST_SUITE_P(scalableCoarseDevDaxHeapsTest, umfPoolTest,
+                         ::testing::Values(poolCreateExtParams{
+                             umfScalablePoolOps(), nullptr,
+                             umfDevDaxMemoryProviderOps(), &devdaxParams,
+                             &coarseHeapsParams}));
@@ -8,6 +8,7 @@
 #include "pool_coarse.hpp"
 
 auto coarseParams = umfCoarseMemoryProviderParamsDefault();
+auto coarseHeapsParams = coarseParamsWithHeaps(COARSE_NUM_HEAPS);
 auto fileParams = umfFileMemoryProviderParamsDefault(FILE_PATH);
 
 INSTANTIATE_TEST_SUITE_P(scalableCoarseFileTest, umfPoolTest,
@@ -15,3 +16,10 @@ INSTANTIATE_TEST_SUITE_P(scalableCoarseFileTest, umfPoolTest,
                              umfScalablePoolOps(), nullptr,
                              umfFileMemoryProviderOps(), &fileParams,
                              &coarseParams}));
+
+// the coarse provider split into independently locked sub-heaps
+INSTANTIATE_TEST_SUITE_P(scalableCoarseFileHeapsTest, umfPoolTest,
+                         ::testing::Values(poolCreateExtParams{
+                             umfScalablePoolOps(), nullptr,
+                             umfFileMemoryProviderOps(), &fileParams,
+                             &coarseHeapsParams}));
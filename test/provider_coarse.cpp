@@ -6,7 +6,9 @@
 */
 
 #include <random>
+#include <thread>
 
+#include "decay_clock.h"
 #include "provider.hpp"
 
 #include <umf/providers/provider_coarse.h>
@@ -24,6 +26,41 @@ using umf_test::test;
 umf_memory_provider_ops_t UMF_MALLOC_MEMORY_PROVIDER_OPS =
     umf::providerMakeCOps<umf_test::provider_ba_global, void>();
 
+// the clock which ages the free blocks waiting to be purged,
+// advanced by the tests instead of sleeping
+struct manual_purge_clock {
+    manual_purge_clock() { umf_decay_clock_set_ms(now_ms); }
+    ~manual_purge_clock() { umf_decay_clock_set_ms(-1); }
+
+    void advance(uint64_t ms) {
+        now_ms += ms;
+        umf_decay_clock_set_ms(now_ms);
+    }
+
+  private:
+    int64_t now_ms = 1000;
+};
+
+// the umf_ba_global provider counting the purge operations
+struct provider_purge_counter : public umf_test::provider_ba_global {
+    static inline size_t num_purge_lazy = 0;
+    static inline size_t num_purge_force = 0;
+
+    umf_result_t purge_lazy(void *, size_t) noexcept {
+        num_purge_lazy++;
+        return UMF_RESULT_SUCCESS;
+    }
+    // the contents of forcibly purged memory are lost (zeroed)
+    umf_result_t purge_force(void *ptr, size_t size) noexcept {
+        num_purge_force++;
+        memset(ptr, 0, size);
+        return UMF_RESULT_SUCCESS;
+    }
+};
+
+umf_memory_provider_ops_t PURGE_COUNTER_PROVIDER_OPS =
+    umf::providerMakeCOps<provider_purge_counter, void>();
+
 struct CoarseWithMemoryStrategyTest
     : umf_test::test,
       ::testing::WithParamInterface<coarse_memory_provider_strategy_t> {
@@ -39,7 +76,8 @@ INSTANTIATE_TEST_SUITE_P(
     CoarseWithMemoryStrategyTest, CoarseWithMemoryStrategyTest,
     ::testing::Values(UMF_COARSE_MEMORY_STRATEGY_FASTEST,
                       UMF_COARSE_MEMORY_STRATEGY_FASTEST_BUT_ONE,
-                      UMF_COARSE_MEMORY_STRATEGY_CHECK_ALL_SIZE));
+                      UMF_COARSE_MEMORY_STRATEGY_CHECK_ALL_SIZE,
+                      UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT));
 
 TEST_F(test, coarseProvider_name_upstream) {
     umf_memory_provider_handle_t malloc_memory_provider;
@@ -666,3 +704,768 @@ TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_purge_with_upstream) {
     umfMemoryProviderDestroy(coarse_memory_provider);
     umfMemoryProviderDestroy(malloc_memory_provider);
 }
+
+TEST_F(test, coarseProvider_segregated_fit_fragments) {
+    umf_result_t umf_result;
+
+    const size_t init_buffer_size = 4 * MB;
+
+    // preallocate some memory and initialize the vector with zeros
+    std::vector<char> buffer(init_buffer_size, 0);
+    void *buf = (void *)buffer.data();
+    ASSERT_NE(buf, nullptr);
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy =
+        UMF_COARSE_MEMORY_STRATEGY_SEGREGATED_FIT;
+    coarse_memory_provider_params.upstream_memory_provider = nullptr;
+    coarse_memory_provider_params.immediate_init_from_upstream = false;
+    coarse_memory_provider_params.init_buffer = buf;
+    coarse_memory_provider_params.init_buffer_size = init_buffer_size;
+
+    umf_memory_provider_handle_t coarse_memory_provider = nullptr;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+
+    // sizes of many size classes (16 classes per power of 2),
+    // all blocks of one class are of the same size
+    const size_t nptrs = 256;
+    std::vector<void *> ptrs(nptrs);
+    std::vector<size_t> sizes(nptrs);
+    for (size_t i = 0; i < nptrs; i++) {
+        sizes[i] = (16 + (i * 7) % 16) << (i % 5 + 2);
+        umf_result = umfMemoryProviderAlloc(cp, sizes[i], 0, &ptrs[i]);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+        ASSERT_NE(ptrs[i], nullptr);
+    }
+
+    size_t used_size = GetStats(cp).used_size;
+
+    // free every other block leaving fragments that cannot be merged
+    for (size_t i = 0; i < nptrs; i += 2) {
+        umf_result = umfMemoryProviderFree(cp, ptrs[i], sizes[i]);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    }
+    ASSERT_EQ(GetStats(cp).num_free_blocks, nptrs / 2 + 1);
+
+    // the freed blocks are reused without splitting the larger ones
+    for (size_t i = 0; i < nptrs; i += 2) {
+        umf_result = umfMemoryProviderAlloc(cp, sizes[i], 0, &ptrs[i]);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+        ASSERT_NE(ptrs[i], nullptr);
+    }
+    ASSERT_EQ(GetStats(cp).used_size, used_size);
+    ASSERT_EQ(GetStats(cp).num_free_blocks, 1);
+
+    // an aligned allocation has to be aligned
+    void *ptr = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 100, 4 * KB, &ptr);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ((uintptr_t)ptr % (4 * KB), 0);
+
+    umf_result = umfMemoryProviderFree(cp, ptr, 100);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+
+    for (size_t i = 0; i < nptrs; i++) {
+        umf_result = umfMemoryProviderFree(cp, ptrs[i], sizes[i]);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    }
+
+    ASSERT_EQ(GetStats(cp).used_size, 0);
+    ASSERT_EQ(GetStats(cp).num_free_blocks, 1);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+}
+
+TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_num_heaps_init_buffer) {
+    umf_result_t umf_result;
+
+    const size_t num_heaps = 4;
+    const size_t init_buffer_size = 4 * MB;
+
+    // preallocate some memory and initialize the vector with zeros
+    std::vector<char> buffer(init_buffer_size, 0);
+    void *buf = (void *)buffer.data();
+    ASSERT_NE(buf, nullptr);
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy = allocation_strategy;
+    coarse_memory_provider_params.upstream_memory_provider = nullptr;
+    coarse_memory_provider_params.immediate_init_from_upstream = false;
+    coarse_memory_provider_params.init_buffer = buf;
+    coarse_memory_provider_params.init_buffer_size = init_buffer_size;
+    coarse_memory_provider_params.num_heaps = num_heaps;
+
+    umf_memory_provider_handle_t coarse_memory_provider = nullptr;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+
+    // the init buffer is split between the heaps
+    ASSERT_EQ(GetStats(cp).alloc_size, init_buffer_size);
+    ASSERT_EQ(GetStats(cp).used_size, 0);
+    ASSERT_EQ(GetStats(cp).num_upstream_blocks, num_heaps);
+    ASSERT_EQ(GetStats(cp).num_free_blocks, num_heaps);
+
+    // a block larger than a single heap cannot be allocated
+    void *ptr = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 2 * MB, 0, &ptr);
+    ASSERT_EQ(umf_result, UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+    ASSERT_EQ(ptr, nullptr);
+
+    // one thread can use the whole buffer stealing from the other heaps
+    const size_t alloc_size = 64 * KB;
+    std::vector<void *> ptrs(init_buffer_size / alloc_size);
+    for (auto &p : ptrs) {
+        umf_result = umfMemoryProviderAlloc(cp, alloc_size, 0, &p);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+        ASSERT_NE(p, nullptr);
+    }
+    ASSERT_EQ(GetStats(cp).used_size, init_buffer_size);
+
+    umf_result = umfMemoryProviderAlloc(cp, alloc_size, 0, &ptr);
+    ASSERT_EQ(umf_result, UMF_RESULT_ERROR_OUT_OF_HOST_MEMORY);
+
+    // blocks of different heaps cannot be merged
+    const size_t heap_size = init_buffer_size / num_heaps;
+    void *last_of_heap = (char *)buf + heap_size - alloc_size;
+    umf_result = umfMemoryProviderAllocationMerge(
+        cp, last_of_heap, (char *)last_of_heap + alloc_size, 2 * alloc_size);
+    ASSERT_EQ(umf_result, UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    // but blocks of the same heap can
+    umf_result = umfMemoryProviderAllocationMerge(
+        cp, buf, (char *)buf + alloc_size, 2 * alloc_size);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    umf_result = umfMemoryProviderAllocationSplit(cp, buf, 2 * alloc_size,
+                                                  alloc_size);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+
+    for (auto p : ptrs) {
+        umf_result = umfMemoryProviderFree(cp, p, alloc_size);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    }
+
+    ASSERT_EQ(GetStats(cp).used_size, 0);
+    ASSERT_EQ(GetStats(cp).num_free_blocks, num_heaps);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+}
+
+TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_num_heaps_upstream_mt) {
+    umf_memory_provider_handle_t malloc_memory_provider;
+    umf_result_t umf_result;
+
+    umf_result = umfMemoryProviderCreate(&UMF_MALLOC_MEMORY_PROVIDER_OPS, NULL,
+                                         &malloc_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(malloc_memory_provider, nullptr);
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy = allocation_strategy;
+    coarse_memory_provider_params.upstream_memory_provider =
+        malloc_memory_provider;
+    coarse_memory_provider_params.destroy_upstream_memory_provider = true;
+    coarse_memory_provider_params.immediate_init_from_upstream = true;
+    coarse_memory_provider_params.init_buffer_size = 4 * MB;
+    coarse_memory_provider_params.num_heaps = 4;
+
+    umf_memory_provider_handle_t coarse_memory_provider;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+
+    // threads allocate from their own heaps and free the blocks allocated
+    // by the other threads
+    const size_t num_threads = 4;
+    const size_t num_allocs = 64;
+    std::vector<std::vector<void *>> ptrs(num_threads);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; t++) {
+        threads.emplace_back([&, t] {
+            std::mt19937_64 rng(t);
+            for (size_t i = 0; i < num_allocs; i++) {
+                void *ptr = nullptr;
+                size_t size = (rng() % 16 + 1) * KB;
+                if (umfMemoryProviderAlloc(cp, size, 0, &ptr) ==
+                    UMF_RESULT_SUCCESS) {
+                    ptrs[t].push_back(ptr);
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    threads.clear();
+
+    for (size_t t = 0; t < num_threads; t++) {
+        ASSERT_EQ(ptrs[t].size(), num_allocs);
+        threads.emplace_back([&, t] {
+            for (auto ptr : ptrs[(t + 1) % num_threads]) {
+                umfMemoryProviderFree(cp, ptr, 0);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(GetStats(cp).used_size, 0);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+}
+
+TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_upstream_chunk_growth) {
+    umf_memory_provider_handle_t malloc_memory_provider;
+    umf_result_t umf_result;
+
+    umf_result = umfMemoryProviderCreate(&UMF_MALLOC_MEMORY_PROVIDER_OPS, NULL,
+                                         &malloc_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(malloc_memory_provider, nullptr);
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy = allocation_strategy;
+    coarse_memory_provider_params.upstream_memory_provider =
+        malloc_memory_provider;
+    coarse_memory_provider_params.min_upstream_chunk_size = 64 * KB;
+    coarse_memory_provider_params.upstream_chunk_growth_factor = 2;
+    coarse_memory_provider_params.max_upstream_chunk_size = 1 * MB;
+
+    umf_memory_provider_handle_t coarse_memory_provider;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+
+    // chunks of 64K, 128K, 256K, 512K and 1M are enough for 1000K
+    const size_t alloc_size = 8 * KB;
+    const size_t num_allocs = 125;
+    std::vector<void *> ptrs(num_allocs);
+    for (auto &ptr : ptrs) {
+        umf_result = umfMemoryProviderAlloc(cp, alloc_size, 0, &ptr);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+        ASSERT_NE(ptr, nullptr);
+    }
+
+    ASSERT_EQ(GetStats(cp).num_upstream_calls, 5);
+    ASSERT_EQ(GetStats(cp).alloc_size, (64 + 128 + 256 + 512 + 1024) * KB);
+    ASSERT_EQ(GetStats(cp).used_size, num_allocs * alloc_size);
+
+    // allocations not smaller than a chunk are allocated with their size
+    void *large = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 2 * MB, 0, &large);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(large, nullptr);
+    ASSERT_EQ(GetStats(cp).num_upstream_calls, 6);
+    ASSERT_EQ(GetStats(cp).alloc_size, (64 + 128 + 256 + 512 + 1024) * KB +
+                                           2 * MB);
+
+    // the chunk size stops growing at max_upstream_chunk_size
+    void *ptr = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 1000 * KB, 0, &ptr);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).num_upstream_calls, 7);
+    ASSERT_EQ(GetStats(cp).alloc_size, (64 + 128 + 256 + 512 + 2048) * KB +
+                                           2 * MB);
+
+    umf_result = umfMemoryProviderFree(cp, ptr, 1000 * KB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    umf_result = umfMemoryProviderFree(cp, large, 2 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+
+    for (auto p : ptrs) {
+        umf_result = umfMemoryProviderFree(cp, p, alloc_size);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    }
+    ASSERT_EQ(GetStats(cp).used_size, 0);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+
+    // without the growth policy every allocation calls the upstream provider
+    coarse_memory_provider_params.min_upstream_chunk_size = 0;
+    coarse_memory_provider_params.upstream_chunk_growth_factor = 0;
+    coarse_memory_provider_params.max_upstream_chunk_size = 0;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    cp = coarse_memory_provider;
+
+    for (auto &p : ptrs) {
+        umf_result = umfMemoryProviderAlloc(cp, alloc_size, 0, &p);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    }
+    ASSERT_EQ(GetStats(cp).num_upstream_calls, num_allocs);
+
+    for (auto p : ptrs) {
+        umf_result = umfMemoryProviderFree(cp, p, alloc_size);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    }
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+
+    // the maximum chunk size cannot be smaller than the minimum one
+    coarse_memory_provider_params.min_upstream_chunk_size = 2 * MB;
+    coarse_memory_provider_params.max_upstream_chunk_size = 1 * MB;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    umfMemoryProviderDestroy(malloc_memory_provider);
+}
+
+TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_trim) {
+    umf_memory_provider_handle_t malloc_memory_provider;
+    umf_result_t umf_result;
+
+    umf_result = umfMemoryProviderCreate(&UMF_MALLOC_MEMORY_PROVIDER_OPS, NULL,
+                                         &malloc_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(malloc_memory_provider, nullptr);
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy = allocation_strategy;
+    coarse_memory_provider_params.upstream_memory_provider =
+        malloc_memory_provider;
+    coarse_memory_provider_params.trim_threshold = 2 * MB;
+    coarse_memory_provider_params.trim_retained_size = 1 * MB;
+
+    umf_memory_provider_handle_t coarse_memory_provider;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+
+    // every allocation is a separate upstream block
+    const size_t num_allocs = 4;
+    std::vector<void *> ptrs(num_allocs);
+    for (auto &ptr : ptrs) {
+        umf_result = umfMemoryProviderAlloc(cp, 1 * MB, 0, &ptr);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+        ASSERT_NE(ptr, nullptr);
+    }
+    ASSERT_EQ(GetStats(cp).alloc_size, num_allocs * MB);
+    ASSERT_EQ(GetStats(cp).num_upstream_blocks, num_allocs);
+
+    // the free memory does not exceed trim_threshold yet
+    umf_result = umfMemoryProviderFree(cp, ptrs[0], 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    umf_result = umfMemoryProviderFree(cp, ptrs[1], 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).alloc_size, num_allocs * MB);
+
+    // the free memory goes back to 2 MB
+    umf_result = umfMemoryProviderFree(cp, ptrs[2], 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).alloc_size, 3 * MB);
+    umf_result = umfMemoryProviderFree(cp, ptrs[3], 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).alloc_size, 2 * MB);
+    ASSERT_EQ(GetStats(cp).num_upstream_blocks, 2);
+    ASSERT_EQ(GetStats(cp).used_size, 0);
+
+    // the retained memory is reused
+    void *ptr = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 1 * MB, 0, &ptr);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).num_upstream_calls, num_allocs);
+
+    // a block in use is never returned to the upstream provider
+    umf_result = umfCoarseMemoryProviderTrim(cp, 0);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).alloc_size, 1 * MB);
+    ASSERT_EQ(GetStats(cp).num_upstream_blocks, 1);
+
+    umf_result = umfMemoryProviderFree(cp, ptr, 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).alloc_size, 1 * MB);
+
+    // the retained memory is kept
+    umf_result = umfCoarseMemoryProviderTrim(cp, 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).alloc_size, 1 * MB);
+
+    umf_result = umfCoarseMemoryProviderTrim(cp, 0);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).alloc_size, 0);
+    ASSERT_EQ(GetStats(cp).num_upstream_blocks, 0);
+    ASSERT_EQ(GetStats(cp).num_all_blocks, 0);
+
+    // the provider still works after trimming
+    umf_result = umfMemoryProviderAlloc(cp, 1 * MB, 0, &ptr);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    umf_result = umfMemoryProviderFree(cp, ptr, 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+
+    umf_result = umfCoarseMemoryProviderTrim(nullptr, 0);
+    ASSERT_EQ(umf_result, UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+
+    // trim_retained_size has to be smaller than trim_threshold
+    coarse_memory_provider_params.trim_retained_size = 2 * MB;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    umfMemoryProviderDestroy(malloc_memory_provider);
+}
+
+TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_trim_upstream_no_free) {
+    umf_memory_provider_handle_t upstream_provider;
+    umf_result_t umf_result;
+
+    // the upstream provider does not support the free() operation
+    umf_memory_provider_ops_t no_free_provider_ops =
+        PURGE_COUNTER_PROVIDER_OPS;
+    no_free_provider_ops.ext.free = nullptr;
+
+    umf_result = umfMemoryProviderCreate(&no_free_provider_ops, NULL,
+                                         &upstream_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(upstream_provider, nullptr);
+
+    provider_purge_counter::num_purge_lazy = 0;
+    provider_purge_counter::num_purge_force = 0;
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy = allocation_strategy;
+    coarse_memory_provider_params.upstream_memory_provider = upstream_provider;
+    coarse_memory_provider_params.trim_threshold = 2 * MB;
+    coarse_memory_provider_params.trim_retained_size = 1 * MB;
+
+    umf_memory_provider_handle_t coarse_memory_provider;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+
+    // every allocation is a separate upstream block
+    const size_t num_allocs = 4;
+    std::vector<void *> ptrs(num_allocs);
+    for (auto &ptr : ptrs) {
+        umf_result = umfMemoryProviderAlloc(cp, 1 * MB, 0, &ptr);
+        ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+        ASSERT_NE(ptr, nullptr);
+    }
+
+    // the free memory does not exceed trim_threshold yet
+    umf_result = umfMemoryProviderFree(cp, ptrs[0], 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    umf_result = umfMemoryProviderFree(cp, ptrs[1], 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 0);
+
+    // the upstream blocks cannot be returned, so they are purged instead
+    umf_result = umfMemoryProviderFree(cp, ptrs[2], 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 1);
+    umf_result = umfMemoryProviderFree(cp, ptrs[3], 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 2);
+    ASSERT_EQ(GetStats(cp).alloc_size, num_allocs * MB);
+    ASSERT_EQ(GetStats(cp).num_upstream_blocks, num_allocs);
+    ASSERT_EQ(GetStats(cp).used_size, 0);
+
+    // a purged block is reused and purged again when it is freed
+    void *ptr = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 1 * MB, 0, &ptr);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).num_upstream_calls, num_allocs);
+    umf_result = umfMemoryProviderFree(cp, ptr, 1 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 3);
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 0);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+    umfMemoryProviderDestroy(upstream_provider);
+}
+
+TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_purge_decay) {
+    umf_memory_provider_handle_t upstream_provider;
+    umf_result_t umf_result;
+
+    umf_result = umfMemoryProviderCreate(&PURGE_COUNTER_PROVIDER_OPS, NULL,
+                                         &upstream_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(upstream_provider, nullptr);
+
+    provider_purge_counter::num_purge_lazy = 0;
+    provider_purge_counter::num_purge_force = 0;
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy = allocation_strategy;
+    coarse_memory_provider_params.upstream_memory_provider = upstream_provider;
+    coarse_memory_provider_params.purge_min_size = 1 * MB;
+    coarse_memory_provider_params.purge_lazy_delay_ms = 0;
+    coarse_memory_provider_params.purge_force_delay_ms = 200;
+
+    manual_purge_clock clock;
+    umf_memory_provider_handle_t coarse_memory_provider;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+
+    // every free() checks if there are blocks to purge
+    auto free_small_block = [&]() {
+        void *ptr = nullptr;
+        ASSERT_EQ(umfMemoryProviderAlloc(cp, 4 * KB, 0, &ptr),
+                  UMF_RESULT_SUCCESS);
+        ASSERT_EQ(umfMemoryProviderFree(cp, ptr, 4 * KB), UMF_RESULT_SUCCESS);
+    };
+
+    void *large = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 2 * MB, 0, &large);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+
+    // a small free block is never purged
+    free_small_block();
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 0);
+
+    // a large free block is purged lazily first ...
+    umf_result = umfMemoryProviderFree(cp, large, 2 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 1);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 0);
+
+    // ... only once ...
+    free_small_block();
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 1);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 0);
+
+    // ... and then forcibly
+    clock.advance(250);
+    free_small_block();
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 1);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 1);
+
+    free_small_block();
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 1);
+
+    // the purged block is reused and purged again when it is freed
+    size_t num_upstream_calls = GetStats(cp).num_upstream_calls;
+    umf_result = umfMemoryProviderAlloc(cp, 2 * MB, 0, &large);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(GetStats(cp).num_upstream_calls, num_upstream_calls);
+
+    umf_result = umfMemoryProviderFree(cp, large, 2 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 2);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+
+    // purge_force_delay_ms cannot be smaller than purge_lazy_delay_ms
+    coarse_memory_provider_params.purge_lazy_delay_ms = 300;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_ERROR_INVALID_ARGUMENT);
+
+    umfMemoryProviderDestroy(upstream_provider);
+}
+
+TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_purge_decay_no_free) {
+    umf_memory_provider_handle_t upstream_provider;
+    umf_result_t umf_result;
+
+    umf_result = umfMemoryProviderCreate(&PURGE_COUNTER_PROVIDER_OPS, NULL,
+                                         &upstream_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(upstream_provider, nullptr);
+
+    provider_purge_counter::num_purge_lazy = 0;
+    provider_purge_counter::num_purge_force = 0;
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy = allocation_strategy;
+    coarse_memory_provider_params.upstream_memory_provider = upstream_provider;
+    coarse_memory_provider_params.purge_min_size = 1 * MB;
+    coarse_memory_provider_params.purge_lazy_delay_ms = 20;
+    coarse_memory_provider_params.purge_force_delay_ms = 200;
+
+    manual_purge_clock clock;
+    umf_memory_provider_handle_t coarse_memory_provider;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+
+    void *large = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 2 * MB, 0, &large);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    umf_result = umfMemoryProviderFree(cp, large, 2 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 0);
+
+    // an alloc() which does not fit in the free block ages it
+    clock.advance(60);
+    void *larger = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, 4 * MB, 0, &larger);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 1);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 0);
+
+    // and so does a trim which keeps all the free memory
+    clock.advance(250);
+    umf_result = umfCoarseMemoryProviderTrim(cp, SIZE_MAX);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 1);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 1);
+    ASSERT_EQ(GetStats(cp).alloc_size, 6 * MB);
+
+    umf_result = umfMemoryProviderFree(cp, larger, 4 * MB);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+    umfMemoryProviderDestroy(upstream_provider);
+}
+
+TEST_P(CoarseWithMemoryStrategyTest, coarseProvider_purge_decay_reused) {
+    umf_memory_provider_handle_t upstream_provider;
+    umf_result_t umf_result;
+
+    umf_result = umfMemoryProviderCreate(&PURGE_COUNTER_PROVIDER_OPS, NULL,
+                                         &upstream_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(upstream_provider, nullptr);
+
+    provider_purge_counter::num_purge_lazy = 0;
+    provider_purge_counter::num_purge_force = 0;
+
+    coarse_memory_provider_params_t coarse_memory_provider_params;
+    // make sure there are no undefined members - prevent a UB
+    memset(&coarse_memory_provider_params, 0,
+           sizeof(coarse_memory_provider_params));
+    coarse_memory_provider_params.allocation_strategy = allocation_strategy;
+    coarse_memory_provider_params.upstream_memory_provider = upstream_provider;
+    coarse_memory_provider_params.purge_min_size = 1 * MB;
+    coarse_memory_provider_params.purge_lazy_delay_ms = 20;
+    coarse_memory_provider_params.purge_force_delay_ms = 200;
+
+    manual_purge_clock clock;
+    umf_memory_provider_handle_t coarse_memory_provider;
+    umf_result = umfMemoryProviderCreate(umfCoarseMemoryProviderOps(),
+                                         &coarse_memory_provider_params,
+                                         &coarse_memory_provider);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    ASSERT_NE(coarse_memory_provider, nullptr);
+
+    umf_memory_provider_handle_t cp = coarse_memory_provider;
+    const size_t large_size = 2 * MB;
+
+    // every free() checks if there are blocks to purge
+    auto free_small_block = [&]() {
+        void *ptr = nullptr;
+        ASSERT_EQ(umfMemoryProviderAlloc(cp, 4 * KB, 0, &ptr),
+                  UMF_RESULT_SUCCESS);
+        ASSERT_EQ(umfMemoryProviderFree(cp, ptr, 4 * KB), UMF_RESULT_SUCCESS);
+    };
+
+    // reuse the large free block and check that it is not purged
+    // while it is used, although its delays have passed
+    auto reuse_large_block = [&](void *expected_ptr) {
+        void *large = nullptr;
+        ASSERT_EQ(umfMemoryProviderAlloc(cp, large_size, 0, &large),
+                  UMF_RESULT_SUCCESS);
+        ASSERT_EQ(large, expected_ptr);
+        memset(large, 0xab, large_size);
+
+        size_t num_purge_lazy = provider_purge_counter::num_purge_lazy;
+        size_t num_purge_force = provider_purge_counter::num_purge_force;
+
+        clock.advance(250);
+        free_small_block();
+        ASSERT_EQ(provider_purge_counter::num_purge_lazy, num_purge_lazy);
+        ASSERT_EQ(provider_purge_counter::num_purge_force, num_purge_force);
+
+        for (size_t i = 0; i < large_size; i++) {
+            ASSERT_EQ(((unsigned char *)large)[i], 0xab);
+        }
+
+        ASSERT_EQ(umfMemoryProviderFree(cp, large, large_size),
+                  UMF_RESULT_SUCCESS);
+    };
+
+    void *large = nullptr;
+    umf_result = umfMemoryProviderAlloc(cp, large_size, 0, &large);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+
+    // reuse the block while it waits in the queue of not purged blocks
+    umf_result = umfMemoryProviderFree(cp, large, large_size);
+    ASSERT_EQ(umf_result, UMF_RESULT_SUCCESS);
+    reuse_large_block(large);
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 0);
+
+    // reuse the block while it waits in the queue of lazily purged blocks
+    clock.advance(60);
+    free_small_block();
+    ASSERT_EQ(provider_purge_counter::num_purge_lazy, 1);
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 0);
+    reuse_large_block(large);
+
+    // the block freed again is purged as usual
+    clock.advance(250);
+    free_small_block();
+    ASSERT_EQ(provider_purge_counter::num_purge_force, 1);
+
+    umfMemoryProviderDestroy(coarse_memory_provider);
+    umfMemoryProviderDestroy(upstream_provider);
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2024 Intel Corporation
+ *
+ * Under the Apache License v2.0 with LLVM Exceptions. See LICENSE.TXT.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+*/
+
+#include <atomic>
+#include <cerrno>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "critnib/critnib.h"
+
+#include "base.hpp"
+
+// the value stored for the given key
+static void *key_value(uintptr_t key) { return (void *)(key ^ 0xABCD); }
+
+typedef critnib *(*critnib_new_t)(void);
+
+struct CritnibTest : umf_test::test,
+                     ::testing::WithParamInterface<critnib_new_t> {
+    void SetUp() override {
+        test::SetUp();
+        critnib_new_f = this->GetParam();
+    }
+
+    critnib_new_t critnib_new_f;
+};
+
+INSTANTIATE_TEST_SUITE_P(CritnibTest, CritnibTest,
+                         ::testing::Values(critnib_new, critnib_new_wide));
+
+TEST_P(CritnibTest, critnibBasic) {
+    critnib *c = critnib_new_f();
+    ASSERT_NE(c, nullptr);
+
+    for (uintptr_t key = 16; key <= 1024; key += 16) {
+        ASSERT_EQ(critnib_insert(c, key, key_value(key), 0), 0);
+    }
+    ASSERT_EQ(critnib_insert(c, 16, key_value(16), 0), EEXIST);
+
+    uintptr_t rkey;
+    void *rvalue;
+    ASSERT_EQ(critnib_find(c, 100, FIND_LE, &rkey, &rvalue), 1);
+    ASSERT_EQ(rkey, 96U);
+    ASSERT_EQ(rvalue, key_value(96));
+    ASSERT_EQ(critnib_find(c, 8, FIND_LE, &rkey, &rvalue), 0);
+
+    for (uintptr_t key = 16; key <= 1024; key += 32) {
+        ASSERT_EQ(critnib_remove(c, key), key_value(key));
+    }
+    ASSERT_EQ(critnib_get(c, 16), nullptr);
+    ASSERT_EQ(critnib_get(c, 32), key_value(32));
+    ASSERT_EQ(critnib_find_le(c, 31), nullptr);
+    ASSERT_EQ(critnib_find_le(c, 63), key_value(32));
+
+    // keys differing only in the lowest bits
+    for (uintptr_t key = 1; key <= 3; key++) {
+        ASSERT_EQ(critnib_insert(c, key, key_value(key), 0), 0);
+    }
+    ASSERT_EQ(critnib_find_le(c, 2), key_value(2));
+    ASSERT_EQ(critnib_find(c, 1, FIND_G, &rkey, &rvalue), 1);
+    ASSERT_EQ(rkey, 2U);
+    ASSERT_EQ(critnib_find(c, 3, FIND_G, &rkey, &rvalue), 1);
+    ASSERT_EQ(rkey, 32U);
+    ASSERT_EQ(critnib_remove(c, 2), key_value(2));
+    ASSERT_EQ(critnib_find_le(c, 2), key_value(1));
+
+    // only completed removes and updates of values change the count
+    uint64_t change_count = critnib_change_count(c);
+    ASSERT_EQ(critnib_insert(c, 4, key_value(4), 0), 0);
+    ASSERT_EQ(critnib_remove(c, 2), nullptr);
+    ASSERT_EQ(critnib_change_count(c), change_count);
+    ASSERT_EQ(critnib_insert(c, 4, key_value(5), 1), 0);
+    ASSERT_EQ(critnib_get(c, 4), key_value(5));
+    ASSERT_EQ(critnib_change_count(c), change_count + 1);
+    ASSERT_EQ(critnib_remove(c, 4), key_value(5));
+    ASSERT_EQ(critnib_change_count(c), change_count + 2);
+
+    critnib_delete(c);
+}
+
+// Readers look up keys while writers keep inserting and removing other keys.
+// The nodes of the removed keys are freed while the readers are running,
+// so any read walking through freed memory would be caught by sanitizers
+// (or return a wrong result).
+TEST_P(CritnibTest, critnibConcurrentFindRemove) {
+    static constexpr int NREADERS = 4;
+    static constexpr int NWRITERS = 4;
+    static constexpr int ITERATIONS = 20000;
+    // keys: i * STEP are always present, the ones in between are transient
+    static constexpr uintptr_t STEP = 1024;
+    static constexpr uintptr_t NKEYS = 256;
+
+    critnib *c = critnib_new_f();
+    ASSERT_NE(c, nullptr);
+
+    for (uintptr_t i = 1; i <= NKEYS; i++) {
+        ASSERT_EQ(critnib_insert(c, i * STEP, key_value(i * STEP), 0), 0);
+    }
+
+    std::atomic<int> writers_done{0};
+    std::atomic<int> errors{0};
+
+    auto writer = [&](int id) {
+        std::mt19937 mt(id);
+        std::vector<uintptr_t> keys;
+        for (int i = 0; i < ITERATIONS; i++) {
+            // each writer owns different transient keys
+            uintptr_t key = (mt() % NKEYS + 1) * STEP + (id + 1) * 16 +
+                            (mt() % 4) * NWRITERS * 16;
+            if (critnib_insert(c, key, key_value(key), 0) == 0) {
+                keys.push_back(key);
+            }
+            if (keys.size() > 64 || (i % 2 && !keys.empty())) {
+                size_t n = mt() % keys.size();
+                if (critnib_remove(c, keys[n]) != key_value(keys[n])) {
+                    errors++;
+                }
+                keys[n] = keys.back();
+                keys.pop_back();
+            }
+        }
+        for (uintptr_t key : keys) {
+            critnib_remove(c, key);
+        }
+        writers_done++;
+    };
+
+    auto reader = [&](int id) {
+        std::mt19937 mt(id + NWRITERS);
+        while (writers_done.load() < NWRITERS) {
+            uintptr_t x = STEP + mt() % (NKEYS * STEP);
+            uintptr_t rkey;
+            void *rvalue;
+            // the result can't be below the closest permanent key
+            if (critnib_find(c, x, FIND_LE, &rkey, &rvalue) != 1 ||
+                rkey > x || rkey < x / STEP * STEP ||
+                rvalue != key_value(rkey)) {
+                errors++;
+            }
+
+            uintptr_t key = x / STEP * STEP;
+            if (critnib_get(c, key) != key_value(key)) {
+                errors++;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NWRITERS; i++) {
+        threads.emplace_back(writer, i);
+    }
+    for (int i = 0; i < NREADERS; i++) {
+        threads.emplace_back(reader, i);
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(errors.load(), 0);
+
+    for (uintptr_t i = 1; i <= NKEYS; i++) {
+        ASSERT_EQ(critnib_remove(c, i * STEP), key_value(i * STEP));
+    }
+
+    critnib_delete(c);
+}